@@ -11,28 +11,67 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <optional>
 #include <set>
 #include <tuple>
 #include <vector>
 
+#include "algorithm_integer_operations.h"
 #include "algorithm_map_operations.h"
 #include "algorithm_row_operations.h"
 
 using namespace panda;
 
+namespace
+{
+   /// Returns the class of the row computed with the compiled generators or std::nullopt if
+   /// they cannot handle the row (non-permutation maps, row not normalized).
+   template <typename Integer, typename TagType>
+   std::optional<std::set<Row<Integer>>> compiledClass(const Row<Integer>&, const MapGroup&, TagType);
+   /// Returns true if the gcd of the entries of the row is at most 1.
+   template <typename Integer>
+   bool isPrimitive(const Row<Integer>&);
+   /// Returns the representative computed by the stabilizer chain of the group or std::nullopt
+   /// if the group cannot handle the row (non-permutation maps, row not normalized).
+   template <typename Integer>
+   std::optional<Row<Integer>> canonicalRepresentative(const Row<Integer>&, const MapGroup&);
+}
+
 template <typename Integer, typename TagType>
 Row<Integer> panda::algorithm::classRepresentative(const Row<Integer>& row, const Maps& maps, TagType tag)
+{
+   return classRepresentative(row, MapGroup(maps), tag);
+}
+
+template <typename Integer, typename TagType>
+Row<Integer> panda::algorithm::classRepresentative(const Row<Integer>& row, const MapGroup& map_group, TagType tag)
 {
    assert( !row.empty() );
-   const auto matrix = getClass(row, maps, tag);
+   auto representative = canonicalRepresentative(row, map_group);
+   if ( representative )
+   {
+      return *representative;
+   }
+   const auto matrix = getClass(row, map_group, tag);
    assert( !matrix.empty() );
    return *matrix.crbegin(); // Important detail: last element is chosen as the representative
 }
 
 template <typename Integer, typename TagType>
 std::set<Row<Integer>> panda::algorithm::getClass(const Row<Integer>& row, const Maps& maps, TagType tag)
+{
+   return getClass(row, MapGroup(maps), tag);
+}
+
+template <typename Integer, typename TagType>
+std::set<Row<Integer>> panda::algorithm::getClass(const Row<Integer>& row, const MapGroup& map_group, TagType tag)
 {
    assert( !row.empty() );
+   auto compiled_class = compiledClass(row, map_group, tag);
+   if ( compiled_class )
+   {
+      return std::move(*compiled_class);
+   }
    std::set<Row<Integer>> rows;
    rows.insert(row);
    using Iterator = typename std::set<Row<Integer>>::iterator;
@@ -42,7 +81,7 @@ std::set<Row<Integer>> panda::algorithm::getClass(const Row<Integer>& row, const
    {
       const auto& current_row = *iterators.back();
       iterators.pop_back();
-      for ( const auto& map : maps )
+      for ( const auto& map : map_group.maps() )
       {
          const auto new_row = apply(map, current_row, tag);
          Iterator iterator;
@@ -66,11 +105,32 @@ Matrix<Integer> panda::algorithm::classes(Matrix<Integer> input, const Maps& map
 
 template <typename Integer, typename TagType>
 Matrix<Integer> panda::algorithm::classes(std::set<Row<Integer>> rows, const Maps& maps, TagType tag)
+{
+   return classes(std::move(rows), MapGroup(maps), tag);
+}
+
+template <typename Integer, typename TagType>
+Matrix<Integer> panda::algorithm::classes(std::set<Row<Integer>> rows, const MapGroup& map_group, TagType tag)
 {
    Matrix<Integer> classes;
+   if ( map_group.group() )
+   {
+      // the first row of a class in ascending order is its smallest member, hence the
+      // representatives are found in the same order as by removing complete classes.
+      std::set<Row<Integer>> representatives;
+      for ( const auto& row : rows )
+      {
+         auto representative = classRepresentative(row, map_group, tag);
+         if ( representatives.insert(representative).second )
+         {
+            classes.push_back(std::move(representative));
+         }
+      }
+      return classes;
+   }
    while ( !rows.empty() )
    {
-      const auto row_class = getClass(*rows.begin(), maps, tag);
+      const auto row_class = getClass(*rows.begin(), map_group, tag);
       assert( !row_class.empty() );
       classes.push_back(*row_class.crbegin()); // Important detail: last element is chosen as the representative
       for ( const auto& row : row_class )
@@ -85,3 +145,75 @@ Matrix<Integer> panda::algorithm::classes(std::set<Row<Integer>> rows, const Map
    return classes;
 }
 
+namespace
+{
+   template <typename Integer>
+   std::optional<Row<Integer>> canonicalRepresentative(const Row<Integer>& row, const MapGroup& map_group)
+   {
+      const auto group = map_group.group();
+      if ( !group || group->dimension() != row.size() )
+      {
+         return std::nullopt;
+      }
+      // the orbit of a row with a common divisor contains the row itself and normalized images.
+      if ( !isPrimitive(row) )
+      {
+         return std::nullopt;
+      }
+      return group->canonicalImage(row);
+   }
+
+   template <typename Integer, typename TagType>
+   std::optional<std::set<Row<Integer>>> compiledClass(const Row<Integer>& row, const MapGroup& map_group, TagType tag)
+   {
+      const auto generators = map_group.generators(tag);
+      if ( !generators || generators->empty() || generators->front().size() != row.size() || !isPrimitive(row) )
+      {
+         return std::nullopt;
+      }
+      // same search as in getClass, but the images are gathered into one buffer, which is
+      // only copied into the class if it is a new row.
+      std::set<Row<Integer>> rows;
+      rows.insert(row);
+      using Iterator = typename std::set<Row<Integer>>::iterator;
+      std::vector<Iterator> iterators;
+      iterators.push_back(rows.begin());
+      Row<Integer> image(row.size());
+      while ( !iterators.empty() )
+      {
+         const auto& current_row = *iterators.back();
+         iterators.pop_back();
+         for ( const auto& generator : *generators )
+         {
+            if ( !generator.apply(current_row, image) )
+            {
+               return std::nullopt;
+            }
+            Iterator iterator;
+            bool inserted;
+            std::tie(iterator, inserted) = rows.insert(image);
+            if ( inserted )
+            {
+               iterators.push_back(iterator);
+            }
+         }
+      }
+      return rows;
+   }
+
+   template <typename Integer>
+   bool isPrimitive(const Row<Integer>& row)
+   {
+      Integer divisor(0);
+      for ( const auto& entry : row )
+      {
+         divisor = algorithm::gcd(divisor, entry);
+         if ( divisor == 1 )
+         {
+            break;
+         }
+      }
+      return divisor <= 1;
+   }
+}
+
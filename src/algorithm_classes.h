@@ -8,6 +8,7 @@
 
 #include <set>
 
+#include "map_group.h"
 #include "maps.h"
 #include "matrix.h"
 #include "row.h"
@@ -21,10 +22,16 @@ namespace panda
       /// Precondition: if input is a facet, the facet must be normalized.
       template <typename Integer, typename TagType>
       Row<Integer> classRepresentative(const Row<Integer>&, const Maps&, TagType);
+      /// returns the unique class representative, using the group built with the maps.
+      template <typename Integer, typename TagType>
+      Row<Integer> classRepresentative(const Row<Integer>&, const MapGroup&, TagType);
       /// Creates a set of rows which is the complete class containing the input row.
       /// Precondition: if input is a facet, the facet must be normalized.
       template <typename Integer, typename TagType>
       std::set<Row<Integer>> getClass(const Row<Integer>&, const Maps&, TagType);
+      /// Creates the complete class containing the input row, using the group built with the maps.
+      template <typename Integer, typename TagType>
+      std::set<Row<Integer>> getClass(const Row<Integer>&, const MapGroup&, TagType);
       /// Reduces a list of rows to just the representatives.
       /// Precondition: if input are facets, then these facets must be normalized.
       template <typename Integer, typename TagType>
@@ -33,6 +40,9 @@ namespace panda
       /// Precondition: if input are facets, then these facets must be normalized.
       template <typename Integer, typename TagType>
       Matrix<Integer> classes(std::set<Row<Integer>>, const Maps&, TagType);
+      /// Reduces a list of rows to just the representatives, using the group built with the maps.
+      template <typename Integer, typename TagType>
+      Matrix<Integer> classes(std::set<Row<Integer>>, const MapGroup&, TagType);
    }
 }
 
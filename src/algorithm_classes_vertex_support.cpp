@@ -15,12 +15,23 @@
 #include <iostream>
 #endif
 
-#include "algorithm_inequality_operations.h"
 #include "algorithm_map_operations.h"
+#include "algorithm_row_operations.h"
+#include "row_index.h"
 #include "tags.h"
 
 using namespace panda;
 
+namespace
+{
+   /// Returns the row divided by the gcd of its entries.
+   template <typename Integer>
+   Row<Integer> normalized(Row<Integer>);
+   /// Returns the tag for applying maps to the input rows, which are of the opposite kind.
+   tag::vertex imageTag(tag::facet) noexcept;
+   tag::facet imageTag(tag::vertex) noexcept;
+}
+
 bool panda::algorithm::arePurePermutations(const Maps& maps)
 {
    #ifdef DEBUG
@@ -67,87 +78,60 @@ bool panda::algorithm::arePurePermutations(const Maps& maps)
    return true;
 }
 
-template <typename Integer>
-std::vector<std::vector<std::size_t>> panda::algorithm::computeVertexPermutations(const Maps& maps, const Matrix<Integer>& vertices)
+template <typename Integer, typename TagType>
+std::vector<std::vector<std::size_t>> panda::algorithm::computeVertexPermutations(const Maps& maps, const Matrix<Integer>& rows, TagType tag, const int thread_count)
 {
    #ifdef DEBUG
    std::cerr << "[DEBUG] computeVertexPermutations: maps.size()=" << maps.size()
-             << ", vertices.size()=" << vertices.size() << std::endl;
+             << ", rows.size()=" << rows.size() << std::endl;
    #endif
 
-   if (maps.empty() || vertices.empty())
+   if (maps.empty() || rows.empty())
    {
       #ifdef DEBUG
-      std::cerr << "[DEBUG] Empty maps or vertices, returning empty" << std::endl;
+      std::cerr << "[DEBUG] Empty maps or rows, returning empty" << std::endl;
       #endif
       return {};
    }
 
-   // Check if maps are pure permutations
-   if (!arePurePermutations(maps))
+   // The images are normalized by apply(), hence the lookup is among the normalized input rows
+   Matrix<Integer> normalized_rows;
+   normalized_rows.reserve(rows.size());
+   for (const auto& row : rows)
+   {
+      normalized_rows.push_back(normalized(row));
+   }
+   if (RowIndex<Integer>(normalized_rows).hasDuplicates())
    {
       #ifdef DEBUG
-      std::cerr << "[DEBUG] Maps are not pure permutations, returning empty" << std::endl;
+      std::cerr << "[DEBUG] Input rows contain duplicates, returning empty" << std::endl;
       #endif
       return {};
    }
 
-   std::vector<std::vector<std::size_t>> vertex_permutations;
-   vertex_permutations.reserve(maps.size());
-
-   // For each coordinate map, compute the induced vertex permutation
-   for (std::size_t map_idx = 0; map_idx < maps.size(); ++map_idx)
+   // For each coordinate map, the induced permutation of the input rows (maps in parallel)
+   auto vertex_permutations = images(maps, normalized_rows, imageTag(tag), thread_count);
+   for (std::size_t map_idx = 0; map_idx < vertex_permutations.size(); ++map_idx)
    {
-      const auto& map = maps[map_idx];
-      std::vector<std::size_t> vertex_perm(vertices.size());
-
-      #ifdef DEBUG
-      std::cerr << "[DEBUG] Processing map " << map_idx << std::endl;
-      #endif
-
-      // For each vertex, apply the map and find which vertex it maps to
-      bool valid = true;
-      for (std::size_t v_idx = 0; v_idx < vertices.size(); ++v_idx)
+      const auto& vertex_perm = vertex_permutations[map_idx];
+      std::vector<bool> hit(rows.size(), false);
+      for (std::size_t v_idx = 0; v_idx < vertex_perm.size(); ++v_idx)
       {
-         const auto& vertex = vertices[v_idx];
-
-         // Apply coordinate map to vertex using facet tag
-         // (We're transforming a point in coordinate space, which uses facet semantics)
-         const auto transformed = apply(map, vertex, tag::facet{});
-
-         // Find which vertex index this corresponds to
-         auto it = std::find(vertices.cbegin(), vertices.cend(), transformed);
-         if (it == vertices.cend())
+         if (vertex_perm[v_idx] == RowIndex<Integer>::npos || hit[vertex_perm[v_idx]])
          {
             #ifdef DEBUG
-            std::cerr << "[DEBUG] Map " << map_idx << ": vertex " << v_idx
-                      << " transforms to a point not in vertex list" << std::endl;
+            std::cerr << "[DEBUG] Map " << map_idx << ": row " << v_idx
+                      << " transforms to a row not in the input (or not bijective)" << std::endl;
             #endif
-            valid = false;
-            break;
+            return {};
          }
-
-         vertex_perm[v_idx] = static_cast<std::size_t>(it - vertices.cbegin());
-
-         #ifdef DEBUG
-         std::cerr << "[DEBUG]   vertex " << v_idx << " -> " << vertex_perm[v_idx] << std::endl;
-         #endif
-      }
-
-      if (!valid)
-      {
-         #ifdef DEBUG
-         std::cerr << "[DEBUG] Map " << map_idx << " does not induce a valid vertex permutation" << std::endl;
-         #endif
-         return {};
+         hit[vertex_perm[v_idx]] = true;
       }
-
-      vertex_permutations.push_back(vertex_perm);
    }
 
    #ifdef DEBUG
    std::cerr << "[DEBUG] Successfully computed " << vertex_permutations.size()
-             << " vertex permutations" << std::endl;
+             << " row permutations" << std::endl;
    #endif
 
    return vertex_permutations;
@@ -155,20 +139,23 @@ std::vector<std::vector<std::size_t>> panda::algorithm::computeVertexPermutation
 
 namespace
 {
-   /// Convert a facet to its vertex support: sorted vector of vertex indices
-   /// where the inequality is satisfied with equality (distance == 0).
    template <typename Integer>
-   std::vector<std::size_t> facetToVertexSupport(const Row<Integer>& facet,
-                                                  const Matrix<Integer>& vertices)
+   Row<Integer> normalized(Row<Integer> row)
    {
-      std::vector<std::size_t> support;
-      for (std::size_t i = 0; i < vertices.size(); ++i)
-      {
-         if (algorithm::distance(facet, vertices[i]) == 0)
-         {
-            support.push_back(i);
-         }
-      }
-      return support;
+      algorithm::divideByGcd(row);
+      return row;
+   }
+
+   tag::vertex imageTag(tag::facet) noexcept
+   {
+      // facets are enumerated, the input rows are points
+      return tag::vertex{};
+   }
+
+   tag::facet imageTag(tag::vertex) noexcept
+   {
+      // vertices are enumerated, the input rows are inequalities
+      return tag::facet{};
    }
 }
+
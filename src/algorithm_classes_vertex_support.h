@@ -18,15 +18,17 @@ namespace panda
       /// Check if maps are pure vertex permutations (no scaling, only index swapping)
       bool arePurePermutations(const Maps& maps);
 
-      /// Compute induced vertex permutations from coordinate maps.
-      /// For each map in Maps, applies the coordinate transformation to each vertex
-      /// and finds which vertex index the result maps to.
+      /// Compute induced permutations of the input rows from coordinate maps.
+      /// The tag names what is enumerated: for tag::facet the input rows are vertices,
+      /// for tag::vertex they are inequalities. Each map (signed permutation or affine)
+      /// is applied to every input row and the image is looked up among the input rows
+      /// (both compared in normalized form), on up to the given number of threads.
       /// Returns empty vector if:
-      /// - maps are not pure permutations
-      /// - some transformed vertex is not found in the vertex list
+      /// - some transformed row is not found in the input rows
+      /// - some map does not induce a bijection (e.g. duplicate input rows)
       /// - maps are empty
-      template <typename Integer>
-      std::vector<std::vector<std::size_t>> computeVertexPermutations(const Maps& maps, const Matrix<Integer>& vertices);
+      template <typename Integer, typename TagType>
+      std::vector<std::vector<std::size_t>> computeVertexPermutations(const Maps& maps, const Matrix<Integer>& rows, TagType, int thread_count);
    }
 }
 
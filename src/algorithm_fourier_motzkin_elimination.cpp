@@ -13,6 +13,8 @@
 #include <forward_list>
 #include <iostream>
 #include <limits>
+#include <numeric>
+#include <unordered_set>
 #include <utility>
 
 #include "algorithm_matrix_operations.h"
@@ -21,6 +23,7 @@
 #include "bitset_variable_size.h"
 #include "delayed_action.h"
 #include "range.h"
+#include "support.h"
 
 using namespace panda;
 
@@ -29,12 +32,39 @@ namespace
    using Index = std::size_t;
    using Indices = std::vector<Index>;
    using ColumnIndex = std::size_t;
+   /// Rows of the final system that belong to classes seen before are skipped.
+   /// The classes are identified by the canonical forms of the supports under the group.
+   class ClassFilter
+   {
+      public:
+         /// Constructor: the group (nullptr: every row is new) and the original index of each input row.
+         ClassFilter(const VertexGroup*, Indices);
+         /// Checks if the row whose strictly satisfied input rows are the bits is the first of its class.
+         template <typename Bitset>
+         bool isNew(const Bitset&);
+      private:
+         const VertexGroup* group;
+         Indices original_indices;
+         std::unordered_set<Support, Support::Hash> seen;
+      private:
+         /// Copy construction is not allowed.
+         ClassFilter(const ClassFilter&) = delete;
+         /// Copy assignment is not allowed.
+         ClassFilter& operator=(const ClassFilter&) = delete;
+   };
+   /// Moves an invertible subset of the input rows to the front and returns the inverse
+   /// of their matrix (the initial system) and the eliminated zero columns.
+   /// The indices are permuted along with the input rows.
+   template <typename Integer>
+   std::pair<Matrix<Integer>, std::vector<ColumnIndex>> phaseOne(Vertices<Integer>&, Indices&);
+   /// Returns the indices of the input rows, such that the rows of each orbit are consecutive.
+   Indices orbitOrder(const VertexGroup&);
    /// Chooses the correct Bitset type.
    template <typename Integer>
-   void phaseTwoDispatch(Matrix<Integer>&, const Vertices<Integer>&);
+   void phaseTwoDispatch(Matrix<Integer>&, const Vertices<Integer>&, ClassFilter&);
    /// The actual FME, named phase Two in Christof.
    template <typename Bitset, typename Integer>
-   void phaseTwo(Matrix<Integer>&, const Vertices<Integer>&);
+   void phaseTwo(Matrix<Integer>&, const Vertices<Integer>&, ClassFilter&);
    /// Abortable phase Two.
    template <typename Bitset, typename Integer>
    void phaseTwoHeuristic(Matrix<Integer>&, const Vertices<Integer>&);
@@ -52,7 +82,8 @@ namespace
       const Index,
       const std::tuple<Indices, Indices, Indices>&,
       const Row<Integer>&,
-      const std::forward_list<std::tuple<Index, Index, Bitset>>&);
+      const std::forward_list<std::tuple<Index, Index, Bitset>>&,
+      ClassFilter*);
    /// Checks minimality of the new system.
    template <typename Bitset>
    bool isMinimal(const Bitset&, const std::forward_list<std::tuple<Index, Index, Bitset>>&, const std::size_t);
@@ -65,37 +96,46 @@ namespace
    /// Initialization of bitsets in phase 2.
    template <typename Bitset, typename Integer>
    std::vector<Bitset> initializeR(const Matrix<Integer>&, const Vertices<Integer>&);
-   /// Elimination of one ray.
+   /// Elimination of one ray, the filter (if any) selects the rows of the new system.
    template <typename Bitset, typename Integer>
-   void projection(Matrix<Integer>&, std::vector<Bitset>&, const Vertex<Integer>&, const Index);
+   void projection(Matrix<Integer>&, std::vector<Bitset>&, const Vertex<Integer>&, const Index, ClassFilter* = nullptr);
+   /// Keeps the first row of each class of a final system.
+   template <typename Bitset, typename Integer>
+   void filterClasses(Matrix<Integer>&, std::vector<Bitset>&, ClassFilter&);
 }
 
 template <typename Integer>
 Matrix<Integer> panda::algorithm::fourierMotzkinElimination(Matrix<Integer> input)
 {
    assert( !input.empty() );
-   auto matrix = input;
-   appendNegativeIdentityMatrix(matrix);
-   Indices used_indices;
-   Indices equation_indices;
-   std::tie(equation_indices, used_indices) = gaussianElimination(matrix);
-   matrix.erase(matrix.begin(), matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(input.size()));
-   assert( !matrix.empty() );
-   assert( matrix.size() == matrix.back().size() );
-   matrix = transpose(matrix);
-   std::sort(equation_indices.rbegin(), equation_indices.rend());
-   const auto equations = extractEquations(matrix, equation_indices);
-   const auto zero_columns = eliminateZeroColumns(matrix, input);
-   assert( std::is_sorted(used_indices.cbegin(), used_indices.cend()) );
-   Vertices<Integer> used;
-   used.reserve(used_indices.size());
-   for ( auto it = used_indices.crbegin(); it != used_indices.crend(); ++it )
+   Indices order(input.size());
+   std::iota(order.begin(), order.end(), Index{0});
+   Matrix<Integer> matrix;
+   std::vector<ColumnIndex> zero_columns;
+   std::tie(matrix, zero_columns) = phaseOne(input, order);
+   ClassFilter filter(nullptr, std::move(order));
+   phaseTwoDispatch(matrix, input, filter);
+   reinsertZeroColumns(matrix, zero_columns);
+   return matrix;
+}
+
+template <typename Integer>
+Matrix<Integer> panda::algorithm::fourierMotzkinElimination(Matrix<Integer> input, const VertexGroup& group)
+{
+   assert( !input.empty() );
+   assert( group.size() == input.size() );
+   auto order = orbitOrder(group);
+   Matrix<Integer> ordered;
+   ordered.reserve(input.size());
+   for ( const auto index : order )
    {
-      used.push_back(input[*it]);
-      input.erase(input.begin() + static_cast<typename Matrix<Integer>::difference_type>(*it));
+      ordered.push_back(std::move(input[index]));
    }
-   input.insert(input.begin(), used.cbegin(), used.cend());
-   phaseTwoDispatch(matrix, input);
+   Matrix<Integer> matrix;
+   std::vector<ColumnIndex> zero_columns;
+   std::tie(matrix, zero_columns) = phaseOne(ordered, order);
+   ClassFilter filter(&group, std::move(order));
+   phaseTwoDispatch(matrix, ordered, filter);
    reinsertZeroColumns(matrix, zero_columns);
    return matrix;
 }
@@ -104,27 +144,11 @@ template <typename Integer>
 Matrix<Integer> panda::algorithm::fourierMotzkinEliminationHeuristic(Matrix<Integer> input)
 {
    assert( !input.empty() );
-   auto matrix = input;
-   appendNegativeIdentityMatrix(matrix);
-   Indices used_indices;
-   Indices equation_indices;
-   std::tie(equation_indices, used_indices) = gaussianElimination(matrix);
-   matrix.erase(matrix.begin(), matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(input.size()));
-   assert( !matrix.empty() );
-   assert( matrix.size() == matrix.back().size() );
-   matrix = transpose(matrix);
-   std::sort(equation_indices.rbegin(), equation_indices.rend());
-   const auto equations = extractEquations(matrix, equation_indices);
-   const auto zero_columns = eliminateZeroColumns(matrix, input);
-   assert( std::is_sorted(used_indices.cbegin(), used_indices.cend()) );
-   Vertices<Integer> used;
-   used.reserve(used_indices.size());
-   for ( auto it = used_indices.crbegin(); it != used_indices.crend(); ++it )
-   {
-      used.push_back(input[*it]);
-      input.erase(input.begin() + static_cast<typename Matrix<Integer>::difference_type>(*it));
-   }
-   input.insert(input.begin(), used.cbegin(), used.cend());
+   Indices order(input.size());
+   std::iota(order.begin(), order.end(), Index{0});
+   Matrix<Integer> matrix;
+   std::vector<ColumnIndex> zero_columns;
+   std::tie(matrix, zero_columns) = phaseOne(input, order);
    phaseTwoHeuristic<BitsetVariableSize>(matrix, input);
    reinsertZeroColumns(matrix, zero_columns);
    return matrix;
@@ -144,82 +168,82 @@ namespace
 
    /// This method automatically chooses the optimal bitset type and executes the phase 2.
    template <typename Integer>
-   void phaseTwoDispatch(Matrix<Integer>& matrix, const Vertices<Integer>& vertices)
+   void phaseTwoDispatch(Matrix<Integer>& matrix, const Vertices<Integer>& vertices, ClassFilter& filter)
    {
       assert( !vertices.empty() );
       static_assert(std::is_same<BitsetFixedSize<1u>::DataType, BitsetVariableSize::DataType>::value, "The datatypes of BitsetFixedSize and BitsetVariableSize do not match. This is crucial for the optimal choice of type.");
       const auto bitset_size = 1 + (vertices.size() - 1) / std::numeric_limits<typename BitsetFixedSize<1u>::DataType>::digits;
       if ( bitset_size <= 1u )
       {
-         phaseTwo<BitsetFixedSize<1u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<1u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 2u )
       {
-         phaseTwo<BitsetFixedSize<2u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<2u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 3u )
       {
-         phaseTwo<BitsetFixedSize<3u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<3u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 4u )
       {
-         phaseTwo<BitsetFixedSize<4u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<4u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 6u )
       {
-         phaseTwo<BitsetFixedSize<6u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<6u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 8u )
       {
-         phaseTwo<BitsetFixedSize<8u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<8u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 10u )
       {
-         phaseTwo<BitsetFixedSize<10u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<10u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 12u )
       {
-         phaseTwo<BitsetFixedSize<12u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<12u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 16u )
       {
-         phaseTwo<BitsetFixedSize<16u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<16u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 20u )
       {
-         phaseTwo<BitsetFixedSize<20u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<20u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 30u )
       {
-         phaseTwo<BitsetFixedSize<30u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<30u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 40u )
       {
-         phaseTwo<BitsetFixedSize<40u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<40u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 50u )
       {
-         phaseTwo<BitsetFixedSize<50u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<50u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 75u )
       {
-         phaseTwo<BitsetFixedSize<75u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<75u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 100u )
       {
-         phaseTwo<BitsetFixedSize<100u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<100u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 150u )
       {
-         phaseTwo<BitsetFixedSize<150u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<150u>>(matrix, vertices, filter);
       }
       else if ( bitset_size <= 200u )
       {
-         phaseTwo<BitsetFixedSize<200u>>(matrix, vertices);
+         phaseTwo<BitsetFixedSize<200u>>(matrix, vertices, filter);
       }
       else
       {
-         phaseTwo<BitsetVariableSize>(matrix, vertices);
+         phaseTwo<BitsetVariableSize>(matrix, vertices, filter);
       }
    }
 
@@ -282,7 +306,7 @@ namespace
    }
 
    template <typename Bitset, typename Integer>
-   void projection(Matrix<Integer>& matrix, std::vector<Bitset>& R, const Vertex<Integer>& vertex, const Index index)
+   void projection(Matrix<Integer>& matrix, std::vector<Bitset>& R, const Vertex<Integer>& vertex, const Index index, ClassFilter* filter)
    {
       assert( !matrix.empty() );
       const auto d = vertex.size();
@@ -311,7 +335,7 @@ namespace
             }
          }
       }
-      std::tie(matrix, R) = updateSystem(matrix, R, index, indices, s, pnrs);
+      std::tie(matrix, R) = updateSystem(matrix, R, index, indices, s, pnrs, filter);
    }
 
    template <typename Integer>
@@ -333,7 +357,7 @@ namespace
    }
 
    template <typename Bitset, typename Integer>
-   void phaseTwo(Matrix<Integer>& matrix, const Vertices<Integer>& vertices)
+   void phaseTwo(Matrix<Integer>& matrix, const Vertices<Integer>& vertices, ClassFilter& filter)
    {
       assert( !matrix.empty() );
       const auto d = matrix.back().size();
@@ -346,7 +370,12 @@ namespace
          {
             std::cerr << "Fourier-Motzkin Elimination step " << i + 1 << " / " << vertices.size() << ": " << matrix.size() << '\n';
          }, std::chrono::seconds(2));
-         projection(matrix, R, vertex, i);
+         // the rows of the last system are final, only one row per class is created.
+         projection(matrix, R, vertex, i, ( i + 1 == vertices.size() ) ? &filter : nullptr);
+      }
+      if ( d == vertices.size() ) // nothing to eliminate, the initial system is final.
+      {
+         filterClasses(matrix, R, filter);
       }
       detectBadRow(matrix);
    }
@@ -411,7 +440,8 @@ namespace
       const Index i,
       const std::tuple<Indices, Indices, Indices>& indices,
       const Row<Integer>& s,
-      const std::forward_list<std::tuple<Index, Index, Bitset>>& pnrs)
+      const std::forward_list<std::tuple<Index, Index, Bitset>>& pnrs,
+      ClassFilter* filter)
    {
       const auto& indices_negative = std::get<0>(indices);
       const auto& indices_zero = std::get<1>(indices);
@@ -421,25 +451,34 @@ namespace
       new_R.reserve(indices_negative.size() + indices_zero.size());
       for ( const auto index_z : indices_zero )
       {
+         if ( filter != nullptr && !filter->isNew(R[index_z]) )
+         {
+            continue;
+         }
          new_matrix.push_back(matrix[index_z]);
          new_R.push_back(R[index_z]);
       }
       for ( const auto index_n : indices_negative )
       {
+         auto bits = R[index_n];
+         bits.set(i);
+         if ( filter != nullptr && !filter->isNew(bits) )
+         {
+            continue;
+         }
          new_matrix.push_back(matrix[index_n]);
-         new_R.push_back(R[index_n]);
-         new_R.back().set(i);
+         new_R.push_back(std::move(bits));
       }
       for ( const auto& pnr : pnrs )
       {
+         if ( filter != nullptr && !filter->isNew(std::get<2>(pnr)) )
+         {
+            continue;
+         }
          const auto& index_n = std::get<0>(pnr);
          const auto& index_p = std::get<1>(pnr);
          new_matrix.push_back(s[index_p] * matrix[index_n] - s[index_n] * matrix[index_p]);
-         const auto gcd_value = algorithm::gcd(new_matrix.back());
-         if ( gcd_value > 1 )
-         {
-            new_matrix.back() /= gcd_value;
-         }
+         algorithm::divideByGcd(new_matrix.back());
          new_R.push_back(std::get<2>(pnr));
       }
       return std::make_pair(new_matrix, new_R);
@@ -459,6 +498,96 @@ namespace
       return true;
    }
 
+   ClassFilter::ClassFilter(const VertexGroup* vertex_group, Indices indices)
+   :
+      group(vertex_group),
+      original_indices(std::move(indices)),
+      seen()
+   {
+   }
+
+   template <typename Bitset>
+   bool ClassFilter::isNew(const Bitset& strictly_satisfied)
+   {
+      if ( group == nullptr )
+      {
+         return true;
+      }
+      // the support consists of the input rows that are satisfied with equality.
+      Support support(original_indices.size());
+      for ( std::size_t j = 0; j < original_indices.size(); ++j )
+      {
+         if ( !strictly_satisfied.test(j) )
+         {
+            support.set(original_indices[j]);
+         }
+      }
+      return seen.insert(group->canonicalSupport(support)).second;
+   }
+
+   template <typename Integer>
+   std::pair<Matrix<Integer>, std::vector<ColumnIndex>> phaseOne(Vertices<Integer>& input, Indices& order)
+   {
+      assert( input.size() == order.size() );
+      auto matrix = input;
+      algorithm::appendNegativeIdentityMatrix(matrix);
+      Indices used_indices;
+      Indices equation_indices;
+      std::tie(equation_indices, used_indices) = algorithm::gaussianElimination(matrix);
+      matrix.erase(matrix.begin(), matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(input.size()));
+      assert( !matrix.empty() );
+      assert( matrix.size() == matrix.back().size() );
+      matrix = algorithm::transpose(matrix);
+      std::sort(equation_indices.rbegin(), equation_indices.rend());
+      const auto equations = algorithm::extractEquations(matrix, equation_indices);
+      auto zero_columns = eliminateZeroColumns(matrix, input);
+      assert( std::is_sorted(used_indices.cbegin(), used_indices.cend()) );
+      Vertices<Integer> used;
+      used.reserve(used_indices.size());
+      Indices used_order;
+      used_order.reserve(used_indices.size());
+      for ( auto it = used_indices.crbegin(); it != used_indices.crend(); ++it )
+      {
+         used.push_back(input[*it]);
+         input.erase(input.begin() + static_cast<typename Matrix<Integer>::difference_type>(*it));
+         used_order.push_back(order[*it]);
+         order.erase(order.begin() + static_cast<Indices::difference_type>(*it));
+      }
+      input.insert(input.begin(), used.cbegin(), used.cend());
+      order.insert(order.begin(), used_order.cbegin(), used_order.cend());
+      return std::make_pair(std::move(matrix), std::move(zero_columns));
+   }
+
+   Indices orbitOrder(const VertexGroup& group)
+   {
+      const auto n = group.size();
+      Indices parents(n);
+      std::iota(parents.begin(), parents.end(), Index{0});
+      const auto find = [&parents](Index index)
+      {
+         while ( parents[index] != index )
+         {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+         }
+         return index;
+      };
+      for ( const auto& generator : group.generators() )
+      {
+         for ( std::size_t j = 0; j < n; ++j )
+         {
+            const auto a = find(j);
+            const auto b = find(generator[j]);
+            parents[std::max(a, b)] = std::min(a, b);
+         }
+      }
+      // the orbits are ordered by their smallest row, the rows of an orbit by their index.
+      Indices order(n);
+      std::iota(order.begin(), order.end(), Index{0});
+      std::stable_sort(order.begin(), order.end(), [&find](const Index a, const Index b) { return find(a) < find(b); });
+      return order;
+   }
+
    template <typename Integer>
    std::vector<ColumnIndex> eliminateZeroColumns(Matrix<Integer>& matrix, Vertices<Integer>& vertices)
    {
@@ -524,5 +653,23 @@ namespace
       }
       return R;
    }
+
+   template <typename Bitset, typename Integer>
+   void filterClasses(Matrix<Integer>& matrix, std::vector<Bitset>& R, ClassFilter& filter)
+   {
+      assert( matrix.size() == R.size() );
+      Matrix<Integer> new_matrix;
+      std::vector<Bitset> new_R;
+      for ( std::size_t j = 0; j < matrix.size(); ++j )
+      {
+         if ( filter.isNew(R[j]) )
+         {
+            new_matrix.push_back(std::move(matrix[j]));
+            new_R.push_back(std::move(R[j]));
+         }
+      }
+      matrix = std::move(new_matrix);
+      R = std::move(new_R);
+   }
 }
 
@@ -12,6 +12,7 @@
 
 #include "matrix.h"
 #include "row.h"
+#include "vertex_group.h"
 
 namespace panda
 {
@@ -22,6 +23,14 @@ namespace panda
       /// extremal vertices/rays is returned.
       template <typename Integer>
       Matrix<Integer> fourierMotzkinElimination(Matrix<Integer>);
+      /// Fourier-Motzkin elimination for input rows that are permuted by the group.
+      /// The rows are processed in orbit order and in the last step, only the first row
+      /// of each class (identified by the canonical form of its support) is created.
+      /// Hence, the result contains one (arbitrary) member of each class of the output.
+      /// The intermediate systems are complete, as the adjacency test and the combinations
+      /// of a step need all rows of the previous system: only the last one is reduced.
+      template <typename Integer>
+      Matrix<Integer> fourierMotzkinElimination(Matrix<Integer>, const VertexGroup&);
       /// Heuristic using Fourier-Motzkin elimination to identify some facets.
       /// Output is guaranteed to contain only facets, but it is highly likely
       /// that it is not the complete set of facets.
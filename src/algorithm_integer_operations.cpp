@@ -11,12 +11,21 @@
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
+#include <type_traits>
+
+#include "binary_gcd.h"
 
 using namespace panda;
 
 namespace
 {
-   /// optimized gcd for unsigned integer values.
+   /// gcd for native integer types, computed on the magnitudes with the binary algorithm.
+   template <typename Integer>
+   Integer signed_gcd(Integer, Integer, std::true_type) noexcept;
+   /// gcd for all other integer types (BigInteger, SafeInteger).
+   template <typename Integer>
+   Integer signed_gcd(Integer, Integer, std::false_type) noexcept;
+   /// Euclid's algorithm for non-negative values.
    template <typename Integer>
    Integer unsigned_gcd(Integer, Integer) noexcept;
 }
@@ -24,8 +33,7 @@ namespace
 template <typename Integer>
 Integer panda::algorithm::gcd(Integer a, Integer b) noexcept
 {
-   using std::abs;
-   return unsigned_gcd(static_cast<Integer>(abs(a)), static_cast<Integer>(abs(b)));
+   return signed_gcd(a, b, std::is_integral<Integer>{});
 }
 
 template <typename Integer>
@@ -43,6 +51,23 @@ short panda::algorithm::abs(const short n)
 
 namespace
 {
+   template <typename Integer>
+   Integer signed_gcd(const Integer a, const Integer b, std::true_type) noexcept
+   {
+      using Unsigned = typename std::make_unsigned<Integer>::type;
+      // magnitudes are taken in the unsigned type, so the most negative value does not overflow.
+      const auto magnitude_a = (a < 0) ? static_cast<Unsigned>(Unsigned(0) - static_cast<Unsigned>(a)) : static_cast<Unsigned>(a);
+      const auto magnitude_b = (b < 0) ? static_cast<Unsigned>(Unsigned(0) - static_cast<Unsigned>(b)) : static_cast<Unsigned>(b);
+      return static_cast<Integer>(binaryGcd(magnitude_a, magnitude_b));
+   }
+
+   template <typename Integer>
+   Integer signed_gcd(const Integer a, const Integer b, std::false_type) noexcept
+   {
+      using std::abs;
+      return unsigned_gcd(static_cast<Integer>(abs(a)), static_cast<Integer>(abs(b)));
+   }
+
    template <typename Integer>
    Integer unsigned_gcd(Integer a, Integer b) noexcept
    {
@@ -0,0 +1,217 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_ALGORITHM_LINEAR_AUTOMORPHISMS
+#include "algorithm_linear_automorphisms.h"
+#undef COMPILE_TEMPLATE_ALGORITHM_LINEAR_AUTOMORPHISMS
+
+#include <cassert>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include <gmpxx.h>
+
+#include "colored_graph.h"
+
+using namespace panda;
+
+namespace
+{
+   using RationalMatrix = std::vector<std::vector<mpq_class>>;
+   using ExactMatrix = std::vector<std::vector<mpz_class>>;
+
+   /// Converts the rows to arbitrary precision integers.
+   template <typename Integer>
+   ExactMatrix exact(const Matrix<Integer>&);
+   /// Returns the indices of a maximal set of linearly independent columns of a symmetric matrix.
+   std::vector<std::size_t> independentColumns(RationalMatrix);
+   /// Returns the inverse of a regular matrix.
+   RationalMatrix inverse(RationalMatrix);
+}
+
+template <typename Integer>
+std::vector<std::vector<std::size_t>> panda::algorithm::linearAutomorphisms(const Matrix<Integer>& rows)
+{
+   if ( rows.size() < 2 )
+   {
+      return {};
+   }
+   const auto matrix = exact(rows);
+   const auto n = matrix.size();
+   const auto d = matrix.front().size();
+   RationalMatrix gram(d, std::vector<mpq_class>(d));
+   for ( std::size_t a = 0; a < d; ++a )
+   {
+      for ( std::size_t b = a; b < d; ++b )
+      {
+         mpz_class sum(0);
+         for ( const auto& row : matrix )
+         {
+            sum += row[a] * row[b];
+         }
+         gram[a][b] = sum;
+         gram[b][a] = sum;
+      }
+   }
+   // the rows restricted to a basis of the columns have the same linear dependencies.
+   const auto basis = independentColumns(gram);
+   const auto r = basis.size();
+   if ( r == 0 )
+   {
+      return {};
+   }
+   RationalMatrix restricted(r, std::vector<mpq_class>(r));
+   for ( std::size_t a = 0; a < r; ++a )
+   {
+      for ( std::size_t b = 0; b < r; ++b )
+      {
+         restricted[a][b] = gram[basis[a]][basis[b]];
+      }
+   }
+   const auto rational_inverse = inverse(std::move(restricted));
+   // scaling the inverse to integers keeps the equalities between the values.
+   mpz_class denominator(1);
+   for ( const auto& row : rational_inverse )
+   {
+      for ( const auto& entry : row )
+      {
+         mpz_lcm(denominator.get_mpz_t(), denominator.get_mpz_t(), entry.get_den_mpz_t());
+      }
+   }
+   ExactMatrix scaled_inverse(r, std::vector<mpz_class>(r));
+   for ( std::size_t a = 0; a < r; ++a )
+   {
+      for ( std::size_t b = 0; b < r; ++b )
+      {
+         scaled_inverse[a][b] = rational_inverse[a][b].get_num() * (denominator / rational_inverse[a][b].get_den());
+      }
+   }
+   // transformed[j] = Q^-1 r_j (scaled), the color of (i, j) is r_i^T Q^-1 r_j.
+   ExactMatrix transformed(n, std::vector<mpz_class>(r));
+   for ( std::size_t j = 0; j < n; ++j )
+   {
+      for ( std::size_t a = 0; a < r; ++a )
+      {
+         for ( std::size_t b = 0; b < r; ++b )
+         {
+            transformed[j][a] += scaled_inverse[a][b] * matrix[j][basis[b]];
+         }
+      }
+   }
+   std::map<mpz_class, ColoredGraph::Color> color_ids;
+   std::vector<ColoredGraph::Color> colors;
+   colors.reserve(n * n);
+   mpz_class value;
+   for ( std::size_t i = 0; i < n; ++i )
+   {
+      for ( std::size_t j = 0; j < n; ++j )
+      {
+         value = 0;
+         for ( std::size_t a = 0; a < r; ++a )
+         {
+            value += matrix[i][basis[a]] * transformed[j][a];
+         }
+         const auto id = static_cast<ColoredGraph::Color>(color_ids.size());
+         colors.push_back(color_ids.emplace(value, id).first->second);
+      }
+   }
+   return ColoredGraph(n, std::move(colors)).automorphisms();
+}
+
+namespace
+{
+   template <typename Integer>
+   ExactMatrix exact(const Matrix<Integer>& rows)
+   {
+      ExactMatrix result;
+      result.reserve(rows.size());
+      for ( const auto& row : rows )
+      {
+         result.emplace_back();
+         for ( const auto& entry : row )
+         {
+            std::ostringstream stream;
+            stream << entry;
+            result.back().emplace_back(stream.str());
+         }
+      }
+      return result;
+   }
+
+   std::vector<std::size_t> independentColumns(RationalMatrix matrix)
+   {
+      std::vector<std::size_t> columns;
+      std::size_t rank{0};
+      for ( std::size_t column = 0; column < matrix.size() && rank < matrix.size(); ++column )
+      {
+         std::size_t pivot = rank;
+         while ( pivot < matrix.size() && matrix[pivot][column] == 0 )
+         {
+            ++pivot;
+         }
+         if ( pivot == matrix.size() )
+         {
+            continue;
+         }
+         std::swap(matrix[rank], matrix[pivot]);
+         for ( std::size_t i = rank + 1; i < matrix.size(); ++i )
+         {
+            if ( matrix[i][column] != 0 )
+            {
+               const mpq_class factor = matrix[i][column] / matrix[rank][column];
+               for ( std::size_t j = column; j < matrix[i].size(); ++j )
+               {
+                  matrix[i][j] -= factor * matrix[rank][j];
+               }
+            }
+         }
+         columns.push_back(column);
+         ++rank;
+      }
+      return columns;
+   }
+
+   RationalMatrix inverse(RationalMatrix matrix)
+   {
+      const auto size = matrix.size();
+      RationalMatrix result(size, std::vector<mpq_class>(size));
+      for ( std::size_t i = 0; i < size; ++i )
+      {
+         result[i][i] = 1;
+      }
+      for ( std::size_t column = 0; column < size; ++column )
+      {
+         std::size_t pivot = column;
+         while ( matrix[pivot][column] == 0 )
+         {
+            ++pivot;
+            assert( pivot < size );
+         }
+         std::swap(matrix[column], matrix[pivot]);
+         std::swap(result[column], result[pivot]);
+         const mpq_class scale = 1 / matrix[column][column];
+         for ( std::size_t j = 0; j < size; ++j )
+         {
+            matrix[column][j] *= scale;
+            result[column][j] *= scale;
+         }
+         for ( std::size_t i = 0; i < size; ++i )
+         {
+            if ( i != column && matrix[i][column] != 0 )
+            {
+               const mpq_class factor = matrix[i][column];
+               for ( std::size_t j = 0; j < size; ++j )
+               {
+                  matrix[i][j] -= factor * matrix[column][j];
+                  result[i][j] -= factor * result[column][j];
+               }
+            }
+         }
+      }
+      return result;
+   }
+}
+
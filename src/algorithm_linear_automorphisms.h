@@ -0,0 +1,29 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "matrix.h"
+
+namespace panda
+{
+   namespace algorithm
+   {
+      /// Returns generators of the linear automorphism group of the rows, i.e. of all row
+      /// permutations that are induced by a linear map, as permutations of the row indices
+      /// (empty if the group is trivial). With Q being the Gram matrix of a basis of the
+      /// columns, a permutation is induced by a linear map iff it preserves r_i^T Q^-1 r_j
+      /// for all pairs of rows, hence the group is found as the automorphism group of the
+      /// complete graph on the rows colored by these values.
+      template <typename Integer>
+      std::vector<std::vector<std::size_t>> linearAutomorphisms(const Matrix<Integer>&);
+   }
+}
+
+#include "algorithm_linear_automorphisms.eti"
+
@@ -10,9 +10,15 @@
 
 #include <algorithm>
 #include <cassert>
+#include <exception>
 #include <iostream>
+#include <list>
 
+#include "algorithm_integer_operations.h"
 #include "algorithm_row_operations.h"
+#include "compiled_map.h"
+#include "joining_thread.h"
+#include "row_index.h"
 
 using namespace panda;
 
@@ -69,10 +75,72 @@ Row<Integer> algorithm::apply(const Map& map, const Row<Integer>& row, TagType t
          applyTerm(row, result, i, term, tag);
       }
    }
-   const auto gcd_value = gcd(result);
-   if ( gcd_value > 1 )
+   divideByGcd(result);
+   return result;
+}
+
+template <typename Integer, typename TagType>
+std::vector<std::vector<std::size_t>> algorithm::images(const Maps& maps, const Matrix<Integer>& rows, TagType tag, const int thread_limit)
+{
+   assert( thread_limit > 0 );
+   const RowIndex<Integer> index(rows);
+   // rows with a common divisor are normalized by apply, the compiled maps do not divide.
+   std::vector<char> primitive;
+   primitive.reserve(rows.size());
+   for ( const auto& row : rows )
+   {
+      Integer divisor(0);
+      for ( const auto& entry : row )
+      {
+         divisor = gcd(divisor, entry);
+      }
+      primitive.push_back(divisor <= 1 ? 1 : 0);
+   }
+   std::vector<std::vector<std::size_t>> result(maps.size());
+   const auto thread_count = std::max(std::size_t{1}, std::min(maps.size(), static_cast<std::size_t>(thread_limit)));
+   std::vector<std::exception_ptr> errors(thread_count);
+   {
+      std::list<JoiningThread> threads;
+      for ( std::size_t t = 0; t < thread_count; ++t )
+      {
+         threads.emplace_back([&, t]()
+         {
+            try
+            {
+               Row<Integer> image;
+               for ( std::size_t m = t; m < maps.size(); m += thread_count )
+               {
+                  const auto compiled = CompiledMap::create(maps[m], tag);
+                  auto& positions = result[m];
+                  positions.reserve(rows.size());
+                  for ( std::size_t r = 0; r < rows.size(); ++r )
+                  {
+                     const auto& row = rows[r];
+                     image.resize(row.size());
+                     if ( compiled && compiled->size() == row.size() && primitive[r] && compiled->apply(row, image) )
+                     {
+                        positions.push_back(index.find(image));
+                     }
+                     else
+                     {
+                        positions.push_back(index.find(apply(maps[m], row, tag)));
+                     }
+                  }
+               }
+            }
+            catch ( ... )
+            {
+               errors[t] = std::current_exception();
+            }
+         });
+      }
+   }
+   for ( const auto& error : errors )
    {
-      result /= gcd_value;
+      if ( error )
+      {
+         std::rethrow_exception(error);
+      }
    }
    return result;
 }
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iosfwd>
+#include <vector>
 
 #include "maps.h"
 #include "matrix.h"
+#include "row_index.h"
 #include "tags.h"
 
 namespace panda
@@ -22,6 +25,11 @@ namespace panda
       /// Applies a Map onto a row.
       template <typename Integer, typename TagType>
       Row<Integer> apply(const Map&, const Row<Integer>&, TagType);
+      /// Applies each map onto each row and looks the image up among the rows. Returns per map
+      /// the positions of the images (RowIndex<Integer>::npos if missing). Maps run in parallel
+      /// on up to the given number of threads.
+      template <typename Integer, typename TagType>
+      std::vector<std::vector<std::size_t>> images(const Maps&, const Matrix<Integer>&, TagType, int thread_count);
    }
 }
 
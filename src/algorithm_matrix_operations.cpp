@@ -11,7 +11,9 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <stdexcept>
 #include <tuple>
+#include <type_traits>
 
 #include "algorithm_integer_operations.h"
 #include "algorithm_row_operations.h"
@@ -70,7 +72,27 @@ namespace
    using RowIndex = std::size_t;
    using ColumnIndex = std::size_t;
    template <typename Integer>
-   void eliminateColumns(Matrix<Integer>&, const RowIndex, const ColumnIndex);
+   std::size_t rank(Matrix<Integer>&, bool);
+   template <typename Integer>
+   std::pair<Indices, Indices> eliminate(Matrix<Integer>&, bool);
+   template <typename Integer>
+   Integer divideExactly(const Integer, const Integer);
+   template <typename Integer>
+   Integer fractionFreeEntry(const Integer&, const Integer&, const Integer&, const Integer&, const Integer&, std::true_type);
+   template <typename Integer>
+   Integer fractionFreeEntry(const Integer&, const Integer&, const Integer&, const Integer&, const Integer&, std::false_type);
+   template <typename Integer>
+   Integer scaledEntry(const Integer&, const Integer&, const Integer&, std::true_type);
+   template <typename Integer>
+   Integer scaledEntry(const Integer&, const Integer&, const Integer&, std::false_type);
+   template <typename Integer>
+   void eliminateEntries(Row<Integer>&, const Row<Integer>&, const Integer, const Integer, const Integer);
+   template <typename Integer>
+   void eliminateColumns(Matrix<Integer>&, const RowIndex, const ColumnIndex, const Integer);
+   template <typename Integer>
+   void eliminateColumnsWithGcd(Matrix<Integer>&, const RowIndex, const ColumnIndex);
+   template <typename Integer>
+   void normalizeColumn(Matrix<Integer>&, const ColumnIndex);
    template <typename Integer>
    std::pair<RowIndex, ColumnIndex> pivot(Matrix<Integer>&, std::size_t, std::vector<ColumnIndex>&);
 }
@@ -79,83 +101,42 @@ template <typename Integer>
 std::size_t algorithm::dimension(Matrix<Integer> matrix)
 {
    assert( !matrix.empty() && !matrix.back().empty() );
-   std::vector<std::size_t> pivot_columns;
-   for ( std::size_t i = 0; i < matrix.size(); ++i )
+   if ( std::is_integral<Integer>::value )
    {
-      auto& row = matrix[i];
-      assert( i == pivot_columns.size() );
-      for ( std::size_t j = 0; j < i; ++j ) // use row j to eliminate coefficients in row i.
-      {
-         const auto piv_col = pivot_columns[j];
-         if ( row[piv_col] != 0 )
-         {
-            const auto factor = row[piv_col];
-            row *= Integer(-matrix[j][piv_col]); // Integer type name necessary because of integral promotion of short.
-            row += factor * matrix[j];
-            const auto gcd_value = gcd(row);
-            if ( gcd_value > 1 )
-            {
-               row /= gcd_value;
-            }
-         }
-      }
-      const auto nz_entry = std::find_if(row.cbegin(), row.cend(), [](const Integer& a) { return a != 0; });
-      if ( nz_entry == row.cend() )
+      // the products of the fraction-free elimination may overflow a native integer type,
+      // then the rank is computed again with gcd steps, which keep the entries small.
+      auto copy = matrix;
+      try
       {
-         matrix.erase(matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(i));
-         --i;
+         return rank(copy, true);
       }
-      else
+      catch ( const std::overflow_error& )
       {
-         pivot_columns.push_back(static_cast<std::size_t>(nz_entry - row.cbegin()));
+         return rank(matrix, false);
       }
    }
-   return pivot_columns.size();
+   return rank(matrix, true);
 }
 
 template <typename Integer>
 std::pair<Indices, Indices> algorithm::gaussianElimination(Matrix<Integer>& matrix)
 {
    assert( !matrix.empty() && !matrix.back().empty() );
-   Indices L;
-   Indices T;
-   const auto row_size = matrix.size();
-   const auto col_size = matrix.back().size();
-   const auto t = matrix.size() - matrix.back().size();
-   std::vector<ColumnIndex> used_columns;
-   used_columns.reserve(col_size);
-   for ( RowIndex row = 0; row < row_size; ++row )
+   if ( std::is_integral<Integer>::value )
    {
-      std::size_t col;
-      std::tie(row, col) = pivot(matrix, row, used_columns);
-      if ( row == row_size )
+      // as in dimension, the elimination starts over with gcd steps on overflow.
+      auto copy = matrix;
+      try
       {
-         break;
+         return eliminate(matrix, true);
       }
-      if ( row >= t )
+      catch ( const std::overflow_error& )
       {
-         L.push_back(col);
-      }
-      else
-      {
-         T.push_back(row);
-      }
-      eliminateColumns(matrix, row, col);
-   }
-   for ( ColumnIndex col = 0; col < col_size; ++col )
-   {
-      using Type = Row<Integer>;
-      const auto& m = matrix;
-      const auto& pivot_row = *std::find_if(m.cbegin(), m.cend(), [col](const Type& row) { return row[col] != 0; });
-      if ( pivot_row[col] < 0 )
-      {
-         for ( RowIndex row = 0; row < row_size; ++row )
-         {
-            matrix[row][col] *= Integer(-1);
-         }
+         matrix = std::move(copy);
+         return eliminate(matrix, false);
       }
    }
-   return std::make_pair(L, T);
+   return eliminate(matrix, true);
 }
 
 template <typename Integer>
@@ -203,6 +184,106 @@ Equations<Integer> algorithm::extractEquations(Matrix<Integer>& matrix, const In
 
 namespace
 {
+   /// Rank of the matrix, which is reduced to its independent rows on the way. The rows are
+   /// eliminated fraction-free (Bareiss) or with a gcd division after each step.
+   template <typename Integer>
+   std::size_t rank(Matrix<Integer>& matrix, const bool fraction_free)
+   {
+      std::vector<std::size_t> pivot_columns;
+      for ( std::size_t i = 0; i < matrix.size(); ++i )
+      {
+         auto& row = matrix[i];
+         assert( i == pivot_columns.size() );
+         // fraction-free (Bareiss) elimination: the division by the previous pivot is exact.
+         Integer previous(1);
+         for ( std::size_t j = 0; j < i; ++j ) // use row j to eliminate coefficients in row i.
+         {
+            const auto piv_col = pivot_columns[j];
+            const auto& pivot_row = matrix[j];
+            const auto pivot = pivot_row[piv_col];
+            if ( fraction_free )
+            {
+               eliminateEntries(row, pivot_row, pivot, row[piv_col], previous);
+               previous = pivot;
+            }
+            else if ( row[piv_col] != 0 )
+            {
+               const auto factor = row[piv_col];
+               row *= Integer(-pivot); // Integer type name necessary because of integral promotion of short.
+               row += factor * pivot_row;
+               algorithm::divideByGcd(row);
+            }
+         }
+         const auto nz_entry = std::find_if(row.cbegin(), row.cend(), [](const Integer& a) { return a != 0; });
+         if ( nz_entry == row.cend() )
+         {
+            matrix.erase(matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(i));
+            --i;
+         }
+         else
+         {
+            pivot_columns.push_back(static_cast<std::size_t>(nz_entry - row.cbegin()));
+         }
+      }
+      return pivot_columns.size();
+   }
+
+   /// Gaussian elimination by columns, fraction-free (Bareiss) or with a gcd division of each
+   /// modified column. See algorithm::gaussianElimination for the result.
+   template <typename Integer>
+   std::pair<Indices, Indices> eliminate(Matrix<Integer>& matrix, const bool fraction_free)
+   {
+      Indices L;
+      Indices T;
+      const auto row_size = matrix.size();
+      const auto col_size = matrix.back().size();
+      const auto t = matrix.size() - matrix.back().size();
+      std::vector<ColumnIndex> used_columns;
+      used_columns.reserve(col_size);
+      Integer previous_pivot(1);
+      for ( RowIndex row = 0; row < row_size; ++row )
+      {
+         std::size_t col;
+         std::tie(row, col) = pivot(matrix, row, used_columns);
+         if ( row == row_size )
+         {
+            break;
+         }
+         if ( row >= t )
+         {
+            L.push_back(col);
+         }
+         else
+         {
+            T.push_back(row);
+         }
+         if ( fraction_free )
+         {
+            eliminateColumns(matrix, row, col, previous_pivot);
+            previous_pivot = matrix[row][col];
+         }
+         else
+         {
+            eliminateColumnsWithGcd(matrix, row, col);
+         }
+      }
+      for ( ColumnIndex col = 0; col < col_size; ++col )
+      {
+         normalizeColumn(matrix, col);
+         using Type = Row<Integer>;
+         const auto& m = matrix;
+         const auto& pivot_row = *std::find_if(m.cbegin(), m.cend(), [col](const Type& row) { return row[col] != 0; });
+         if ( pivot_row[col] < 0 )
+         {
+            for ( RowIndex row = 0; row < row_size; ++row )
+            {
+               matrix[row][col] *= Integer(-1);
+            }
+         }
+      }
+      return std::make_pair(L, T);
+   }
+
    template <typename Integer>
    void normalizeColumn(Matrix<Integer>& matrix, const ColumnIndex column)
    {
@@ -221,33 +302,150 @@ namespace
       }
    }
 
+   /// Division of which the caller knows that it has no remainder.
+   /// Divisors 1 and -1 (the common case for 0/1 vertices) avoid the division.
+   template <typename Integer>
+   Integer divideExactly(const Integer dividend, const Integer divisor)
+   {
+      if ( divisor == 1 )
+      {
+         return dividend;
+      }
+      if ( divisor == -1 )
+      {
+         return Integer(-dividend);
+      }
+      return dividend / divisor;
+   }
+
+   /// Returns (a * x - b * y) / divisor, where the division is exact. Throws std::overflow_error
+   /// if a native integer type overflows (which would be undefined behaviour).
+   template <typename Integer>
+   Integer fractionFreeEntry(const Integer& a, const Integer& x, const Integer& b, const Integer& y, const Integer& divisor, std::true_type)
+   {
+      Integer ax;
+      Integer by;
+      Integer difference;
+      if ( __builtin_mul_overflow(a, x, &ax) || __builtin_mul_overflow(b, y, &by) || __builtin_sub_overflow(ax, by, &difference) )
+      {
+         throw std::overflow_error("Fraction-free elimination did overflow.");
+      }
+      if ( divisor == -1 && __builtin_sub_overflow(Integer(0), difference, &difference) )
+      {
+         throw std::overflow_error("Fraction-free elimination did overflow.");
+      }
+      return ( divisor == -1 ) ? difference : divideExactly(difference, divisor);
+   }
+
+   /// Returns (a * x - b * y) / divisor, where the division is exact.
    template <typename Integer>
-   void eliminateColumn(Matrix<Integer>& matrix, const RowIndex row, const ColumnIndex col, const ColumnIndex ecol)
+   Integer fractionFreeEntry(const Integer& a, const Integer& x, const Integer& b, const Integer& y, const Integer& divisor, std::false_type)
+   {
+      return divideExactly(Integer(a * x - b * y), divisor);
+   }
+
+   /// Returns a * x / divisor, where the division is exact. Throws std::overflow_error if a
+   /// native integer type overflows.
+   template <typename Integer>
+   Integer scaledEntry(const Integer& a, const Integer& x, const Integer& divisor, std::true_type)
+   {
+      return fractionFreeEntry(a, x, Integer(0), Integer(0), divisor, std::true_type{});
+   }
+
+   /// Returns a * x / divisor, where the division is exact.
+   template <typename Integer>
+   Integer scaledEntry(const Integer& a, const Integer& x, const Integer& divisor, std::false_type)
+   {
+      return divideExactly(Integer(a * x), divisor);
+   }
+
+   /// One fraction-free (Bareiss) step on a single row:
+   /// row = (pivot * row - factor * pivot_row) / previous_pivot, where the division is exact.
+   template <typename Integer>
+   void eliminateEntries(Row<Integer>& row, const Row<Integer>& pivot_row, const Integer pivot, const Integer factor, const Integer previous_pivot)
+   {
+      assert( row.size() == pivot_row.size() );
+      if ( factor == 0 )
+      {
+         if ( pivot != previous_pivot )
+         {
+            for ( auto& entry : row )
+            {
+               entry = scaledEntry(pivot, entry, previous_pivot, std::is_integral<Integer>{});
+            }
+         }
+         return;
+      }
+      for ( std::size_t k = 0; k < row.size(); ++k )
+      {
+         row[k] = fractionFreeEntry(pivot, row[k], factor, pivot_row[k], previous_pivot, std::is_integral<Integer>{});
+      }
+   }
+
+   /// One fraction-free (Bareiss) step on column ecol using the pivot column col.
+   template <typename Integer>
+   void eliminateColumn(Matrix<Integer>& matrix, const RowIndex row, const ColumnIndex col, const ColumnIndex ecol, const Integer previous_pivot)
    {
       const auto row_size = matrix.size();
-      const auto a = -matrix[row][col];
-      const auto b =  matrix[row][ecol];
+      const auto a = matrix[row][col];
+      const auto b = matrix[row][ecol];
+      if ( b == 0 )
+      {
+         if ( a != previous_pivot )
+         {
+            for ( RowIndex j = 0; j < row_size; ++j )
+            {
+               matrix[j][ecol] = scaledEntry(a, matrix[j][ecol], previous_pivot, std::is_integral<Integer>{});
+            }
+         }
+         return;
+      }
       for ( RowIndex j = 0; j < row_size; ++j )
       {
-         matrix[j][ecol] *= a;
-         matrix[j][ecol] += (matrix[j][col] * b);
+         matrix[j][ecol] = fractionFreeEntry(a, matrix[j][ecol], b, matrix[j][col], previous_pivot, std::is_integral<Integer>{});
+      }
+   }
+
+   /// Eliminate all entries in column col except row to 0, by adding columns (using column "col").
+   /// The entries stay minors of the input matrix (Bareiss), so no gcd normalization is
+   /// needed in between; the columns are normalized once after the elimination.
+   template <typename Integer>
+   void eliminateColumns(Matrix<Integer>& matrix, const RowIndex row, const ColumnIndex col, const Integer previous_pivot)
+   {
+      assert( !matrix.empty() );
+      assert( row < matrix.size() );
+      assert( col < matrix.back().size() );
+      const auto col_size = matrix.back().size();
+      for ( ColumnIndex i = 0; i < col_size; ++i )
+      {
+         if ( i != col )
+         {
+            eliminateColumn(matrix, row, col, i, previous_pivot);
+         }
       }
    }
 
-   /// Eliminate all entries in column col except row to 0, by adding rows (using row "row").
+   /// Eliminate all entries in column col except row to 0, by adding columns (using column "col").
+   /// Each modified column is divided by the gcd of its entries.
    template <typename Integer>
-   void eliminateColumns(Matrix<Integer>& matrix, const RowIndex row, const ColumnIndex col)
+   void eliminateColumnsWithGcd(Matrix<Integer>& matrix, const RowIndex row, const ColumnIndex col)
    {
       assert( !matrix.empty() );
       assert( row < matrix.size() );
       assert( col < matrix.back().size() );
+      const auto row_size = matrix.size();
       const auto col_size = matrix.back().size();
+      const auto a = -matrix[row][col];
       for ( ColumnIndex i = 0; i < col_size; ++i )
       {
          const auto b = matrix[row][i];
          if ( i != col && b != 0 )
          {
-            eliminateColumn(matrix, row, col, i);
+            for ( RowIndex j = 0; j < row_size; ++j )
+            {
+               matrix[j][i] *= a;
+               matrix[j][i] += (matrix[j][col] * b);
+            }
             normalizeColumn(matrix, i);
          }
       }
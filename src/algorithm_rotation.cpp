@@ -30,36 +30,33 @@ namespace
 {
    /// Rotates a facet around a ridge. It's the exact same algorithm as for vertices.
    template <typename Integer>
-   Facet<Integer> rotate(const Vertices<Integer>&, Vertex<Integer>, const Facet<Integer>&, Facet<Integer>);
+   Facet<Integer> rotate(const Incidence<Integer>&, Vertex<Integer>, const Facet<Integer>&, Facet<Integer>);
    /// Returns all ridges on a facet (equivalent to all facets of the facet).
    template <typename Integer>
-   Inequalities<Integer> getRidges(const Vertices<Integer>&, const Facet<Integer>&);
-   /// Returns all vertices that lie on the facet (satisfy the inequality with equality).
-   template <typename Integer>
-   Vertices<Integer> verticesWithZeroDistance(const Vertices<Integer>&, const Facet<Integer>&);
+   Inequalities<Integer> getRidges(const Incidence<Integer>&, const Facet<Integer>&);
    /// Returns ridges using single-threaded adjacency decomposition on the sub-polytope.
    template <typename Integer, typename TagType>
-   Inequalities<Integer> getRidgesRecursive(const Vertices<Integer>&, const Facet<Integer>&, TagType, int, int, bool);
+   Inequalities<Integer> getRidgesRecursive(const Incidence<Integer>&, const Facet<Integer>&, TagType, int, int, bool);
    /// Performs single-threaded adjacency decomposition, returning all facets found.
    template <typename Integer, typename TagType>
    Matrix<Integer> singleThreadedAD(const Matrix<Integer>&, TagType, int, int, bool);
 }
 
 template <typename Integer, typename TagType>
-Matrix<Integer> panda::algorithm::rotation(const Matrix<Integer>& matrix,
+Matrix<Integer> panda::algorithm::rotation(const Incidence<Integer>& incidence,
                                     const Row<Integer>& input,
-                                    const Maps& maps,
+                                    const MapGroup& maps,
                                     const std::optional<VertexGroup>& vertex_group,
                                     TagType tag)
 {
    // as the first step of the rotation, the furthest Vertex w.r.t. the input facet is calculated.
    // this will be the same vertex for all neighbouring ridges, hence, only needs to be computed once.
-   const auto furthest_vertex = furthestVertex(matrix, input);
-   const auto ridges = getRidges(matrix, input);
+   const auto furthest_vertex = incidence.furthestVertex(input);
+   const auto ridges = getRidges(incidence, input);
    std::set<Row<Integer>> output;
    for ( const auto& ridge : ridges )
    {
-      const auto new_row = rotate(matrix, furthest_vertex, input, ridge);
+      const auto new_row = rotate(incidence, furthest_vertex, input, ridge);
       output.insert(new_row);
    }
    // When vertex group is available, skip equivalence reduction here;
@@ -72,21 +69,21 @@ Matrix<Integer> panda::algorithm::rotation(const Matrix<Integer>& matrix,
 }
 
 template <typename Integer, typename TagType>
-Matrix<Integer> panda::algorithm::rotationRecursive(const Matrix<Integer>& matrix,
+Matrix<Integer> panda::algorithm::rotationRecursive(const Incidence<Integer>& incidence,
                                     const Row<Integer>& input,
-                                    const Maps& maps,
+                                    const MapGroup& maps,
                                     const std::optional<VertexGroup>& vertex_group,
                                     TagType tag,
                                     int recursion_depth,
                                     int min_vertices,
                                     bool sampling)
 {
-   const auto furthest_vertex = furthestVertex(matrix, input);
-   const auto ridges = getRidgesRecursive(matrix, input, tag, recursion_depth, min_vertices, sampling);
+   const auto furthest_vertex = incidence.furthestVertex(input);
+   const auto ridges = getRidgesRecursive(incidence, input, tag, recursion_depth, min_vertices, sampling);
    std::set<Row<Integer>> output;
    for ( const auto& ridge : ridges )
    {
-      const auto new_row = rotate(matrix, furthest_vertex, input, ridge);
+      const auto new_row = rotate(incidence, furthest_vertex, input, ridge);
       output.insert(new_row);
    }
    #ifdef DEBUG
@@ -104,7 +101,7 @@ Matrix<Integer> panda::algorithm::rotationRecursive(const Matrix<Integer>& matri
 namespace
 {
    template <typename Integer>
-   Facet<Integer> rotate(const Vertices<Integer>& vertices, Vertex<Integer> vertex, const Facet<Integer>& facet, Facet<Integer> ridge)
+   Facet<Integer> rotate(const Incidence<Integer>& incidence, Vertex<Integer> vertex, const Facet<Integer>& facet, Facet<Integer> ridge)
    {
       // the calculation of the initial vertex, which has to be the furthest vertex w.r.t. "facet", is calculated outside of this function as it is the same for all rotations.
       auto d_f = algorithm::distance(facet, vertex);
@@ -118,13 +115,9 @@ namespace
             d_r /= gcd_ds;
          }
          ridge = d_f * ridge - d_r * facet;
-         const auto gcd_value = algorithm::gcd(ridge);
-         assert( gcd_value != 0 );
-         if ( gcd_value > 1 )
-         {
-            ridge /= gcd_value;
-         }
-         vertex = algorithm::nearestVertex(vertices, ridge);
+         assert( algorithm::gcd(ridge) != 0 );
+         algorithm::divideByGcd(ridge);
+         vertex = incidence.nearestVertex(ridge);
          d_f = algorithm::distance(facet, vertex);
          d_r = algorithm::distance(ridge, vertex);
       }
@@ -133,28 +126,17 @@ namespace
    }
 
    template <typename Integer>
-   Inequalities<Integer> getRidges(const Vertices<Integer>& vertices, const Facet<Integer>& facet)
+   Inequalities<Integer> getRidges(const Incidence<Integer>& incidence, const Facet<Integer>& facet)
    {
-      const auto vertices_on_facet = verticesWithZeroDistance(vertices, facet);
+      const auto vertices_on_facet = incidence.verticesOnFace(facet);
       assert( !vertices_on_facet.empty() );
       return algorithm::fourierMotzkinElimination(vertices_on_facet);
    }
 
-   template <typename Integer>
-   Vertices<Integer> verticesWithZeroDistance(const Vertices<Integer>& vertices, const Facet<Integer>& facet)
-   {
-      Vertices<Integer> selection;
-      std::copy_if(vertices.cbegin(), vertices.cend(), std::back_inserter(selection), [&facet](const Vertex<Integer>& vertex)
-      {
-         return (algorithm::distance(facet, vertex) == 0);
-      });
-      return selection;
-   }
-
    template <typename Integer, typename TagType>
-   Inequalities<Integer> getRidgesRecursive(const Vertices<Integer>& vertices, const Facet<Integer>& facet, TagType tag, int recursion_depth, int min_vertices, bool sampling)
+   Inequalities<Integer> getRidgesRecursive(const Incidence<Integer>& incidence, const Facet<Integer>& facet, TagType tag, int recursion_depth, int min_vertices, bool sampling)
    {
-      const auto vertices_on_facet = verticesWithZeroDistance(vertices, facet);
+      const auto vertices_on_facet = incidence.verticesOnFace(facet);
       assert( !vertices_on_facet.empty() );
       const auto num_vertices = static_cast<int>(vertices_on_facet.size());
       const auto effective_min = (min_vertices < 2) ? 2 : min_vertices;
@@ -196,24 +178,25 @@ namespace
          queue.assign(initial_facets.begin(), initial_facets.end());
       }
       const Maps empty_maps;
+      const Incidence<Integer> incidence(vertices);
       while ( !queue.empty() )
       {
          auto current = queue.front();
          queue.pop_front();
-         const auto furthest = algorithm::furthestVertex(vertices, current);
+         const auto furthest = incidence.furthestVertex(current);
          Inequalities<Integer> ridges;
          const auto effective_min = (min_vertices < 2) ? 2 : min_vertices;
          if ( recursion_depth > 0 && static_cast<int>(vertices.size()) >= effective_min )
          {
-            ridges = getRidgesRecursive(vertices, current, tag, recursion_depth, min_vertices, sampling);
+            ridges = getRidgesRecursive(incidence, current, tag, recursion_depth, min_vertices, sampling);
          }
          else
          {
-            ridges = getRidges(vertices, current);
+            ridges = getRidges(incidence, current);
          }
          for ( const auto& ridge : ridges )
          {
-            const auto adjacent = rotate(vertices, furthest, current, ridge);
+            const auto adjacent = rotate(incidence, furthest, current, ridge);
             if ( all_facets.find(adjacent) == all_facets.end() )
             {
                all_facets.insert(adjacent);
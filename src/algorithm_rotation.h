@@ -8,7 +8,8 @@
 
 #include <optional>
 
-#include "maps.h"
+#include "incidence.h"
+#include "map_group.h"
 #include "matrix.h"
 #include "row.h"
 #include "tags.h"
@@ -19,11 +20,12 @@ namespace panda
    namespace algorithm
    {
       /// Returns all adjacent rows (or class representatives) of a row by using the rotation algorithm.
+      /// The incidence holds the vertices (or facets) of the polytope.
       template <typename Integer, typename TagType>
-      Facets<Integer> rotation(const Vertices<Integer>&, const Facet<Integer>&, const Maps&, const std::optional<VertexGroup>&, TagType);
+      Facets<Integer> rotation(const Incidence<Integer>&, const Facet<Integer>&, const MapGroup&, const std::optional<VertexGroup>&, TagType);
       /// Same as rotation, but finds ridges via recursive adjacency decomposition instead of FME.
       template <typename Integer, typename TagType>
-      Facets<Integer> rotationRecursive(const Vertices<Integer>&, const Facet<Integer>&, const Maps&, const std::optional<VertexGroup>&, TagType, int, int, bool);
+      Facets<Integer> rotationRecursive(const Incidence<Integer>&, const Facet<Integer>&, const MapGroup&, const std::optional<VertexGroup>&, TagType, int, int, bool);
    }
 }
 
@@ -14,13 +14,32 @@
 #include <iostream>
 #include <numeric>
 #include <stdexcept>
+#include <type_traits>
 
 #include "algorithm_inequality_operations.h"
 #include "algorithm_integer_operations.h"
 #include "cast.h"
+#include "binary_gcd.h"
+#include "count_trailing_zeros.h"
 
 using namespace panda;
 
+namespace
+{
+   /// gcd of a row of native integers.
+   template <typename Integer>
+   Integer rowGcd(const Row<Integer>&, std::true_type) noexcept;
+   /// gcd of a row of any other integer type.
+   template <typename Integer>
+   Integer rowGcd(const Row<Integer>&, std::false_type) noexcept;
+   /// exact division of a row of native integers by a divisor > 1.
+   template <typename Integer>
+   void divideExactly(Row<Integer>&, Integer, std::true_type) noexcept;
+   /// exact division of a row of any other integer type by a divisor > 1.
+   template <typename Integer>
+   void divideExactly(Row<Integer>&, Integer, std::false_type);
+}
+
 template <typename Integer>
 std::ostream& operator<<(std::ostream& output, const Row<Integer>& row)
 {
@@ -234,34 +253,24 @@ Row<Integer> panda::algorithm::normalize(Row<Integer> row, const Equations<Integ
          row -= a * eq;
       }
    }
-   const auto gcd_value = gcd(row);
-   if ( gcd_value > 1 )
-   {
-      row /= gcd_value;
-   }
+   divideByGcd(row);
    return row;
 }
 
 template <typename Integer>
 Integer panda::algorithm::gcd(const Row<Integer>& row) noexcept
 {
-   Integer value(0);
-   std::size_t i{0};
-   for ( ; i < row.size() && row[i] == 0; ++i )
-   {
-   }
-   if ( i < row.size() )
-   {
-      using std::abs;
-      using algorithm::abs;
-      value = abs(row[i]);
-      ++i;
-   }
-   for ( ; i < row.size() && value > 1; ++i )
+   return rowGcd(row, std::is_integral<Integer>{});
+}
+
+template <typename Integer>
+void panda::algorithm::divideByGcd(Row<Integer>& row)
+{
+   const auto gcd_value = gcd(row);
+   if ( gcd_value > 1 )
    {
-      value = gcd(row[i], value);
+      divideExactly(row, gcd_value, std::is_integral<Integer>{});
    }
-   return value;
 }
 
 template <typename Integer>
@@ -286,3 +295,94 @@ Integer panda::algorithm::lcm(const Row<Integer>& row) noexcept
    return value;
 }
 
+
+namespace
+{
+   template <typename Integer>
+   Integer rowGcd(const Row<Integer>& row, std::true_type) noexcept
+   {
+      // Rows are sparse and most of them contain a unit early on, so the zeros are skipped
+      // without any gcd computation and the fold stops as soon as the gcd is one.
+      // The binary gcd is inlined here and works on the magnitudes in the unsigned type.
+      using Unsigned = typename std::make_unsigned<Integer>::type;
+      const auto magnitude = [](const Integer entry)
+      {
+         return (entry < 0) ? static_cast<Unsigned>(Unsigned(0) - static_cast<Unsigned>(entry)) : static_cast<Unsigned>(entry);
+      };
+      const auto data = row.data();
+      const auto size = row.size();
+      std::size_t i{0};
+      for ( ; i < size && data[i] == 0; ++i )
+      {
+      }
+      if ( i == size )
+      {
+         return Integer(0);
+      }
+      Unsigned value = magnitude(data[i]);
+      for ( ++i; i < size && value > 1; ++i )
+      {
+         if ( data[i] != 0 )
+         {
+            value = binaryGcd(value, magnitude(data[i]));
+         }
+      }
+      return static_cast<Integer>(value);
+   }
+
+   template <typename Integer>
+   Integer rowGcd(const Row<Integer>& row, std::false_type) noexcept
+   {
+      Integer value(0);
+      std::size_t i{0};
+      for ( ; i < row.size() && row[i] == 0; ++i )
+      {
+      }
+      if ( i < row.size() )
+      {
+         using std::abs;
+         using algorithm::abs;
+         value = abs(row[i]);
+         ++i;
+      }
+      for ( ; i < row.size() && value > 1; ++i )
+      {
+         value = algorithm::gcd(row[i], value);
+      }
+      return value;
+   }
+
+   template <typename Integer>
+   void divideExactly(Row<Integer>& row, const Integer divisor, std::true_type) noexcept
+   {
+      assert( divisor > 1 );
+      using Unsigned = typename std::make_unsigned<Integer>::type;
+      const auto data = row.data();
+      const auto size = row.size();
+      const auto unsigned_divisor = static_cast<Unsigned>(divisor);
+      if ( (unsigned_divisor & (unsigned_divisor - 1u)) == 0 )
+      {
+         // all entries are multiples of the divisor, so an arithmetic shift is an exact division.
+         const auto shift = countTrailingZeros(unsigned_divisor);
+         for ( std::size_t i = 0; i < size; ++i )
+         {
+            data[i] = static_cast<Integer>(data[i] >> shift);
+         }
+      }
+      else
+      {
+         for ( std::size_t i = 0; i < size; ++i )
+         {
+            data[i] = static_cast<Integer>(data[i] / divisor);
+         }
+      }
+   }
+
+   template <typename Integer>
+   void divideExactly(Row<Integer>& row, const Integer divisor, std::false_type)
+   {
+      assert( divisor > 1 );
+      row /= divisor;
+   }
+}
+
@@ -60,6 +60,9 @@ namespace panda
       /// Calculates the greatest common divisor of all entries of a row.
       template <typename Integer>
       Integer gcd(const Row<Integer>&) noexcept;
+      /// Divides all entries of a row by their greatest common divisor.
+      template <typename Integer>
+      void divideByGcd(Row<Integer>&);
       /// Calculates the least common multiple of all entries of a row.
       template <typename Integer>
       Integer lcm(const Row<Integer>&) noexcept;
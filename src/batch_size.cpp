@@ -0,0 +1,54 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "batch_size.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace panda;
+
+namespace
+{
+   /// Weight of the latest measurement in the smoothed duration per job.
+   constexpr double weight = 0.5;
+}
+
+panda::BatchSize::BatchSize(const Duration target_, const std::size_t maximum_)
+:
+   target(target_),
+   maximum(maximum_),
+   per_job(0),
+   size(1)
+{
+   assert( target.count() > 0.0 );
+   assert( maximum > 0 );
+}
+
+std::size_t panda::BatchSize::get() const noexcept
+{
+   return size;
+}
+
+void panda::BatchSize::record(const std::size_t jobs, const Duration elapsed) noexcept
+{
+   if ( jobs == 0 )
+   {
+      return;
+   }
+   const auto latest = elapsed / static_cast<double>(jobs);
+   per_job = ( per_job.count() > 0.0 ) ? weight * latest + (1.0 - weight) * per_job : latest;
+   if ( per_job.count() <= 0.0 )
+   {
+      size = maximum;
+      return;
+   }
+   const auto ideal = std::round(target / per_job);
+   // at most double the size per round trip, such that a single outlier doesn't grab the whole queue.
+   const auto limit = static_cast<double>(std::min(maximum, 2 * size));
+   size = static_cast<std::size_t>(std::max(1.0, std::min(ideal, limit)));
+}
+
@@ -0,0 +1,35 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace panda
+{
+   /// Number of jobs sent to a slave in one message. The size adapts to the measured
+   /// time per job, such that a round trip takes about the target duration: short jobs
+   /// are batched until the message latency is negligible, long jobs are sent one by one.
+   class BatchSize
+   {
+      public:
+         using Duration = std::chrono::duration<double>;
+         /// Constructor: arguments are the target duration of a round trip and the
+         /// maximal number of jobs per batch.
+         BatchSize(Duration, std::size_t);
+         /// Returns the number of jobs for the next batch.
+         std::size_t get() const noexcept;
+         /// Records the duration of a round trip with the given number of jobs.
+         void record(std::size_t, Duration) noexcept;
+      private:
+         const Duration target;
+         const std::size_t maximum;
+         /// smoothed duration per job (zero until the first measurement).
+         Duration per_job;
+         std::size_t size;
+   };
+}
+
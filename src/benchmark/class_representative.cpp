@@ -0,0 +1,94 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Benchmark of the class representative: orbit enumeration versus the stabilizer chain of the
+/// signed permutation group generated by the maps. The rows are random integer rows in the
+/// dimension of a Bell polytope, the maps are its (pure permutation) symmetries.
+/// Usage: benchmark_class_representative [file] (default: ../samples/panda_format/bell/2233)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+#include "algorithm_classes.h"
+#include "algorithm_row_operations.h"
+#include "input.h"
+#include "matrix.h"
+#include "row.h"
+#include "signed_permutation_group.h"
+
+using namespace panda;
+
+int main(int argc, char** argv)
+try
+{
+   char default_file[] = "../samples/panda_format/bell/2233";
+   char* arguments[] = {argv[0], (argc > 1) ? argv[1] : default_file};
+   const auto input = input::vertices<int>(2, arguments);
+   const auto& vertices = std::get<0>(input);
+   const auto& maps = std::get<2>(input);
+   if ( vertices.empty() || !SignedPermutationGroup::create(maps) )
+   {
+      throw std::invalid_argument("The benchmark requires vertices and maps that are signed permutations.");
+   }
+   const std::size_t number_of_rows = 100;
+   std::mt19937 generator{42};
+   std::uniform_int_distribution<int> entry(-3, 3);
+   Matrix<int> rows;
+   while ( rows.size() < number_of_rows )
+   {
+      Row<int> row(vertices.front().size());
+      for ( auto& value : row )
+      {
+         value = entry(generator);
+      }
+      algorithm::divideByGcd(row);
+      rows.push_back(row);
+   }
+   using Clock = std::chrono::steady_clock;
+   auto start = Clock::now();
+   Matrix<int> reference;
+   std::size_t orbit_sizes = 0;
+   for ( const auto& row : rows )
+   {
+      const auto row_class = algorithm::getClass(row, maps, tag::facet{});
+      orbit_sizes += row_class.size();
+      reference.push_back(*row_class.crbegin());
+   }
+   const auto reference_time = Clock::now() - start;
+   start = Clock::now();
+   Matrix<int> representatives;
+   for ( const auto& row : rows )
+   {
+      representatives.push_back(algorithm::classRepresentative(row, maps, tag::facet{}));
+   }
+   const auto new_time = Clock::now() - start;
+   if ( reference != representatives )
+   {
+      throw std::logic_error("Representatives differ.");
+   }
+   const auto microseconds = [&rows](const Clock::duration duration)
+   {
+      return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) / static_cast<double>(rows.size());
+   };
+   std::cout << "rows: " << rows.size() << ", dimension: " << rows.front().size()
+             << ", average orbit size: " << orbit_sizes / rows.size() << '\n'
+             << std::fixed << std::setprecision(1)
+             << "orbit enumeration: " << std::setw(10) << microseconds(reference_time) << " us/row\n"
+             << "stabilizer chain:  " << std::setw(10) << microseconds(new_time) << " us/row\n"
+             << "speedup: " << std::setprecision(2) << microseconds(reference_time) / microseconds(new_time) << '\n';
+}
+catch ( const std::exception& e )
+{
+   std::cerr << e.what() << '\n';
+   return EXIT_FAILURE;
+}
+
@@ -0,0 +1,215 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Benchmark of the equation extraction (gaussian elimination) and of the dimension computation,
+/// which run on the vertices at the start of every adjacency decomposition.
+/// Usage: benchmark_matrix_elimination [file] (default: ../samples/panda_format/bell/3333)
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+#include "algorithm_integer_operations.h"
+#include "algorithm_matrix_operations.h"
+#include "algorithm_row_operations.h"
+#include "big_integer.h"
+#include "cast.h"
+#include "input.h"
+#include "matrix.h"
+#include "row.h"
+
+using namespace panda;
+
+namespace
+{
+   /// The equation extraction as it was done before: cross-multiplication of columns
+   /// followed by a gcd normalization of the modified column.
+   template <typename Integer>
+   Equations<Integer> referenceExtractEquations(Matrix<Integer>);
+   /// The dimension computation as it was done before: cross-multiplication of rows
+   /// followed by a gcd normalization of the modified row.
+   template <typename Integer>
+   std::size_t referenceDimension(Matrix<Integer>);
+   /// Runs both implementations and prints the timings.
+   template <typename Integer>
+   void run(const char*, const Matrix<Integer>&, int);
+}
+
+int main(int argc, char** argv)
+try
+{
+   char default_file[] = "../samples/panda_format/bell/3333";
+   char* arguments[] = {argv[0], (argc > 1) ? argv[1] : default_file};
+   const auto vertices = std::get<0>(input::vertices<int>(2, arguments));
+   std::cout << "vertices: " << vertices.size() << ", dimension: " << vertices.front().size() << '\n';
+   run("int", vertices, 20);
+   #ifndef NO_FLEXIBILITY
+   run("int64_t", cast<int64_t>(vertices), 20);
+   run("BigInteger", cast<BigInteger>(vertices), 1);
+   #endif
+}
+catch ( const std::exception& e )
+{
+   std::cerr << e.what() << '\n';
+   return EXIT_FAILURE;
+}
+
+namespace
+{
+   template <typename Integer>
+   void normalizeColumn(Matrix<Integer>& matrix, const std::size_t column)
+   {
+      Integer gcd_val(0);
+      for ( const auto& row : matrix )
+      {
+         gcd_val = algorithm::gcd(gcd_val, row[column]);
+      }
+      if ( gcd_val > 1 )
+      {
+         for ( auto& row : matrix )
+         {
+            row[column] /= gcd_val;
+         }
+      }
+   }
+
+   template <typename Integer>
+   Equations<Integer> referenceExtractEquations(Matrix<Integer> matrix)
+   {
+      const auto original_size = matrix.size();
+      algorithm::appendNegativeIdentityMatrix(matrix);
+      const auto row_size = matrix.size();
+      const auto col_size = matrix.back().size();
+      Indices equation_indices;
+      std::vector<std::size_t> used_columns;
+      for ( std::size_t row = 0; row < row_size; ++row )
+      {
+         std::size_t col = col_size;
+         for ( ; row < row_size; ++row )
+         {
+            for ( col = 0; col < col_size; ++col )
+            {
+               if ( matrix[row][col] != 0 && std::find(used_columns.cbegin(), used_columns.cend(), col) == used_columns.cend() )
+               {
+                  break;
+               }
+            }
+            if ( col < col_size )
+            {
+               break;
+            }
+         }
+         if ( row == row_size )
+         {
+            break;
+         }
+         used_columns.push_back(col);
+         if ( row >= original_size )
+         {
+            equation_indices.push_back(col);
+         }
+         for ( std::size_t i = 0; i < col_size; ++i )
+         {
+            const auto b = matrix[row][i];
+            if ( i != col && b != 0 )
+            {
+               const auto a = -matrix[row][col];
+               for ( auto& r : matrix )
+               {
+                  r[i] = Integer(r[i] * a + r[col] * b);
+               }
+               normalizeColumn(matrix, i);
+            }
+         }
+      }
+      for ( std::size_t col = 0; col < col_size; ++col )
+      {
+         const auto& pivot_row = *std::find_if(matrix.cbegin(), matrix.cend(), [col](const Row<Integer>& r) { return r[col] != 0; });
+         if ( pivot_row[col] < 0 )
+         {
+            for ( auto& r : matrix )
+            {
+               r[col] *= Integer(-1);
+            }
+         }
+      }
+      matrix.erase(matrix.begin(), matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(original_size));
+      matrix = algorithm::transpose(matrix);
+      std::sort(equation_indices.rbegin(), equation_indices.rend());
+      return algorithm::extractEquations(matrix, equation_indices);
+   }
+
+   template <typename Integer>
+   std::size_t referenceDimension(Matrix<Integer> matrix)
+   {
+      std::vector<std::size_t> pivot_columns;
+      for ( std::size_t i = 0; i < matrix.size(); ++i )
+      {
+         auto& row = matrix[i];
+         for ( std::size_t j = 0; j < i; ++j )
+         {
+            const auto piv_col = pivot_columns[j];
+            if ( row[piv_col] != 0 )
+            {
+               const auto factor = row[piv_col];
+               row *= Integer(-matrix[j][piv_col]);
+               row += factor * matrix[j];
+               algorithm::divideByGcd(row);
+            }
+         }
+         const auto nz_entry = std::find_if(row.cbegin(), row.cend(), [](const Integer& a) { return a != 0; });
+         if ( nz_entry == row.cend() )
+         {
+            matrix.erase(matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(i));
+            --i;
+         }
+         else
+         {
+            pivot_columns.push_back(static_cast<std::size_t>(nz_entry - row.cbegin()));
+         }
+      }
+      return pivot_columns.size();
+   }
+
+   template <typename Integer>
+   void run(const char* type_name, const Matrix<Integer>& vertices, const int repetitions)
+   {
+      using Clock = std::chrono::steady_clock;
+      const auto seconds = [repetitions](const Clock::duration duration)
+      {
+         return std::chrono::duration<double>(duration).count() / repetitions;
+      };
+      const auto measure = [&](const auto& function)
+      {
+         const auto start = Clock::now();
+         for ( int i = 1; i < repetitions; ++i )
+         {
+            function(vertices);
+         }
+         const auto result = function(vertices);
+         return std::make_pair(result, seconds(Clock::now() - start));
+      };
+      const auto reference_equations = measure(referenceExtractEquations<Integer>);
+      const auto new_equations = measure([](const Matrix<Integer>& m) { return algorithm::extractEquations(m); });
+      const auto reference_dimension = measure(referenceDimension<Integer>);
+      const auto new_dimension = measure([](const Matrix<Integer>& m) { return algorithm::dimension(m); });
+      if ( reference_equations.first != new_equations.first || reference_dimension.first != new_dimension.first )
+      {
+         throw std::logic_error("Results differ.");
+      }
+      std::cout << std::fixed << std::setprecision(4)
+                << std::setw(10) << type_name
+                << "   equations: " << reference_equations.second << " s -> " << new_equations.second << " s"
+                << "   dimension: " << reference_dimension.second << " s -> " << new_dimension.second << " s\n";
+   }
+}
+
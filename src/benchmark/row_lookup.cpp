@@ -0,0 +1,112 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Benchmark of the lookup of map images among the input rows, as done at startup for the
+/// validity check of the maps and for the row permutations of the symmetry group.
+/// Compares the linear search (std::find per image) with the hashed row index.
+/// Usage: benchmark_row_lookup [file...] (default: ../samples/panda_format/bell/3344)
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "algorithm_map_operations.h"
+#include "concurrency.h"
+#include "input.h"
+#include "matrix.h"
+#include "row_index.h"
+
+using namespace panda;
+
+namespace
+{
+   /// The lookup as it was done before: std::find for the image of each row under each map.
+   std::vector<std::vector<std::size_t>> linearImages(const Maps&, const Matrix<int>&);
+   /// Runs both lookups on the vertices and maps of a file and prints timings and memory.
+   void run(char*, char*);
+}
+
+int main(int argc, char** argv)
+try
+{
+   char default_file[] = "../samples/panda_format/bell/3344";
+   if ( argc < 2 )
+   {
+      run(argv[0], default_file);
+   }
+   for ( int i = 1; i < argc; ++i )
+   {
+      run(argv[0], argv[i]);
+   }
+}
+catch ( const std::exception& e )
+{
+   std::cerr << e.what() << '\n';
+   return EXIT_FAILURE;
+}
+
+namespace
+{
+   std::vector<std::vector<std::size_t>> linearImages(const Maps& maps, const Matrix<int>& rows)
+   {
+      std::vector<std::vector<std::size_t>> result;
+      for ( const auto& map : maps )
+      {
+         std::vector<std::size_t> positions;
+         for ( const auto& row : rows )
+         {
+            const auto image = algorithm::apply(map, row, tag::vertex{});
+            const auto it = std::find(rows.cbegin(), rows.cend(), image);
+            positions.push_back((it == rows.cend()) ? RowIndex<int>::npos : static_cast<std::size_t>(it - rows.cbegin()));
+         }
+         result.push_back(positions);
+      }
+      return result;
+   }
+
+   void run(char* program, char* file)
+   {
+      char* arguments[] = {program, file};
+      const auto input = input::vertices<int>(2, arguments);
+      const auto& vertices = std::get<0>(input);
+      const auto& maps = std::get<2>(input);
+      if ( vertices.empty() || maps.empty() )
+      {
+         throw std::invalid_argument("The benchmark requires vertices and maps.");
+      }
+      using Clock = std::chrono::steady_clock;
+      auto start = Clock::now();
+      const auto reference = linearImages(maps, vertices);
+      const auto linear_time = Clock::now() - start;
+      start = Clock::now();
+      const auto result = algorithm::images(maps, vertices, tag::vertex{}, concurrency::numberOfThreads(2, arguments));
+      const auto hashed_time = Clock::now() - start;
+      if ( reference != result )
+      {
+         throw std::logic_error("Lookups differ.");
+      }
+      const auto milliseconds = [](const Clock::duration duration)
+      {
+         return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) / 1000.0;
+      };
+      const RowIndex<int> index(vertices);
+      const auto matrix_bytes = vertices.size() * (sizeof(Row<int>) + vertices.front().size() * sizeof(int));
+      std::cout << file << ": " << vertices.size() << " rows, dimension " << vertices.front().size() << ", " << maps.size() << " maps\n"
+                << std::fixed << std::setprecision(2)
+                << "   linear search: " << std::setw(10) << milliseconds(linear_time) << " ms\n"
+                << "   hashed index:  " << std::setw(10) << milliseconds(hashed_time) << " ms"
+                << "   (speedup " << milliseconds(linear_time) / milliseconds(hashed_time) << ")\n"
+                << "   index memory:  " << std::setw(10) << index.memoryUsage() / 1024.0 << " KiB"
+                << "   (rows: " << matrix_bytes / 1024.0 << " KiB)\n";
+   }
+}
+
@@ -0,0 +1,189 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Benchmark of the row content normalization (division of a row by the gcd of its entries).
+/// The rows are built like the intermediate rows of a rotation step: from facets of a Bell
+/// polytope (found by the Fourier-Motzkin heuristic) and their distances to its vertices.
+/// Usage: benchmark_row_normalization [file] (default: ../samples/panda_format/bell/3333)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+#include "algorithm_fourier_motzkin_elimination.h"
+#include "algorithm_inequality_operations.h"
+#include "algorithm_integer_operations.h"
+#include "algorithm_row_operations.h"
+#include "cast.h"
+#include "input.h"
+#include "matrix.h"
+#include "row.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Euclid's algorithm, as it was used for all integer types before.
+   template <typename Integer>
+   Integer euclideanGcd(Integer, Integer) noexcept;
+   /// The normalization as it was done before: Euclid's algorithm folded over the row.
+   template <typename Integer>
+   void referenceNormalization(Row<Integer>&);
+   /// Creates rows "d_f * ridge - d_r * facet" from pairs of facets and a vertex.
+   Matrix<int> createRows(const Matrix<int>&, std::size_t);
+   /// Runs both normalizations on copies of the rows and prints the timings.
+   template <typename Integer>
+   void run(const char*, const Matrix<Integer>&);
+}
+
+int main(int argc, char** argv)
+try
+{
+   char default_file[] = "../samples/panda_format/bell/3333";
+   char* arguments[] = {argv[0], (argc > 1) ? argv[1] : default_file};
+   const auto vertices = std::get<0>(input::vertices<int>(2, arguments));
+   const std::size_t number_of_rows = 5000;
+   const auto rows = createRows(vertices, number_of_rows);
+   std::cout << "rows: " << rows.size() << ", dimension: " << rows.front().size() << '\n';
+   run("int", rows);
+   #ifndef NO_FLEXIBILITY
+   run("int64_t", cast<int64_t>(rows));
+   #endif
+}
+catch ( const std::exception& e )
+{
+   std::cerr << e.what() << '\n';
+   return EXIT_FAILURE;
+}
+
+namespace
+{
+   template <typename Integer>
+   #if defined(__GNUC__) || defined(__clang__)
+   __attribute__((noinline)) // like the library function it stands for.
+   #endif
+   Integer euclideanGcd(Integer a, Integer b) noexcept
+   {
+      a = (a < 0) ? static_cast<Integer>(-a) : a;
+      b = (b < 0) ? static_cast<Integer>(-b) : b;
+      while ( a != 0 && b != 0 )
+      {
+         if ( a > b )
+         {
+            a %= b;
+         }
+         else
+         {
+            b %= a;
+         }
+      }
+      return (a == 0) ? b : a;
+   }
+
+   template <typename Integer>
+   void referenceNormalization(Row<Integer>& row)
+   {
+      Integer value(0);
+      std::size_t i{0};
+      for ( ; i < row.size() && row[i] == 0; ++i )
+      {
+      }
+      if ( i < row.size() )
+      {
+         value = (row[i] < 0) ? static_cast<Integer>(-row[i]) : row[i];
+         ++i;
+      }
+      for ( ; i < row.size() && value > 1; ++i )
+      {
+         value = euclideanGcd(row[i], value);
+      }
+      if ( value > 1 )
+      {
+         row /= value;
+      }
+   }
+
+   Matrix<int> createRows(const Matrix<int>& vertices, const std::size_t number_of_rows)
+   {
+      const auto facets = algorithm::fourierMotzkinEliminationHeuristic(vertices);
+      if ( facets.size() < 2 )
+      {
+         throw std::invalid_argument("The benchmark requires at least two facets.");
+      }
+      std::mt19937 generator{42};
+      std::uniform_int_distribution<std::size_t> facet_index(0, facets.size() - 1);
+      std::uniform_int_distribution<std::size_t> vertex_index(0, vertices.size() - 1);
+      Matrix<int> rows;
+      rows.reserve(number_of_rows);
+      while ( rows.size() < number_of_rows )
+      {
+         const auto& facet = facets[facet_index(generator)];
+         const auto& ridge = facets[facet_index(generator)];
+         const auto& vertex = vertices[vertex_index(generator)];
+         const auto d_f = algorithm::distance(facet, vertex);
+         const auto d_r = algorithm::distance(ridge, vertex);
+         if ( d_f == 0 && d_r == 0 )
+         {
+            continue;
+         }
+         const auto gcd_ds = algorithm::gcd(d_f, d_r);
+         rows.push_back((d_f / gcd_ds) * ridge - (d_r / gcd_ds) * facet);
+      }
+      return rows;
+   }
+
+   template <typename Integer>
+   void run(const char* type_name, const Matrix<Integer>& rows)
+   {
+      // the rows are few enough to stay in cache, like the rows of a rotation.
+      using Clock = std::chrono::steady_clock;
+      const int repetitions = 40;
+      Matrix<Integer> reference_rows;
+      Clock::duration reference_time{0};
+      for ( int i = 0; i < repetitions; ++i )
+      {
+         reference_rows = rows;
+         const auto start = Clock::now();
+         for ( auto& row : reference_rows )
+         {
+            referenceNormalization(row);
+         }
+         reference_time += Clock::now() - start;
+      }
+      Matrix<Integer> new_rows;
+      Clock::duration new_time{0};
+      for ( int i = 0; i < repetitions; ++i )
+      {
+         new_rows = rows;
+         const auto start = Clock::now();
+         for ( auto& row : new_rows )
+         {
+            algorithm::divideByGcd(row);
+         }
+         new_time += Clock::now() - start;
+      }
+      if ( reference_rows != new_rows )
+      {
+         throw std::logic_error("Normalizations differ.");
+      }
+      const auto nanoseconds = [&rows](const Clock::duration duration)
+      {
+         return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / static_cast<double>(rows.size() * repetitions);
+      };
+      std::cout << std::fixed << std::setprecision(1)
+                << std::setw(8) << type_name
+                << "   euclid: " << std::setw(7) << nanoseconds(reference_time) << " ns/row"
+                << "   binary: " << std::setw(7) << nanoseconds(new_time) << " ns/row"
+                << "   speedup: " << std::setprecision(2) << nanoseconds(reference_time) / nanoseconds(new_time) << '\n';
+   }
+}
+
@@ -0,0 +1,101 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Benchmark of the distance computations of a rotation (nearest vertex, vertices on a face)
+/// on the row-wise vertex matrix versus the padded vertices with a fixed-width kernel.
+/// Usage: benchmark_vertex_distances [file] (default: ../samples/panda_format/bell/3333)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+#include "algorithm_fourier_motzkin_elimination.h"
+#include "algorithm_inequality_operations.h"
+#include "cast.h"
+#include "incidence.h"
+#include "input.h"
+#include "matrix.h"
+#include "padded_vertices.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Runs both variants on all given inequalities and prints the timings.
+   template <typename Integer>
+   void run(const char*, const Vertices<Integer>&, const Inequalities<Integer>&);
+}
+
+int main(int argc, char** argv)
+try
+{
+   char default_file[] = "../samples/panda_format/bell/3333";
+   char* arguments[] = {argv[0], (argc > 1) ? argv[1] : default_file};
+   const auto vertices = std::get<0>(input::vertices<int>(2, arguments));
+   const auto facets = algorithm::fourierMotzkinEliminationHeuristic(vertices);
+   std::cout << "vertices: " << vertices.size() << ", dimension: " << vertices.front().size()
+             << ", padded width: " << PaddedVertices<int>(vertices).width() << ", inequalities: " << facets.size() << '\n';
+   run("int", vertices, facets);
+   #ifndef NO_FLEXIBILITY
+   run("int64_t", cast<int64_t>(vertices), cast<int64_t>(facets));
+   #endif
+}
+catch ( const std::exception& e )
+{
+   std::cerr << e.what() << '\n';
+   return EXIT_FAILURE;
+}
+
+namespace
+{
+   template <typename Integer>
+   void run(const char* type_name, const Vertices<Integer>& vertices, const Inequalities<Integer>& inequalities)
+   {
+      using Clock = std::chrono::steady_clock;
+      const int repetitions = 200;
+      const Incidence<Integer> incidence(vertices);
+      Vertices<Integer> reference_result;
+      auto start = Clock::now();
+      for ( int i = 0; i < repetitions; ++i )
+      {
+         reference_result.clear();
+         for ( const auto& inequality : inequalities )
+         {
+            reference_result.push_back(algorithm::nearestVertex(vertices, inequality));
+         }
+      }
+      const auto reference_time = Clock::now() - start;
+      Vertices<Integer> new_result;
+      start = Clock::now();
+      for ( int i = 0; i < repetitions; ++i )
+      {
+         new_result.clear();
+         for ( const auto& inequality : inequalities )
+         {
+            new_result.push_back(incidence.nearestVertex(inequality));
+         }
+      }
+      const auto new_time = Clock::now() - start;
+      if ( reference_result != new_result )
+      {
+         throw std::logic_error("Results differ.");
+      }
+      const auto nanoseconds = [&](const Clock::duration duration)
+      {
+         return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / static_cast<double>(repetitions * inequalities.size() * vertices.size());
+      };
+      std::cout << std::fixed << std::setprecision(2)
+                << std::setw(8) << type_name
+                << "   rows: " << std::setw(6) << nanoseconds(reference_time) << " ns/distance"
+                << "   padded: " << std::setw(6) << nanoseconds(new_time) << " ns/distance"
+                << "   speedup: " << nanoseconds(reference_time) / nanoseconds(new_time) << '\n';
+   }
+}
+
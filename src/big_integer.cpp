@@ -12,6 +12,8 @@
 #include <limits>
 #include <stdexcept>
 
+#include "modular_arithmetic.h"
+
 using namespace panda;
 
 BigInteger& panda::BigInteger::operator<<=(const std::size_t distance)
@@ -80,6 +82,35 @@ BigInteger panda::BigInteger::operator-() const
    return result;
 }
 
+uint64_t panda::BigInteger::residue() const noexcept
+{
+   static_assert(std::numeric_limits<DataType>::digits <= 64, "The blocks have to fit into uint64_t.");
+   uint64_t value = 0;
+   for ( auto it = data.crbegin(); it != data.crend(); ++it )
+   {
+      // Horner's scheme on the blocks, most significant block first.
+      value = modular::multiplyByPowerOfTwo(value, std::numeric_limits<DataType>::digits);
+      value = modular::add(value, modular::reduce(static_cast<uint64_t>(*it)));
+   }
+   return isNegative() ? modular::negate(value) : value;
+}
+
+std::vector<uint64_t> panda::BigInteger::limbs() const
+{
+   constexpr auto digits = std::numeric_limits<DataType>::digits;
+   static_assert(64 % digits == 0, "The blocks have to tile the limbs.");
+   std::vector<uint64_t> result((data.size() * digits + 63) / 64, 0);
+   for ( std::size_t i = 0; i < data.size(); ++i )
+   {
+      result[i * digits / 64] |= static_cast<uint64_t>(data[i]) << (i * digits % 64);
+   }
+   while ( result.size() > 1 && result.back() == 0 )
+   {
+      result.pop_back();
+   }
+   return result;
+}
+
 BigInteger panda::abs(BigInteger input) noexcept
 {
    input.sign = BigInteger::Sign::Positive;
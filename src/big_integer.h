@@ -47,6 +47,9 @@ namespace panda
          /// Constructor from uint64_t.
          explicit BigInteger(const uint64_t);
          #endif
+         /// Constructor from the sign (true for negative numbers) and the magnitude as
+         /// 64-bit limbs, least significant limb first (see limbs).
+         BigInteger(const bool, const std::vector<uint64_t>&);
          /// Conversion to int.
          operator int() const;
          /// Comparison "equals" with integer.
@@ -95,6 +98,11 @@ namespace panda
          BigInteger operator%(const BigInteger&) const;
          /// Negation (-a).
          BigInteger operator-() const;
+         /// Residue modulo the prime of modular_arithmetic.h.
+         uint64_t residue() const noexcept;
+         /// Magnitude as 64-bit limbs, least significant limb first. Independent of the
+         /// block size of the platform, hence suitable for transmissions.
+         std::vector<uint64_t> limbs() const;
          /// Absolute value.
          friend BigInteger abs(BigInteger) noexcept;
       private:
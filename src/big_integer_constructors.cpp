@@ -21,6 +21,27 @@ BigInteger::BigInteger()
 {
 }
 
+panda::BigInteger::BigInteger(const bool negative, const std::vector<uint64_t>& limbs)
+:
+   sign(negative ? Sign::Negative : Sign::Positive),
+   data()
+{
+   constexpr auto digits = std::numeric_limits<DataType>::digits;
+   static_assert(64 % digits == 0, "The blocks have to tile the limbs.");
+   for ( const auto limb : limbs )
+   {
+      for ( int shift = 0; shift < 64; shift += digits )
+      {
+         data.push_back(static_cast<DataType>(limb >> shift));
+      }
+   }
+   if ( data.empty() )
+   {
+      data.push_back(0);
+   }
+   shrinkToFit();
+}
+
 #ifdef INT16_MAX
 panda::BigInteger::BigInteger(const int16_t value)
 :
@@ -0,0 +1,17 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+namespace panda
+{
+   /// returns the greatest common divisor of two unsigned integers (binary gcd algorithm).
+   template <typename Unsigned>
+   inline Unsigned binaryGcd(Unsigned, Unsigned) noexcept;
+}
+
+#include "binary_gcd.tpp"
+
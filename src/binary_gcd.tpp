@@ -0,0 +1,45 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Stein's algorithm replaces the divisions of Euclid's algorithm by subtractions and shifts.
+/// Counting the trailing zeros strips all factors of two at once, and the swap compiles to
+/// conditional moves, so the loop has a single (well predictable) branch.
+
+#include <type_traits>
+#include <utility>
+
+#include "count_trailing_zeros.h"
+
+namespace panda
+{
+   template <typename Unsigned>
+   Unsigned binaryGcd(Unsigned a, Unsigned b) noexcept
+   {
+      static_assert(std::is_unsigned<Unsigned>::value, "binaryGcd expects an unsigned type.");
+      if ( a == 0 )
+      {
+         return b;
+      }
+      if ( b == 0 )
+      {
+         return a;
+      }
+      const auto shift = countTrailingZeros(static_cast<Unsigned>(a | b));
+      a = static_cast<Unsigned>(a >> countTrailingZeros(a));
+      do
+      {
+         b = static_cast<Unsigned>(b >> countTrailingZeros(b));
+         if ( a > b )
+         {
+            std::swap(a, b);
+         }
+         b = static_cast<Unsigned>(b - a);
+      }
+      while ( b != 0 );
+      return static_cast<Unsigned>(a << shift);
+   }
+}
+
@@ -74,6 +74,14 @@ void panda::BitsetFixedSize<Size>::set(const std::size_t index) noexcept
    data[index / std::numeric_limits<DataType>::digits] |= mask;
 }
 
+template <std::size_t Size>
+bool panda::BitsetFixedSize<Size>::test(const std::size_t index) const noexcept
+{
+   const auto mask = static_cast<DataType>(1u) << (index % std::numeric_limits<DataType>::digits);
+   assert(index / std::numeric_limits<DataType>::digits < Size );
+   return (data[index / std::numeric_limits<DataType>::digits] & mask) != 0;
+}
+
 template <std::size_t Size>
 std::size_t panda::BitsetFixedSize<Size>::unionCount(const BitsetFixedSize<Size>& a, const BitsetFixedSize<Size>& b, const std::size_t max) noexcept
 {
@@ -71,6 +71,13 @@ void panda::BitsetVariableSize::set(const std::size_t index) noexcept
    data[index / std::numeric_limits<DataType>::digits] |= mask;
 }
 
+bool panda::BitsetVariableSize::test(const std::size_t index) const noexcept
+{
+   const DataType mask = static_cast<DataType>(1u) << (index % std::numeric_limits<DataType>::digits);
+   assert(index / std::numeric_limits<DataType>::digits < data.size() );
+   return (data[index / std::numeric_limits<DataType>::digits] & mask) != 0;
+}
+
 std::size_t panda::BitsetVariableSize::unionCount(const BitsetVariableSize& a, const BitsetVariableSize& b, const std::size_t max) noexcept
 {
    std::size_t total{0};
@@ -0,0 +1,42 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "buffer_pool.h"
+
+#include <utility>
+
+using namespace panda;
+
+panda::BufferPool::BufferPool(const std::size_t capacity_)
+:
+   capacity(capacity_),
+   mutex(),
+   buffers()
+{
+   buffers.reserve(capacity);
+}
+
+BufferPool::Buffer panda::BufferPool::acquire()
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   if ( buffers.empty() )
+   {
+      return Buffer{};
+   }
+   auto buffer = std::move(buffers.back());
+   buffers.pop_back();
+   return buffer;
+}
+
+void panda::BufferPool::release(Buffer&& buffer)
+{
+   buffer.clear();
+   std::lock_guard<std::mutex> lock(mutex);
+   if ( buffers.size() < capacity && buffer.capacity() > 0 )
+   {
+      buffers.push_back(std::move(buffer));
+   }
+}
+
@@ -0,0 +1,32 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace panda
+{
+   /// Byte buffers for transmissions, shared between threads. Released buffers keep their
+   /// capacity, such that packing and receiving messages of similar size doesn't allocate.
+   class BufferPool
+   {
+      public:
+         using Buffer = std::vector<char>;
+         /// Constructor: argument denotes the maximal number of buffers kept.
+         explicit BufferPool(std::size_t);
+         /// Returns an empty buffer, reusing a released one if possible.
+         Buffer acquire();
+         /// Returns a buffer to the pool.
+         void release(Buffer&&);
+      private:
+         const std::size_t capacity;
+         std::mutex mutex;
+         std::vector<Buffer> buffers;
+   };
+}
+
@@ -0,0 +1,28 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstdint>
+
+#include <gmpxx.h>
+
+namespace panda
+{
+   /// Statistics of the classes of a list, collected with a vertex group only. In the
+   /// distributed mode, they are summed up over the nodes (see DistributedJobManager).
+   struct ClassStatistics
+   {
+      /// number of classes.
+      std::uint64_t classes;
+      /// sum of the orbit sizes of the classes.
+      mpz_class orbit_sizes;
+      /// lookups of the canonical form cache.
+      std::uint64_t lookups;
+      /// hits of the canonical form cache.
+      std::uint64_t hits;
+   };
+}
+
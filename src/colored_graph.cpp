@@ -0,0 +1,266 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "colored_graph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+using namespace panda;
+
+namespace
+{
+   /// Mixes the bits of a value (finalizer of splitmix64).
+   uint64_t mix(uint64_t) noexcept;
+   /// Returns the index of the first cell with more than one vertex (or the number of cells).
+   std::size_t firstNonSingleton(const std::vector<std::vector<std::size_t>>&) noexcept;
+   /// Returns the representative of the orbit of a vertex (union-find with path halving).
+   std::size_t find(std::vector<std::size_t>&, std::size_t) noexcept;
+}
+
+panda::ColoredGraph::ColoredGraph(const std::size_t n, std::vector<Color> pair_colors)
+:
+   number_of_vertices(n),
+   colors(std::move(pair_colors))
+{
+   if ( colors.size() != n * n )
+   {
+      throw std::invalid_argument("A colored graph needs a color for each pair of vertices.");
+   }
+}
+
+std::size_t panda::ColoredGraph::size() const noexcept
+{
+   return number_of_vertices;
+}
+
+ColoredGraph::Color panda::ColoredGraph::color(const std::size_t i, const std::size_t j) const noexcept
+{
+   assert( i < number_of_vertices && j < number_of_vertices );
+   return colors[i * number_of_vertices + j];
+}
+
+bool panda::ColoredGraph::isAutomorphism(const Permutation& permutation) const noexcept
+{
+   assert( permutation.size() == number_of_vertices );
+   for ( std::size_t i = 0; i < number_of_vertices; ++i )
+   {
+      for ( std::size_t j = 0; j < number_of_vertices; ++j )
+      {
+         if ( color(permutation[i], permutation[j]) != color(i, j) )
+         {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+std::vector<ColoredGraph::Permutation> panda::ColoredGraph::automorphisms() const
+{
+   if ( number_of_vertices < 2 )
+   {
+      return {};
+   }
+   // the root partition groups the vertices by their colors.
+   std::map<Color, std::vector<std::size_t>> vertex_colors;
+   for ( std::size_t i = 0; i < number_of_vertices; ++i )
+   {
+      vertex_colors[color(i, i)].push_back(i);
+   }
+   Node root;
+   for ( auto& cell : vertex_colors )
+   {
+      root.partition.push_back(std::move(cell.second));
+   }
+   refine(root, std::vector<char>(root.partition.size(), 1));
+   // the first path individualizes the smallest vertex of the first non-trivial cell.
+   std::vector<Node> path{root};
+   std::vector<std::size_t> targets;
+   std::vector<std::size_t> chosen;
+   for ( auto target = firstNonSingleton(root.partition); target < path.back().partition.size(); target = firstNonSingleton(path.back().partition) )
+   {
+      targets.push_back(target);
+      chosen.push_back(path.back().partition[target].front());
+      path.push_back(individualize(path.back(), target, chosen.back()));
+   }
+   std::vector<std::size_t> first_leaf;
+   for ( const auto& cell : path.back().partition )
+   {
+      first_leaf.push_back(cell.front());
+   }
+   // bottom-up: at each level, the orbit of the chosen vertex under the stabilizer of the
+   // vertices chosen above it is completed by searching the subtrees of the other vertices.
+   std::vector<Permutation> generators;
+   std::vector<std::size_t> orbits(number_of_vertices);
+   std::iota(orbits.begin(), orbits.end(), 0);
+   for ( std::size_t level = targets.size(); level-- > 0; )
+   {
+      std::vector<std::size_t> failed;
+      for ( const auto vertex : path[level].partition[targets[level]] )
+      {
+         const auto orbit = find(orbits, vertex);
+         if ( orbit == find(orbits, chosen[level]) ||
+              std::any_of(failed.cbegin(), failed.cend(), [&](const std::size_t f) { return find(orbits, f) == orbit; }) )
+         {
+            continue;
+         }
+         Permutation generator;
+         if ( search(individualize(path[level], targets[level], vertex), level + 1, path, first_leaf, generator) )
+         {
+            for ( std::size_t i = 0; i < number_of_vertices; ++i )
+            {
+               orbits[find(orbits, i)] = find(orbits, generator[i]);
+            }
+            generators.push_back(std::move(generator));
+         }
+         else
+         {
+            failed.push_back(vertex);
+         }
+      }
+   }
+   return generators;
+}
+
+void panda::ColoredGraph::refine(Node& node, std::vector<char> pending) const
+{
+   auto& cells = node.partition;
+   assert( pending.size() == cells.size() );
+   std::vector<uint64_t> keys(number_of_vertices);
+   for ( auto splitter_index = std::find(pending.begin(), pending.end(), 1); splitter_index != pending.end(); splitter_index = std::find(pending.begin(), pending.end(), 1) )
+   {
+      *splitter_index = 0;
+      const auto s = static_cast<std::size_t>(splitter_index - pending.begin());
+      const auto splitter = cells[s];
+      for ( std::size_t c = 0; c < cells.size(); ++c )
+      {
+         if ( cells[c].size() == 1 )
+         {
+            continue;
+         }
+         auto cell = cells[c];
+         // the key of a vertex is a fingerprint of the multiset of its colors towards the splitter.
+         for ( const auto vertex : cell )
+         {
+            uint64_t key{0};
+            for ( const auto other : splitter )
+            {
+               key += mix(color(vertex, other));
+            }
+            keys[vertex] = key;
+         }
+         if ( std::all_of(cell.cbegin(), cell.cend(), [&](const std::size_t v) { return keys[v] == keys[cell.front()]; }) )
+         {
+            continue;
+         }
+         std::sort(cell.begin(), cell.end(), [&](const std::size_t a, const std::size_t b)
+         {
+            return std::make_pair(keys[a], a) < std::make_pair(keys[b], b);
+         });
+         std::vector<std::vector<std::size_t>> parts;
+         for ( const auto vertex : cell )
+         {
+            if ( parts.empty() || keys[vertex] != keys[parts.back().front()] )
+            {
+               parts.emplace_back();
+               node.trace = mix(node.trace ^ (keys[vertex] + s * number_of_vertices + c));
+            }
+            parts.back().push_back(vertex);
+         }
+         for ( auto& part : parts )
+         {
+            std::sort(part.begin(), part.end());
+         }
+         const auto position = static_cast<std::ptrdiff_t>(c);
+         cells.erase(cells.begin() + position);
+         cells.insert(cells.begin() + position, parts.begin(), parts.end());
+         pending.erase(pending.begin() + position);
+         pending.insert(pending.begin() + position, parts.size(), 1);
+         c += parts.size() - 1;
+      }
+   }
+}
+
+ColoredGraph::Node panda::ColoredGraph::individualize(const Node& node, const std::size_t target, const std::size_t vertex) const
+{
+   Node child{node.partition, 0};
+   auto& cell = child.partition[target];
+   cell.erase(std::find(cell.begin(), cell.end(), vertex));
+   const auto position = static_cast<std::ptrdiff_t>(target);
+   child.partition.insert(child.partition.begin() + position, std::vector<std::size_t>{vertex});
+   // the partition was equitable, hence the new singleton is the only splitter needed.
+   std::vector<char> pending(child.partition.size(), 0);
+   pending[target] = 1;
+   refine(child, std::move(pending));
+   return child;
+}
+
+bool panda::ColoredGraph::search(const Node& node, const std::size_t depth, const std::vector<Node>& path, const std::vector<std::size_t>& first_leaf, Permutation& result) const
+{
+   assert( depth < path.size() );
+   const auto& reference = path[depth];
+   if ( node.trace != reference.trace || node.partition.size() != reference.partition.size() )
+   {
+      return false;
+   }
+   for ( std::size_t i = 0; i < node.partition.size(); ++i )
+   {
+      if ( node.partition[i].size() != reference.partition[i].size() )
+      {
+         return false;
+      }
+   }
+   const auto target = firstNonSingleton(node.partition);
+   if ( target == node.partition.size() )
+   {
+      result.assign(number_of_vertices, 0);
+      for ( std::size_t i = 0; i < number_of_vertices; ++i )
+      {
+         result[first_leaf[i]] = node.partition[i].front();
+      }
+      return isAutomorphism(result);
+   }
+   for ( const auto vertex : node.partition[target] )
+   {
+      if ( search(individualize(node, target, vertex), depth + 1, path, first_leaf, result) )
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+namespace
+{
+   uint64_t mix(uint64_t value) noexcept
+   {
+      value += 0x9e3779b97f4a7c15ull;
+      value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+      value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+      return value ^ (value >> 31);
+   }
+
+   std::size_t firstNonSingleton(const std::vector<std::vector<std::size_t>>& partition) noexcept
+   {
+      const auto it = std::find_if(partition.cbegin(), partition.cend(), [](const std::vector<std::size_t>& cell) { return cell.size() > 1; });
+      return static_cast<std::size_t>(it - partition.cbegin());
+   }
+
+   std::size_t find(std::vector<std::size_t>& parents, std::size_t vertex) noexcept
+   {
+      while ( parents[vertex] != vertex )
+      {
+         parents[vertex] = parents[parents[vertex]];
+         vertex = parents[vertex];
+      }
+      return vertex;
+   }
+}
+
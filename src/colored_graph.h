@@ -0,0 +1,57 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace panda
+{
+   /// Complete graph whose (ordered) vertex pairs carry colors, the color of (i, i) is the
+   /// color of vertex i. Automorphisms are the vertex permutations that preserve all colors.
+   /// They are found by individualization and refinement of ordered partitions, as in
+   /// canonical labeling: every subtree of the search tree, whose refined partitions match
+   /// those of the first path, is searched for a leaf that maps the first leaf by an automorphism.
+   class ColoredGraph
+   {
+      public:
+         /// Type of the colors.
+         using Color = uint32_t;
+         /// Permutation of the vertices, the image of i is at position i.
+         using Permutation = std::vector<std::size_t>;
+         /// Constructor: number of vertices and the colors of all pairs (row by row).
+         ColoredGraph(std::size_t, std::vector<Color>);
+         /// Returns the number of vertices.
+         std::size_t size() const noexcept;
+         /// Returns the color of the pair (i, j).
+         Color color(std::size_t, std::size_t) const noexcept;
+         /// Checks if the permutation preserves all colors.
+         bool isAutomorphism(const Permutation&) const noexcept;
+         /// Returns generators of the automorphism group (none if it is trivial).
+         std::vector<Permutation> automorphisms() const;
+      private:
+         /// Ordered partition of the vertices.
+         using Partition = std::vector<std::vector<std::size_t>>;
+         /// Refined partition at a node of the search tree, with a fingerprint of the refinement.
+         struct Node
+         {
+            Partition partition{};
+            uint64_t trace{0};
+         };
+         std::size_t number_of_vertices;
+         std::vector<Color> colors;
+      private:
+         /// Refines the partition until it is equitable, starting with the pending cells as splitters.
+         void refine(Node&, std::vector<char>) const;
+         /// Separates a vertex from the other vertices of the given cell and refines the partition.
+         Node individualize(const Node&, std::size_t, std::size_t) const;
+         /// Searches the subtree of a node (at the given depth) for a leaf that is the image of
+         /// the first leaf under an automorphism, the nodes of the first path are the reference.
+         bool search(const Node&, std::size_t, const std::vector<Node>&, const std::vector<std::size_t>&, Permutation&) const;
+   };
+}
+
@@ -1,4 +1,3 @@
-
 //-------------------------------------------------------------------------------//
 // Author: Stefan Lörwald, Universität Heidelberg                                //
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
@@ -8,218 +7,178 @@
 #include "communication.h"
 #undef COMPILE_TEMPLATE_COMMUNICATION
 
-#ifdef MPI_SUPPORT
-
-#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <future>
 #include <stdexcept>
-#include <thread>
+#include <tuple>
+#include <utility>
 #include <vector>
 
-#include "cast.h"
 #include "communication.h"
-#include "mpi_no_warnings.h"
+#include "local_processes.h"
+#include "matrix_serialization.h"
+#include "message_passing_interface_progress_engine.h"
 
 using namespace panda;
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-
 namespace
 {
    using Tag = int;
-   using Bytes = int;
    namespace tag
    {
-      constexpr static int matrix = 0;
-      constexpr static int row = 1;
+      constexpr static int results = 0;
+      constexpr static int jobs = 1;
+      constexpr static int rows = 2;
+      constexpr static int token = 3;
    }
-   constexpr static int Master = 0;
-   /// Send transmission to ID with Tag of Bytes from buffer.
-   template <typename Pointer>
-   MPI_Request send(Pointer, const Bytes, const int, const Tag) noexcept;
-   /// Receive transmission with Tag of Bytes into buffer from ID.
-   template <typename Pointer>
-   void receive(Pointer, const Bytes, const int, const Tag);
-   /// Returns true if there is a matching incoming transmission.
-   bool isMatchingIncomingTransmissionAvailable(const int, const Tag) noexcept;
-   /// Occasionally tests for completion of request, returns on success.
-   void waitForCompletion(std::mutex&, MPI_Request) noexcept;
-   /// Allow other threads to acquire lock.
-   void pause();
+   /// Waits for the sent message until the deadline, returns false if it isn't sent by then
+   /// or couldn't be sent at all.
+   bool wait(std::future<void>&&, const Communication::Deadline&);
+   /// Sends a matrix, supports and a number (e.g. the lease) to ID with Tag in one message.
+   /// The future is ready once it is sent.
+   template <typename Integer>
+   std::future<void> sendMatrix(const Matrix<Integer>&, const std::vector<Support>&, const std::size_t, const int, const Tag);
+   /// Receives a matrix and its number from ID with Tag, the supports are stored in the
+   /// third argument (std::nullopt if it didn't arrive before the deadline).
+   template <typename Integer>
+   std::optional<std::pair<Matrix<Integer>, std::size_t>> receiveMatrix(const int, const Tag, std::vector<Support>&, const Communication::Deadline& = std::nullopt);
 }
 
 template <typename Integer>
-void panda::Communication::toMaster(const Matrix<Integer>& matrix) const
+void panda::Communication::toMaster(const Matrix<Integer>& matrix, const std::vector<Support>& supports, const std::size_t lease, const int master) const
 {
-   toMaster(cast<int>(matrix));
+   // the engine owns the message, hence the next jobs are computed while it is sent.
+   sendMatrix(matrix, supports, lease, master, tag::results);
 }
 
 template <typename Integer>
-Matrix<Integer> panda::Communication::fromSlave(const int id) const
+std::optional<Communication::Results<Integer>> panda::Communication::fromSlave(const int id, const Deadline& deadline) const
 {
-   return cast<Integer>(fromSlave<int>(id));
+   Results<Integer> results{};
+   auto received = receiveMatrix<Integer>(id, tag::results, results.supports, deadline);
+   if ( !received )
+   {
+      return std::nullopt;
+   }
+   std::tie(results.rows, results.lease) = std::move(*received);
+   return results;
 }
 
 template <typename Integer>
-void panda::Communication::toSlave(const Row<Integer>& row, const int id) const
+bool panda::Communication::toSlave(const Matrix<Integer>& jobs, const std::size_t lease, const int id, const Deadline& deadline) const
 {
-   toSlave(cast<int>(row), id);
+   // the engine owns the message, hence it may still be sent after the deadline.
+   return wait(sendMatrix(jobs, std::vector<Support>{}, lease, id, tag::jobs), deadline);
 }
 
 template <typename Integer>
-Row<Integer> panda::Communication::fromMaster() const
+std::pair<Matrix<Integer>, std::size_t> panda::Communication::fromMaster(const int master) const
 {
-   return cast<Integer>(fromMaster<int>());
+   std::vector<Support> supports;
+   return *receiveMatrix<Integer>(master, tag::jobs, supports);
 }
 
-/// It needs to be asserted that no Recv blocks a Send and vice versa if
-/// the sending / receiving side isn't ready. Therefore, Probe is used to
-/// assert the presence of an incoming message. Send instructions are
-/// wrapped by an additional mutex. MPI send instructions are itself
-/// non-blocking (Isend). But the send_mutex is only unlocked after the
-/// Isend has actually transferred the data.
+void panda::Communication::abandon(const int id) const
+{
+   mpi::getProgressEngine().abandon(id);
+   local::abandon(id);
+}
 
-template <>
-void panda::Communication::toMaster(const Matrix<int>& matrix) const
+template <typename Integer>
+void panda::Communication::toNode(const Matrix<Integer>& matrix, const std::vector<Support>& supports, const int id) const
 {
-   std::vector<MPI_Request> requests;
-   requests.reserve(2 + matrix.size());
-   { // post sends, scoped because we only hold the lock for as long the MPI calls last.
-      std::lock_guard<std::mutex> lock(mutex);
-      const auto size = matrix.size();
-      const auto row_size = matrix.back().size();
-      requests.emplace_back(send(&size, sizeof(decltype(size)), Master, tag::matrix));
-      requests.emplace_back(send(&row_size, sizeof(decltype(row_size)), Master, tag::matrix));
-      for ( const auto& row : matrix )
-      {
-         const auto bytes = static_cast<int>(row_size * sizeof(int));
-         requests.emplace_back(send(&row.front(), bytes, Master, tag::matrix));
-      }
-   }
-   // wait for completion of all of the requests
-   for ( auto& request : requests )
-   {
-      waitForCompletion(mutex, request);
-   }
+   // there is no lease in the distributed mode, a lost message would be waited for forever.
+   sendMatrix(matrix, supports, 0, id, tag::rows).get();
 }
 
-template <>
-Matrix<int> panda::Communication::fromSlave(const int id) const
+template <typename Integer>
+Communication::Results<Integer> panda::Communication::fromAnyNode() const
 {
-   for ( ; true; pause() ) // look for matching transmission, but pause to let others acquire lock.
-   {
-      std::lock_guard<std::mutex> lock(mutex);
-      if ( isMatchingIncomingTransmissionAvailable(id, tag::matrix) )
-      {
-         std::size_t size;
-         std::size_t row_size;
-         receive(&size, sizeof(decltype(size)), id, tag::matrix);
-         receive(&row_size, sizeof(decltype(row_size)), id, tag::matrix);
-         Matrix<int> matrix(size);
-         for ( auto& row : matrix )
-         {
-            row.resize(row_size);
-            const auto bytes = static_cast<int>(row_size * sizeof(int));
-            receive(&row.front(), bytes, id, tag::matrix);
-         }
-         return matrix;
-      }
-   }
+   Results<Integer> results{};
+   std::tie(results.rows, results.lease) = *receiveMatrix<Integer>(mpi::ProgressEngine::any_source, tag::rows, results.supports);
+   return results;
 }
 
-template <>
-void panda::Communication::toSlave<int>(const Row<int>& row, const int id) const
+void panda::Communication::tokenToNode(const Token& token, const int id) const
 {
-   MPI_Request request;
-   {
-      std::lock_guard<std::mutex> lock(mutex);
-      const auto begin = row.empty() ? nullptr : &row.front();
-      const auto bytes = static_cast<int>(row.size() * sizeof(int));
-      request = send(begin, bytes, id, tag::row);
-   }
-   waitForCompletion(mutex, request);
+   auto& engine = mpi::getProgressEngine();
+   auto buffer = engine.acquire();
+   // the numbers and the flags, followed by the sum of the orbit sizes in decimal digits.
+   const std::uint64_t numbers[] = {static_cast<std::uint64_t>(token.count), token.statistics.classes, token.statistics.lookups, token.statistics.hits};
+   const auto orbit_sizes = token.statistics.orbit_sizes.get_str();
+   buffer.resize(sizeof(numbers) + 1 + orbit_sizes.size());
+   std::memcpy(buffer.data(), numbers, sizeof(numbers));
+   buffer[sizeof(numbers)] = static_cast<char>((token.black ? 1 : 0) | (token.terminate ? 2 : 0));
+   std::memcpy(buffer.data() + sizeof(numbers) + 1, orbit_sizes.data(), orbit_sizes.size());
+   engine.send(std::move(buffer), id, tag::token).get();
 }
 
-template <>
-Row<int> panda::Communication::fromMaster<int>() const
+Communication::Token panda::Communication::tokenFromNode(const int id) const
 {
-   for ( ; true; pause() ) // look for matching transmission, but pause to let others acquire lock.
+   auto& engine = mpi::getProgressEngine();
+   auto buffer = engine.receive(id, tag::token).get();
+   std::uint64_t numbers[4];
+   if ( buffer.size() <= sizeof(numbers) + 1 )
    {
-      std::lock_guard<std::mutex> lock(mutex);
-      if ( isMatchingIncomingTransmissionAvailable(Master, tag::row) )
-      {
-         MPI_Status status;
-         MPI_Probe(Master, tag::row, MPI_COMM_WORLD, &status);
-         int count;
-         MPI_Get_count(&status, MPI_BYTE, &count);
-         const auto row_size = static_cast<std::size_t>(count) / sizeof(int);
-         Row<int> row(row_size);
-         const auto begin = row.empty() ? nullptr : &row.front();
-         const auto bytes = static_cast<int>(row.size() * sizeof(int));
-         receive(begin, bytes, Master, tag::row);
-         return row;
-      }
+      throw std::invalid_argument("Bad number of bytes received.");
    }
+   std::memcpy(numbers, buffer.data(), sizeof(numbers));
+   Token token{};
+   token.count = static_cast<std::int64_t>(numbers[0]);
+   token.statistics.classes = numbers[1];
+   token.statistics.lookups = numbers[2];
+   token.statistics.hits = numbers[3];
+   token.black = (buffer[sizeof(numbers)] & 1) != 0;
+   token.terminate = (buffer[sizeof(numbers)] & 2) != 0;
+   token.statistics.orbit_sizes.set_str(std::string(buffer.data() + sizeof(numbers) + 1, buffer.size() - sizeof(numbers) - 1), 10);
+   engine.release(std::move(buffer));
+   return token;
 }
 
 namespace
 {
-   template <typename Pointer>
-   MPI_Request send(Pointer data, const Bytes bytes, const int id, const Tag tag) noexcept
+   bool wait(std::future<void>&& future, const Communication::Deadline& deadline)
    {
-      MPI_Request request;
-      void* buffer = const_cast<void*>(reinterpret_cast<const void*>(data));
-      MPI_Isend(buffer, bytes, MPI_BYTE, id, tag, MPI_COMM_WORLD, &request);
-      return request;
-   }
-
-   template <typename Pointer>
-   void receive(Pointer data, const Bytes bytes, const int id, const Tag tag)
-   {
-      MPI_Status status;
-      MPI_Recv(data, bytes, MPI_BYTE, id, tag, MPI_COMM_WORLD, &status);
-      int count;
-      MPI_Get_count(&status, MPI_BYTE, &count);
-      if ( count != static_cast<int>(bytes) )
+      if ( deadline && future.wait_until(*deadline) != std::future_status::ready )
       {
-         throw std::invalid_argument("Bad number of bytes received.");
+         return false;
+      }
+      try
+      {
+         future.get();
+         return true;
+      }
+      catch ( const std::runtime_error& )
+      {
+         return false;
       }
    }
 
-   bool isMatchingIncomingTransmissionAvailable(const int id, const Tag tag) noexcept
+   template <typename Integer>
+   std::future<void> sendMatrix(const Matrix<Integer>& matrix, const std::vector<Support>& supports, const std::size_t number, const int id, const Tag tag)
    {
-      int flag;
-      MPI_Status status;
-      MPI_Iprobe(id, tag, MPI_COMM_WORLD, &flag, &status);
-      return flag;
+      auto& engine = mpi::getProgressEngine();
+      auto buffer = engine.acquire();
+      serialization::pack(matrix, supports, number, buffer);
+      return engine.send(std::move(buffer), id, tag);
    }
 
-   void waitForCompletion(std::mutex& mutex, MPI_Request request) noexcept
+   template <typename Integer>
+   std::optional<std::pair<Matrix<Integer>, std::size_t>> receiveMatrix(const int id, const Tag tag, std::vector<Support>& supports, const Communication::Deadline& deadline)
    {
-      for ( ; true; pause() )
+      auto& engine = mpi::getProgressEngine();
+      // a receive that times out is withdrawn, hence a late message goes to the next caller.
+      auto buffer = deadline ? engine.receive(id, tag, *deadline) : std::make_optional(engine.receive(id, tag).get());
+      if ( !buffer )
       {
-         std::lock_guard<std::mutex> lock(mutex);
-         int flag;
-         MPI_Status status;
-         MPI_Test(&request, &flag, &status);
-         if ( flag )
-         {
-            break;
-         }
+         return std::nullopt;
       }
-   }
-
-   void pause()
-   {
-      #if __GNUC__ > 4 || (__GNUC__ == 4 && (__GNUC_MINOR__ > 7))
-      std::this_thread::yield();
-      #endif
-      std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+      auto result = serialization::unpack<Integer>(*buffer, supports);
+      engine.release(std::move(*buffer));
+      return result;
    }
 }
 
-#pragma GCC diagnostic pop
-
-#endif // MPI_SUPPORT
-
@@ -6,46 +6,86 @@
 
 #pragma once
 
-#include <mutex>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
 
+#include "class_statistics.h"
 #include "matrix.h"
 #include "row.h"
+#include "support.h"
 
 namespace panda
 {
    class Communication
    {
       public:
-         /// Sending a facet to slave.
+         /// Results of a batch of jobs sent from a slave to the master.
          template <typename Integer>
-         void toSlave(const Row<Integer>&, const int) const;
-         /// Receiving a facet from master.
+         struct Results
+         {
+            /// the rows found.
+            Matrix<Integer> rows;
+            /// the canonical supports of the rows (empty if there is no vertex group).
+            std::vector<Support> supports;
+            /// the lease of the batch (see JobManager), zero for rows sent between nodes.
+            std::size_t lease;
+         };
+         /// Point in time after which waiting for a slave is given up (std::nullopt: never).
+         using Deadline = std::optional<std::chrono::steady_clock::time_point>;
+         /// Token of the termination detection in the distributed mode (see DistributedJobManager).
+         struct Token
+         {
+            /// sum of the message counters of the nodes visited.
+            std::int64_t count;
+            /// set if a visited node received a message since the previous visit.
+            bool black;
+            /// set once termination has been detected.
+            bool terminate;
+            /// on the terminating wave: the statistics of the classes of the nodes visited.
+            ClassStatistics statistics;
+         };
+         /// Sending a batch of jobs and its lease to slave. An empty batch makes the slave stop.
+         /// Returns false if the batch wasn't sent before the deadline or the send failed.
          template <typename Integer>
-         Row<Integer> fromMaster() const;
-         /// Sending facets back to the master.
+         bool toSlave(const Matrix<Integer>&, const std::size_t, const int, const Deadline&) const;
+         /// Receiving a batch of jobs and its lease from master (the master or a sub-master).
          template <typename Integer>
-         void toMaster(const Matrix<Integer>&) const;
-         /// Receiving facets from slave.
+         std::pair<Matrix<Integer>, std::size_t> fromMaster(const int) const;
+         /// Sending the results of a batch of jobs back to master (the master or a sub-master):
+         /// the rows, their canonical supports (may be empty) and the lease of the batch.
+         /// Returns at once, the message is sent in the background.
          template <typename Integer>
-         Matrix<Integer> fromSlave(const int) const;
+         void toMaster(const Matrix<Integer>&, const std::vector<Support>&, const std::size_t, const int) const;
+         /// Receiving the results of a batch of jobs from slave (std::nullopt if they didn't
+         /// arrive before the deadline).
+         template <typename Integer>
+         std::optional<Results<Integer>> fromSlave(const int, const Deadline&) const;
+         /// Gives up on a node that missed a deadline: messages to it no longer keep this
+         /// process from ending.
+         void abandon(const int) const;
+         /// Sending rows and their canonical supports to the node that owns them (distributed
+         /// mode). An empty matrix tells the node that no more rows will follow. Throws
+         /// std::runtime_error if the send failed.
+         template <typename Integer>
+         void toNode(const Matrix<Integer>&, const std::vector<Support>&, const int) const;
+         /// Receiving rows and their canonical supports from any node (distributed mode).
+         template <typename Integer>
+         Results<Integer> fromAnyNode() const;
+         /// Passing the token of the termination detection on to the node. Throws
+         /// std::runtime_error if the send failed.
+         void tokenToNode(const Token&, const int) const;
+         /// Receiving the token of the termination detection from the node.
+         Token tokenFromNode(const int) const;
          #pragma GCC diagnostic push
          #pragma GCC diagnostic ignored "-Weffc++"
          /// Default constructor.
          Communication() = default;
          #pragma GCC diagnostic pop
-      private:
-         mutable std::mutex mutex;
    };
-
-   template <>
-   void Communication::toMaster<int>(const Matrix<int>&) const;
-   template <>
-   Matrix<int> Communication::fromSlave<int>(const int) const;
-
-   template <>
-   void Communication::toSlave<int>(const Row<int>&, const int) const;
-   template <>
-   Row<int> Communication::fromMaster<int>() const;
 }
 
 #include "communication.eti"
@@ -0,0 +1,134 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_COMPILED_MAP
+#include "compiled_map.h"
+#undef COMPILE_TEMPLATE_COMPILED_MAP
+
+#include <cassert>
+#include <limits>
+
+using namespace panda;
+
+namespace
+{
+   /// Returns true if the image is a single term with factor +1 or -1.
+   bool isSignedUnit(const Image&, std::size_t) noexcept;
+}
+
+std::optional<CompiledMap> panda::CompiledMap::create(const Map& map, tag::facet)
+{
+   // the term (j, f) in the image of coordinate i adds f * row[i] to the j^th entry of the image.
+   CompiledMap compiled(map.size());
+   for ( std::size_t i = 0; i < map.size(); ++i )
+   {
+      if ( map[i].empty() )
+      {
+         compiled.dropped.push_back(static_cast<std::uint32_t>(i));
+         continue;
+      }
+      if ( !isSignedUnit(map[i], map.size()) )
+      {
+         return std::nullopt;
+      }
+      const auto target = map[i].front().first;
+      if ( compiled.signs[target] != 0 )
+      {
+         return std::nullopt;
+      }
+      compiled.sources[target] = static_cast<std::uint32_t>(i);
+      compiled.signs[target] = static_cast<std::int8_t>(map[i].front().second);
+   }
+   return compiled;
+}
+
+std::optional<CompiledMap> panda::CompiledMap::create(const Map& map, tag::vertex)
+{
+   // the term (j, f) in the image of coordinate i adds f * row[j] to the i^th entry of the image.
+   CompiledMap compiled(map.size());
+   std::vector<bool> hit(map.size(), false);
+   for ( std::size_t i = 0; i < map.size(); ++i )
+   {
+      if ( map[i].empty() )
+      {
+         continue;
+      }
+      if ( !isSignedUnit(map[i], map.size()) )
+      {
+         return std::nullopt;
+      }
+      const auto source = map[i].front().first;
+      if ( hit[source] )
+      {
+         return std::nullopt;
+      }
+      hit[source] = true;
+      compiled.sources[i] = static_cast<std::uint32_t>(source);
+      compiled.signs[i] = static_cast<std::int8_t>(map[i].front().second);
+   }
+   for ( std::size_t j = 0; j < map.size(); ++j )
+   {
+      if ( !hit[j] )
+      {
+         compiled.dropped.push_back(static_cast<std::uint32_t>(j));
+      }
+   }
+   return compiled;
+}
+
+std::size_t panda::CompiledMap::size() const noexcept
+{
+   return sources.size();
+}
+
+template <typename Integer>
+bool panda::CompiledMap::apply(const Row<Integer>& row, Row<Integer>& image) const
+{
+   assert( row.size() == size() && image.size() == size() );
+   for ( const auto index : dropped )
+   {
+      if ( row[index] != 0 )
+      {
+         return false;
+      }
+   }
+   for ( std::size_t i = 0; i < sources.size(); ++i )
+   {
+      const auto& value = row[sources[i]];
+      if ( signs[i] > 0 )
+      {
+         image[i] = value;
+      }
+      else if ( signs[i] < 0 )
+      {
+         image[i] = static_cast<Integer>(-value);
+      }
+      else
+      {
+         image[i] = Integer(0);
+      }
+   }
+   return true;
+}
+
+panda::CompiledMap::CompiledMap(const std::size_t size)
+:
+   sources(size, 0),
+   signs(size, 0),
+   dropped()
+{
+   assert( size <= std::numeric_limits<std::uint32_t>::max() );
+}
+
+namespace
+{
+   bool isSignedUnit(const Image& image, const std::size_t size) noexcept
+   {
+      return ( image.size() == 1 &&
+               image.front().first < size &&
+               (image.front().second == 1 || image.front().second == -1) );
+   }
+}
+
@@ -0,0 +1,47 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "maps.h"
+#include "row.h"
+#include "tags.h"
+
+namespace panda
+{
+   /// Map that is a signed permutation of the coordinates, compiled into flat arrays.
+   /// The image of a row is a gather of its entries with signs, no allocation is needed.
+   /// Coordinates with empty images (eliminated by equations) are dropped.
+   class CompiledMap
+   {
+      public:
+         /// Returns the compiled map for facets or std::nullopt if the map is no signed permutation.
+         static std::optional<CompiledMap> create(const Map&, tag::facet);
+         /// Returns the compiled map for vertices or std::nullopt if the map is no signed permutation.
+         static std::optional<CompiledMap> create(const Map&, tag::vertex);
+         /// Returns the number of coordinates.
+         std::size_t size() const noexcept;
+         /// Writes the image of the row into the second row, which has to be of the same size.
+         /// Returns false (the second row is unspecified) if the row has a non-zero entry at a
+         /// dropped coordinate. The image equals algorithm::apply for rows whose gcd is 1.
+         template <typename Integer>
+         bool apply(const Row<Integer>&, Row<Integer>&) const;
+      private:
+         explicit CompiledMap(std::size_t);
+      private:
+         /// the i^th entry of the image is signs[i] * row[sources[i]].
+         std::vector<std::uint32_t> sources;
+         std::vector<std::int8_t> signs;
+         std::vector<std::uint32_t> dropped;
+   };
+}
+
+#include "compiled_map.eti"
+
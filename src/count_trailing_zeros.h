@@ -0,0 +1,17 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+namespace panda
+{
+   /// returns the number of trailing zero bits of a non-zero unsigned integer.
+   template <typename Unsigned>
+   inline int countTrailingZeros(Unsigned) noexcept;
+}
+
+#include "count_trailing_zeros.tpp"
+
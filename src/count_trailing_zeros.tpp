@@ -0,0 +1,38 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Like popcount, counting trailing zeros is a single instruction on most machines.
+/// GCC and CLANG expose it as a builtin, any other compiler gets a simple loop.
+
+#include <cassert>
+#include <type_traits>
+
+namespace panda
+{
+   #if defined(__GNUC__) || defined(__clang__)
+      template <typename Unsigned>
+      int countTrailingZeros(const Unsigned n) noexcept
+      {
+         static_assert(std::is_unsigned<Unsigned>::value && sizeof(Unsigned) <= sizeof(unsigned long long), "`__builtin_ctzll` expects an `unsigned long long`.");
+         assert( n != 0 );
+         return __builtin_ctzll(static_cast<unsigned long long>(n));
+      }
+   #else
+      template <typename Unsigned>
+      int countTrailingZeros(Unsigned n) noexcept
+      {
+         static_assert(std::is_unsigned<Unsigned>::value, "countTrailingZeros expects an unsigned type.");
+         assert( n != 0 );
+         int count = 0;
+         for ( ; (n & 1u) == 0; n >>= 1 )
+         {
+            ++count;
+         }
+         return count;
+      }
+   #endif
+}
+
@@ -0,0 +1,239 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_DISTRIBUTED_JOB_MANAGER
+#include "distributed_job_manager.h"
+#undef COMPILE_TEMPLATE_DISTRIBUTED_JOB_MANAGER
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "message_passing_interface_session.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Maximal number of raw supports whose canonical forms are kept.
+   constexpr std::size_t canonical_forms_capacity = std::size_t{1} << 16;
+   /// Adds the second statistics to the first.
+   void add(ClassStatistics&, const ClassStatistics&);
+}
+
+template <typename Integer, typename TagType>
+void panda::DistributedJobManager<Integer, TagType>::put(const Matrix<Integer>& matrix) const
+{
+   distribute(matrix, 1);
+}
+
+template <typename Integer, typename TagType>
+void panda::DistributedJobManager<Integer, TagType>::put(const Row<Integer>& row) const
+{
+   distribute(Matrix<Integer>{row}, 0);
+}
+
+template <typename Integer, typename TagType>
+Row<Integer> panda::DistributedJobManager<Integer, TagType>::get() const
+{
+   return rows.get();
+}
+
+template <typename Integer, typename TagType>
+panda::DistributedJobManager<Integer, TagType>::DistributedJobManager(const Names& names_, const int number_of_processors, const int, const std::optional<VertexGroup>& vertex_group_, const Matrix<Integer>& vertices_, const std::optional<std::chrono::seconds>&, std::size_t, int)
+:
+   communication(),
+   rank(mpi::getSession().getRank()),
+   size(number_of_processors),
+   vertex_group(vertex_group_),
+   vertices(vertices_),
+   incidence(vertices),
+   canonical_forms(vertex_group_ ? canonical_forms_capacity : 1),
+   rows(names_, vertex_group_, vertices_),
+   mutex(),
+   counter(0),
+   black(false),
+   threads() // vital implementation detail: threads may access other members, hence, the threads must be destroyed first (Destruction in reverse order of construction).
+{
+   assert( number_of_processors > 0 );
+   assert( rank < size );
+   if ( size > 1 )
+   {
+      rows.hold();
+      // the statistics are summed up over the nodes by the terminating wave.
+      rows.withholdStatistics();
+   }
+   if ( rank != 0 ) // only the master adds initial rows, this ends the initial phase elsewhere.
+   {
+      rows.put(Matrix<Integer>{});
+   }
+   if ( size > 1 )
+   {
+      threads.emplace_front([this]() { receive(); });
+      threads.emplace_front([this]() { detectTermination(); });
+   }
+}
+
+template <typename Integer, typename TagType>
+void panda::DistributedJobManager<Integer, TagType>::distribute(const Matrix<Integer>& matrix, const std::size_t jobs) const
+{
+   // the supports determine the owners, the canonical supports are sent along.
+   std::vector<Support> supports;
+   if ( vertex_group || size > 1 )
+   {
+      supports.reserve(matrix.size());
+      for ( const auto& row : matrix )
+      {
+         supports.push_back(incidence.supportBitset(row));
+      }
+   }
+   if ( vertex_group )
+   {
+      canonical_forms.canonicalize(*vertex_group, supports);
+   }
+   if ( size == 1 )
+   {
+      rows.put(matrix, std::move(supports), jobs);
+      return;
+   }
+   std::vector<Matrix<Integer>> owned(static_cast<std::size_t>(size));
+   std::vector<std::vector<Support>> owned_supports(static_cast<std::size_t>(size));
+   for ( std::size_t i = 0; i < matrix.size(); ++i )
+   {
+      const auto owner = supports[i].hash() % static_cast<std::size_t>(size);
+      owned[owner].push_back(matrix[i]);
+      owned_supports[owner].push_back(std::move(supports[i]));
+   }
+   // rows that aren't found by a job may arrive while this node is idle, hence they are
+   // treated like received rows.
+   std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+   if ( jobs == 0 )
+   {
+      lock.lock();
+      black = true;
+   }
+   for ( int node = 0; node < size; ++node )
+   {
+      const auto index = static_cast<std::size_t>(node);
+      if ( node == rank || owned[index].empty() )
+      {
+         continue;
+      }
+      // counted before sending, such that the node isn't idle until the message is counted.
+      counter.fetch_add(1);
+      communication.toNode(owned[index], vertex_group ? owned_supports[index] : std::vector<Support>{}, node);
+   }
+   const auto own = static_cast<std::size_t>(rank);
+   rows.put(owned[own], std::move(owned_supports[own]), jobs);
+}
+
+template <typename Integer, typename TagType>
+void panda::DistributedJobManager<Integer, TagType>::receive() const
+{
+   // every other node says goodbye with an empty message once the end is detected.
+   int goodbyes = 0;
+   while ( goodbyes < size - 1 )
+   {
+      auto results = communication.fromAnyNode<Integer>();
+      if ( results.rows.empty() )
+      {
+         ++goodbyes;
+         continue;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      rows.put(results.rows, std::move(results.supports), 0);
+      counter.fetch_sub(1);
+      black = true;
+   }
+}
+
+template <typename Integer, typename TagType>
+void panda::DistributedJobManager<Integer, TagType>::detectTermination() const
+{
+   const auto next = (rank + 1) % size;
+   const auto previous = (rank + size - 1) % size;
+   if ( rank == 0 )
+   {
+      while ( true )
+      {
+         // a wave starts on the idle master, which is whitened. Its counter is added at the end.
+         visit(Communication::Token{});
+         communication.tokenToNode(Communication::Token{}, next);
+         const auto token = visit(communication.tokenFromNode(previous));
+         if ( !token.black && token.count == 0 )
+         {
+            break;
+         }
+      }
+      communication.tokenToNode(Communication::Token{0, false, true, ClassStatistics{}}, next);
+      // the wave has summed up the statistics of the other nodes, which are final now.
+      auto sum = communication.tokenFromNode(previous).statistics;
+      add(sum, statistics());
+      rows.report(sum);
+   }
+   else
+   {
+      while ( true )
+      {
+         auto token = communication.tokenFromNode(previous);
+         if ( token.terminate )
+         {
+            add(token.statistics, statistics());
+            communication.tokenToNode(token, next);
+            break;
+         }
+         communication.tokenToNode(visit(token), next);
+      }
+   }
+   // no rows are in flight, hence the goodbye is the last message to each node.
+   for ( int node = 0; node < size; ++node )
+   {
+      if ( node != rank )
+      {
+         communication.toNode(Matrix<Integer>{}, std::vector<Support>{}, node);
+      }
+   }
+   rows.release();
+}
+
+template <typename Integer, typename TagType>
+ClassStatistics panda::DistributedJobManager<Integer, TagType>::statistics() const
+{
+   // the canonical supports are computed here before the rows are sent to their owners.
+   auto own = rows.statistics();
+   own.lookups += canonical_forms.lookups();
+   own.hits += canonical_forms.hits();
+   return own;
+}
+
+template <typename Integer, typename TagType>
+Communication::Token panda::DistributedJobManager<Integer, TagType>::visit(Communication::Token token) const
+{
+   while ( true )
+   {
+      rows.waitUntilIdle();
+      std::lock_guard<std::mutex> lock(mutex);
+      if ( rows.idle() ) // rows may have been received in the meantime.
+      {
+         token.count += counter.load();
+         token.black = token.black || black;
+         black = false;
+         return token;
+      }
+   }
+}
+
+namespace
+{
+   void add(ClassStatistics& sum, const ClassStatistics& statistics)
+   {
+      sum.classes += statistics.classes;
+      sum.orbit_sizes += statistics.orbit_sizes;
+      sum.lookups += statistics.lookups;
+      sum.hits += statistics.hits;
+   }
+}
+
@@ -0,0 +1,98 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+
+#include "communication.h"
+#include "incidence.h"
+#include "joining_thread.h"
+#include "list.h"
+#include "matrix.h"
+#include "names.h"
+#include "row.h"
+#include "support_cache.h"
+#include "tags.h"
+#include "vertex_group.h"
+
+namespace panda
+{
+   /// Job manager of the distributed mode ("--distributed"), used on every node. Each class
+   /// is owned by the node given by the hash of its canonical support (of its support if
+   /// there is no vertex group). The owner deduplicates and queues its classes, hence the
+   /// memory for the classes and the deduplication are shared by all nodes. The rows found
+   /// on a node are sent to their owners.
+   /// The end is detected with Safra's algorithm: a token travels along the ring of nodes
+   /// and sums up the number of messages sent minus received on each idle node. A node that
+   /// received a message since the last visit colors the token black. Once the token returns
+   /// white with a sum of zero, no message is in flight and all nodes are idle. A last wave
+   /// tells the nodes to end and sums up their statistics, which the master reports.
+   template <typename Integer, typename TagType>
+   class DistributedJobManager
+   {
+      public:
+         /// Sends the rows found by a job to their owners.
+         void put(const Matrix<Integer>&) const;
+         /// Sends a row to its owner (not the result of a job, e.g. known output).
+         void put(const Row<Integer>&) const;
+         /// Returns a job owned by this node. Blocks the caller until data is available.
+         /// An empty row signals that all nodes are done.
+         Row<Integer> get() const;
+         /// Constructor. The first argument are the names of indices
+         /// (only relevant for printing inequalities).
+         /// The second argument must be the number of processors,
+         /// the third argument (number of threads per processor) is ignored, as are the
+         /// lease duration, the prefetch depth and the number of sub-masters (there are no slaves).
+         DistributedJobManager(const Names&, const int, const int, const std::optional<VertexGroup>& vertex_group = std::nullopt, const Matrix<Integer>& vertices = Matrix<Integer>{}, const std::optional<std::chrono::seconds>& = std::nullopt, std::size_t = 1, int = 0);
+      private:
+         /// Sends the rows to their owners and merges those owned by this node. The second
+         /// argument is the number of jobs that are done with it.
+         void distribute(const Matrix<Integer>&, std::size_t) const;
+         /// Loop of the thread that merges the rows sent by the other nodes.
+         void receive() const;
+         /// Loop of the thread that passes the token on, until the end is detected.
+         void detectTermination() const;
+         /// Waits until this node is idle, then adds its counter and color to the token
+         /// and whitens the node.
+         Communication::Token visit(Communication::Token) const;
+         /// Returns the statistics of the classes owned by this node and of its canonical
+         /// form cache.
+         ClassStatistics statistics() const;
+      private:
+         Communication communication;
+         const int rank;
+         const int size;
+         const std::optional<VertexGroup> vertex_group;
+         const Matrix<Integer> vertices;
+         const Incidence<Integer> incidence;
+         /// canonical forms of raw supports computed before (only used with a vertex group).
+         mutable SupportCache canonical_forms;
+         /// the classes owned by this node.
+         mutable List<Integer, TagType> rows;
+         /// makes merging received rows atomic with respect to a visit of the token.
+         mutable std::mutex mutex;
+         /// number of messages sent minus number of messages received.
+         mutable std::atomic<std::int64_t> counter;
+         /// set if rows were received since the last visit of the token.
+         mutable bool black;
+         /// vital implementation detail: threads may access other members, hence, the threads must be destroyed first.
+         mutable std::list<JoiningThread> threads;
+      private:
+         /// Copy construction is not allowed.
+         DistributedJobManager(const DistributedJobManager<Integer, TagType>&) = delete;
+         /// Copy assignment is not allowed.
+         DistributedJobManager<Integer, TagType>& operator=(const DistributedJobManager<Integer, TagType>&) = delete;
+   };
+}
+
+#include "distributed_job_manager.eti"
+
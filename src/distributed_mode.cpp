@@ -0,0 +1,25 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "distributed_mode.h"
+
+#include <cassert>
+#include <cstring>
+
+using namespace panda;
+
+bool panda::distribution::enabled(int argc, char** argv)
+{
+   assert( argc > 0 && argv != nullptr );
+   for ( int i = 1; i < argc; ++i )
+   {
+      if ( std::strcmp(argv[i], "--distributed") == 0 )
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
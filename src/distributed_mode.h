@@ -0,0 +1,17 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+namespace panda
+{
+   namespace distribution
+   {
+      /// Returns whether the classes are to be stored distributed over all nodes
+      /// ("--distributed"), instead of on the master only.
+      bool enabled(int, char**);
+   }
+}
+
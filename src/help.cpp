@@ -207,6 +207,92 @@ namespace
                 << "\t./" << project::binary_name << " myproblem -r 3 --sampling\n";
    }
 
+   void printHelpCommandDetectSymmetry()
+   {
+      std::cout << "Adjacency decomposition only has to process one facet / vertex per class of equivalent ones.\n"
+                << "The classes are given by the maps or the vertex permutations of the input file.\n"
+                << "If neither is given, or if they don't generate the full symmetry group, the symmetry group may be detected instead:\n"
+                << "the group of all permutations of the input rows that are induced by a linear map.\n"
+                << "For vertices, the rows are homogenized, hence this includes all affine symmetries of the polytope.\n"
+                << "The order of the detected group is printed. Vertex permutations given in the input file take precedence.\n\n"
+                << "Use \"--detect-symmetry\" to enable the detection.\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem --detect-symmetry\n";
+   }
+
+   void printHelpCommandExpand()
+   {
+      std::cout << "With maps or vertex permutations, the output only contains one facet / vertex per class of equivalent ones.\n"
+                << "Such a reduced output can be expanded to all facets / vertices afterwards.\n"
+                << "The input file has to be the one that was used for the enumeration, the classes are expanded with its symmetries\n"
+                << "(or with the detected symmetries, if \"--detect-symmetry\" is given as well).\n"
+                << "The classes are expanded in parallel and the rows are written as they are generated, without keeping them in memory.\n\n"
+                << "Use \"--expand=<path/to/reduced/output>\".\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem > reduced_output\n"
+                << "\t./" << project::binary_name << " myproblem --expand=reduced_output\n";
+   }
+
+   void printHelpCommandDistributed()
+   {
+      std::cout << "With MPI, all classes are stored on the master node by default, which limits the problem size to the memory of one node.\n"
+                << "In the distributed mode, each class is owned by the node given by a hash of its canonical support.\n"
+                << "Each node deduplicates, stores and processes the classes it owns, and sends the classes it finds to their owners.\n"
+                << "The end of the computation is detected by passing a token along the ring of nodes.\n"
+                << "Each node writes the classes it owns, hence the order of the output differs between runs.\n\n"
+                << "Use \"--distributed\" to enable the distributed mode.\n"
+                << "Example usage:\n"
+                << "\tmpirun -np 4 ./" << project::binary_name << " myproblem --distributed\n";
+   }
+
+   void printHelpCommandLease()
+   {
+      std::cout << "With MPI or local processes, the master hands out batches of jobs to the slaves.\n"
+                << "Each batch is a lease: if the slave doesn't return the results in time, the master gives up on that slave\n"
+                << "and hands the jobs of all its leases out again. Results that arrive late only add rows, which are deduplicated.\n"
+                << "A failed or preempted node then costs its current jobs only, instead of the whole run.\n"
+                << "The deadline has to be longer than the longest job, by default there is none.\n\n"
+                << "Use \"--lease=<seconds>\" with a positive integral parameter.\n"
+                << "Example usage:\n"
+                << "\tmpirun -np 4 ./" << project::binary_name << " myproblem --lease=3600\n";
+   }
+
+   void printHelpCommandPrefetch()
+   {
+      std::cout << "With MPI or local processes, the master sends batches of jobs to the threads of the slaves.\n"
+                << "Further batches are sent ahead, such that a slave thread doesn't wait for its next batch\n"
+                << "while the results of the previous one are uploaded. At the end, every node reports the\n"
+                << "fraction of the time its threads waited for jobs.\n"
+                << "More batches ahead hide longer latencies, but the jobs wait longer at the slave (mind \"--lease\").\n\n"
+                << "Use \"--prefetch=<n>\" with a non-negative integral parameter (default: 1, 0 disables it).\n"
+                << "Example usage:\n"
+                << "\tmpirun -np 4 ./" << project::binary_name << " myproblem --prefetch=2\n";
+   }
+
+   void printHelpCommandSubMasters()
+   {
+      std::cout << "With many nodes, the master serves the threads of all slaves. With \"--sub-masters=<n>\",\n"
+                << "the nodes 1, ..., n are sub-masters, each serving every n-th of the remaining nodes.\n"
+                << "A sub-master takes large batches of jobs from the master, hands them on to its slaves\n"
+                << "and drops results of classes known to the master, before sending the others back in one\n"
+                << "message per batch. Hence the master only serves the n sub-masters, however many nodes there are.\n"
+                << "Each sub-master needs at least one slave. Ignored in the distributed mode (\"--distributed\").\n\n"
+                << "Use \"--sub-masters=<n>\" with a non-negative integral parameter (default: 0, disabled).\n"
+                << "Example usage:\n"
+                << "\tmpirun -np 64 ./" << project::binary_name << " myproblem --sub-masters=3\n";
+   }
+
+   void printHelpCommandProcesses()
+   {
+      std::cout << "Adjacency decomposition can run as several processes on one machine without an MPI installation.\n"
+                << "The first process takes the role of the master, the others the role of the slaves, as with MPI.\n"
+                << "The processes are forked at the start and communicate through shared memory.\n"
+                << "Each process uses the number of threads given by \"-t\" / \"--threads=\".\n"
+                << "Use \"--processes=<n>\" with a positive integral parameter (default: 1). It may be combined with \"--distributed\".\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem --processes=4 -t 2\n";
+   }
+
    void printHelpCommandVersion()
    {
       std::cout << "For bug reports, please include the version information.\n"
@@ -255,6 +341,34 @@ namespace
       {
          printHelpCommandSampling();
       }
+      else if ( command == "detect-symmetry" || command == "--detect-symmetry" )
+      {
+         printHelpCommandDetectSymmetry();
+      }
+      else if ( command == "expand" || command == "--expand" )
+      {
+         printHelpCommandExpand();
+      }
+      else if ( command == "distributed" || command == "--distributed" )
+      {
+         printHelpCommandDistributed();
+      }
+      else if ( command == "lease" || command == "--lease" )
+      {
+         printHelpCommandLease();
+      }
+      else if ( command == "prefetch" || command == "--prefetch" )
+      {
+         printHelpCommandPrefetch();
+      }
+      else if ( command == "sub-masters" || command == "--sub-masters" )
+      {
+         printHelpCommandSubMasters();
+      }
+      else if ( command == "processes" || command == "--processes" )
+      {
+         printHelpCommandProcesses();
+      }
       else if ( command == "v" || command == "-v" || command == "version" || command == "-version" || command == "--version" )
       {
          printHelpCommandVersion();
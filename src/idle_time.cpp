@@ -0,0 +1,47 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "idle_time.h"
+
+#include <algorithm>
+
+using namespace panda;
+
+panda::IdleTime::IdleTime()
+:
+   start(Clock::now()),
+   mutex(),
+   waited()
+{
+}
+
+void panda::IdleTime::record(const Duration duration)
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   waited[std::this_thread::get_id()] += duration;
+}
+
+double panda::IdleTime::fraction() const
+{
+   return fraction(Clock::now() - start);
+}
+
+double panda::IdleTime::fraction(const Duration elapsed) const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   if ( waited.empty() || elapsed.count() <= 0.0 )
+   {
+      return 0.0;
+   }
+   Duration total(0);
+   for ( const auto& thread : waited )
+   {
+      total += thread.second;
+   }
+   const auto fraction = total / (elapsed * static_cast<double>(waited.size()));
+   return std::min(1.0, fraction);
+}
+
@@ -0,0 +1,38 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace panda
+{
+   /// Time the threads of a process spend waiting (e.g. for jobs), shared between threads.
+   /// Only the threads that record waits are taken into account.
+   class IdleTime
+   {
+      public:
+         using Clock = std::chrono::steady_clock;
+         using Duration = std::chrono::duration<double>;
+         /// Constructor: the measurement starts.
+         IdleTime();
+         /// Adds a duration the calling thread waited.
+         void record(Duration);
+         /// Returns the fraction of the time since construction the threads waited.
+         double fraction() const;
+         /// Returns the fraction of the given time per thread the threads waited.
+         double fraction(Duration) const;
+      private:
+         const Clock::time_point start;
+         mutable std::mutex mutex;
+         /// waiting time of each thread.
+         std::map<std::thread::id, Duration> waited;
+   };
+}
+
@@ -0,0 +1,283 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_INCIDENCE
+#include "incidence.h"
+#undef COMPILE_TEMPLATE_INCIDENCE
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <type_traits>
+
+#include "algorithm_inequality_operations.h"
+#include "modular_arithmetic.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Magnitudes at or above 2^unbounded are not bounded at all.
+   constexpr unsigned int unbounded = 62;
+   /// Residue of a native integer.
+   template <typename Integer>
+   uint64_t residue(const Integer&, std::true_type) noexcept;
+   /// Residue of any other integer type (provided by the type).
+   template <typename Integer>
+   uint64_t residue(const Integer&, std::false_type) noexcept;
+   /// Residues of all entries of a row.
+   template <typename Integer>
+   std::vector<uint64_t> rowResidues(const Row<Integer>&);
+   /// Returns the smallest k such that all entries of the row are less than 2^k in magnitude.
+   template <typename Integer>
+   unsigned int magnitude(const Row<Integer>&);
+   /// Residues of all vertices, only for integer types that aren't native.
+   template <typename Integer>
+   std::vector<std::vector<uint64_t>> vertexResidues(const Vertices<Integer>&);
+   /// Magnitudes of all vertices, only for integer types that aren't native.
+   template <typename Integer>
+   std::vector<unsigned int> vertexMagnitudes(const Vertices<Integer>&);
+   /// Padded copy of the vertices, only for native integer types.
+   template <typename Integer>
+   PaddedVertices<Integer> paddedVertices(const Vertices<Integer>&);
+   /// Returns the smallest k such that 2^k >= n.
+   unsigned int ceilLog2(std::size_t) noexcept;
+   /// Scalar product of two rows of residues.
+   uint64_t scalarProduct(const std::vector<uint64_t>&, const std::vector<uint64_t>&) noexcept;
+}
+
+template <typename Integer>
+panda::Incidence<Integer>::Incidence(const Vertices<Integer>& vertices_)
+:
+   vertex_matrix(vertices_),
+   residues(vertexResidues(vertices_)),
+   magnitudes(vertexMagnitudes(vertices_)),
+   padded_vertices(paddedVertices(vertices_))
+{
+}
+
+template <typename Integer>
+const Vertices<Integer>& panda::Incidence<Integer>::vertices() const noexcept
+{
+   return vertex_matrix;
+}
+
+template <typename Integer>
+std::vector<std::size_t> panda::Incidence<Integer>::support(const Inequality<Integer>& inequality) const
+{
+   return supportBitset(inequality).indices();
+}
+
+template <typename Integer>
+Support panda::Incidence<Integer>::supportBitset(const Inequality<Integer>& inequality) const
+{
+   Support result(vertex_matrix.size());
+   if ( !padded_vertices.empty() )
+   {
+      std::vector<Integer> vertex_distances;
+      distances(inequality, vertex_distances);
+      for ( std::size_t i = 0; i < vertex_distances.size(); ++i )
+      {
+         if ( vertex_distances[i] == 0 )
+         {
+            result.set(i);
+         }
+      }
+      return result;
+   }
+   const auto inequality_residues = residues.empty() ? std::vector<uint64_t>{} : rowResidues(inequality);
+   const auto inequality_magnitude = residues.empty() ? unbounded : magnitude(inequality);
+   for ( std::size_t i = 0; i < vertex_matrix.size(); ++i )
+   {
+      if ( isIncident(inequality, inequality_residues, inequality_magnitude, i) )
+      {
+         result.set(i);
+      }
+   }
+   return result;
+}
+
+template <typename Integer>
+Vertices<Integer> panda::Incidence<Integer>::verticesOnFace(const Inequality<Integer>& inequality) const
+{
+   const auto indices = support(inequality);
+   Vertices<Integer> selection;
+   selection.reserve(indices.size());
+   for ( const auto index : indices )
+   {
+      selection.push_back(vertex_matrix[index]);
+   }
+   return selection;
+}
+
+template <typename Integer>
+Vertex<Integer> panda::Incidence<Integer>::furthestVertex(const Inequality<Integer>& inequality) const
+{
+   assert( !vertex_matrix.empty() );
+   std::vector<Integer> vertex_distances;
+   distances(inequality, vertex_distances);
+   const auto it = std::max_element(vertex_distances.cbegin(), vertex_distances.cend());
+   return vertex_matrix[static_cast<std::size_t>(it - vertex_distances.cbegin())];
+}
+
+template <typename Integer>
+Vertex<Integer> panda::Incidence<Integer>::nearestVertex(const Inequality<Integer>& inequality) const
+{
+   assert( !vertex_matrix.empty() );
+   std::vector<Integer> vertex_distances;
+   distances(inequality, vertex_distances);
+   const auto it = std::min_element(vertex_distances.cbegin(), vertex_distances.cend());
+   return vertex_matrix[static_cast<std::size_t>(it - vertex_distances.cbegin())];
+}
+
+template <typename Integer>
+void panda::Incidence<Integer>::distances(const Inequality<Integer>& inequality, std::vector<Integer>& result) const
+{
+   if ( !padded_vertices.empty() )
+   {
+      padded_vertices.distances(inequality, result);
+      return;
+   }
+   result.clear();
+   result.reserve(vertex_matrix.size());
+   for ( const auto& vertex : vertex_matrix )
+   {
+      result.push_back(algorithm::distance(inequality, vertex));
+   }
+}
+
+template <typename Integer>
+bool panda::Incidence<Integer>::isIncident(const Inequality<Integer>& inequality, const std::vector<uint64_t>& inequality_residues, const unsigned int inequality_magnitude, const std::size_t index) const
+{
+   assert( index < vertex_matrix.size() );
+   if ( residues.empty() )
+   {
+      return algorithm::distance(inequality, vertex_matrix[index]) == 0;
+   }
+   // a non-zero residue proves a non-zero distance.
+   if ( scalarProduct(inequality_residues, residues[index]) != 0 )
+   {
+      return false;
+   }
+   // |distance| < 2^60 < prime, so the residue zero is only possible for the distance zero.
+   if ( inequality_magnitude + magnitudes[index] + ceilLog2(inequality.size()) <= 60 )
+   {
+      return true;
+   }
+   return algorithm::distance(inequality, vertex_matrix[index]) == 0;
+}
+
+namespace
+{
+   template <typename Integer>
+   uint64_t residue(const Integer& value, std::true_type) noexcept
+   {
+      return modular::residue(value);
+   }
+
+   template <typename Integer>
+   uint64_t residue(const Integer& value, std::false_type) noexcept
+   {
+      return value.residue();
+   }
+
+   template <typename Integer>
+   std::vector<uint64_t> rowResidues(const Row<Integer>& row)
+   {
+      std::vector<uint64_t> result;
+      result.reserve(row.size());
+      for ( const auto& value : row )
+      {
+         result.push_back(residue(value, std::is_integral<Integer>{}));
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   unsigned int magnitude(const Row<Integer>& row)
+   {
+      using std::abs;
+      Integer maximum(0);
+      for ( const auto& value : row )
+      {
+         const auto absolute_value = abs(value);
+         if ( absolute_value > maximum )
+         {
+            maximum = absolute_value;
+         }
+      }
+      unsigned int k = 0;
+      while ( k < unbounded && !(maximum < Integer(int64_t{1} << k)) )
+      {
+         ++k;
+      }
+      return k;
+   }
+
+   template <typename Integer>
+   std::vector<std::vector<uint64_t>> vertexResidues(const Vertices<Integer>& vertices)
+   {
+      // native integers are cheaper to multiply exactly than modulo the prime.
+      std::vector<std::vector<uint64_t>> result;
+      if ( !std::is_integral<Integer>::value )
+      {
+         result.reserve(vertices.size());
+         for ( const auto& vertex : vertices )
+         {
+            result.push_back(rowResidues(vertex));
+         }
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   std::vector<unsigned int> vertexMagnitudes(const Vertices<Integer>& vertices)
+   {
+      std::vector<unsigned int> result;
+      if ( !std::is_integral<Integer>::value )
+      {
+         result.reserve(vertices.size());
+         for ( const auto& vertex : vertices )
+         {
+            result.push_back(magnitude(vertex));
+         }
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   PaddedVertices<Integer> paddedVertices(const Vertices<Integer>& vertices)
+   {
+      // for other integer types, the arithmetic dominates the memory layout.
+      if ( std::is_integral<Integer>::value )
+      {
+         return PaddedVertices<Integer>(vertices);
+      }
+      return PaddedVertices<Integer>(Vertices<Integer>{});
+   }
+
+   unsigned int ceilLog2(const std::size_t n) noexcept
+   {
+      unsigned int k = 0;
+      while ( (std::size_t{1} << k) < n )
+      {
+         ++k;
+      }
+      return k;
+   }
+
+   uint64_t scalarProduct(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) noexcept
+   {
+      assert( a.size() == b.size() );
+      uint64_t value = 0;
+      for ( std::size_t i = 0; i < a.size(); ++i )
+      {
+         value = modular::add(value, modular::multiply(a[i], b[i]));
+      }
+      return value;
+   }
+}
+
@@ -0,0 +1,62 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "matrix.h"
+#include "padded_vertices.h"
+#include "row.h"
+#include "support.h"
+
+namespace panda
+{
+   /// Decides which vertices lie on the face of an inequality.
+   /// For integer types with expensive arithmetic (BigInteger, SafeInteger), the distances
+   /// are evaluated modulo a prime first, using residues of the vertices that are computed once.
+   /// A non-zero residue proves a non-zero distance. A zero residue proves a zero distance
+   /// if the entries are small enough, otherwise the distance is computed exactly.
+   /// For native integer types, the distances are computed on a padded copy of the vertices.
+   template <typename Integer>
+   class Incidence
+   {
+      public:
+         /// Constructor. The vertices have to outlive the object.
+         explicit Incidence(const Vertices<Integer>&);
+         /// Returns the vertices.
+         const Vertices<Integer>& vertices() const noexcept;
+         /// Returns the (sorted) indices of all vertices on the face of the inequality.
+         std::vector<std::size_t> support(const Inequality<Integer>&) const;
+         /// Returns the set of vertices on the face of the inequality as a bitset.
+         Support supportBitset(const Inequality<Integer>&) const;
+         /// Returns all vertices on the face of the inequality.
+         Vertices<Integer> verticesOnFace(const Inequality<Integer>&) const;
+         /// Returns (the first) vertex with maximal distance to the inequality.
+         Vertex<Integer> furthestVertex(const Inequality<Integer>&) const;
+         /// Returns (the first) vertex with minimal distance to the inequality.
+         Vertex<Integer> nearestVertex(const Inequality<Integer>&) const;
+      private:
+         const Vertices<Integer>& vertex_matrix;
+         /// Residues of the vertices (empty for native integer types).
+         const std::vector<std::vector<uint64_t>> residues;
+         /// Bounds on the magnitudes of the vertex entries (as powers of two).
+         const std::vector<unsigned int> magnitudes;
+         /// Padded copy of the vertices (empty for integer types that aren't native).
+         const PaddedVertices<Integer> padded_vertices;
+      private:
+         /// Calculates the distances of all vertices to the inequality.
+         void distances(const Inequality<Integer>&, std::vector<Integer>&) const;
+         /// Returns true if the vertex with the given index lies on the face, given the residues
+         /// and the magnitude of the inequality.
+         bool isIncident(const Inequality<Integer>&, const std::vector<uint64_t>&, unsigned int, std::size_t) const;
+   };
+}
+
+#include "incidence.eti"
+
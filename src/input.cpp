@@ -4,22 +4,28 @@
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
 //-------------------------------------------------------------------------------//
 
+#define COMPILE_TEMPLATE_INPUT
 #include "input.h"
+#undef COMPILE_TEMPLATE_INPUT
 
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "algorithm_classes.h"
 #include "algorithm_map_operations.h"
 #include "algorithm_matrix_operations.h"
 #include "algorithm_row_operations.h"
+#include "concurrency.h"
 #include "input_common.h"
 #include "input_consistency.h"
 #include "input_constraint.h"
@@ -33,36 +39,49 @@
 #include "input_vertex.h"
 #include "input_vertex_permutation.h"
 #include "istream_peek_line.h"
+#include "map_group.h"
 #include "vertex_group.h"
 
 using namespace panda;
 
 namespace
 {
-   void sort(int, char**, Matrix<int>&);
-   void expandInequalities(Matrix<int>&, const Maps&);
-   void expandVertices(Matrix<int>&, const Maps&);
+   template <typename Integer>
+   void sort(int, char**, Matrix<Integer>&);
+   template <typename Integer>
+   void expandInequalities(Matrix<Integer>&, const Maps&);
+   template <typename Integer>
+   void expandVertices(Matrix<Integer>&, const Maps&);
 
    std::string getFilenameKnownFacets(int, char**);
    std::string getFilenameKnownVertices(int, char**);
-   Inequalities<int> knownFacets(int, char**, const Names&);
-   Vertices<int> knownVertices(int, char**);
+   template <typename Integer>
+   Inequalities<Integer> knownFacets(int, char**, const Names&);
+   template <typename Integer>
+   Vertices<Integer> knownVertices(int, char**);
+   /// Translates permutations of the rows as read from the file to the indices of the final
+   /// (sorted, possibly extended) matrix. Rows that were not read from the file are fixed.
+   /// Repeated rows are matched in order of appearance.
+   template <typename Integer>
+   std::vector<std::vector<std::size_t>> relabel(const std::vector<std::vector<std::size_t>>&, const Matrix<Integer>&, const Matrix<Integer>&);
 }
 
 namespace
 {
-   Vertices<int> readVerticesConvex(int argc, char** argv, std::ifstream& file, const Maps& maps)
+   template <typename Integer>
+   Vertices<Integer> readVerticesConvex(int argc, char** argv, std::ifstream& file, const Maps& maps)
    {
-      const auto conv = input::implementation::verticesConvex(file);
+      const auto conv = input::implementation::verticesConvex<Integer>(file);
       if ( input::checkValidity(argc, argv) )
       {
-         input::implementation::checkValidityOfVertexClasses(conv, maps);
+         input::implementation::checkValidityOfVertexClasses(conv, maps, concurrency::numberOfThreads(argc, argv));
       }
       return conv;
    }
-   Vertices<int> readVerticesReducedConvex(int argc, char** argv, std::ifstream& file, const Maps& maps)
+   template <typename Integer>
+   Vertices<Integer> readVerticesReducedConvex(int argc, char** argv, std::ifstream& file, const Maps& maps)
    {
-      auto conv = input::implementation::verticesConvex(file);
+      auto conv = input::implementation::verticesConvex<Integer>(file);
       if ( input::checkValidity(argc, argv) )
       {
          std::cerr << "Warning: validity of input vertices cannot be verified for reduced input.\n";
@@ -70,18 +89,20 @@ namespace
       expandVertices(conv, maps);
       return conv;
    }
-   Vertices<int> readVerticesConical(int argc, char** argv, std::ifstream& file, const Maps& maps)
+   template <typename Integer>
+   Vertices<Integer> readVerticesConical(int argc, char** argv, std::ifstream& file, const Maps& maps)
    {
-      const auto cone = input::implementation::verticesConical(file);
+      const auto cone = input::implementation::verticesConical<Integer>(file);
       if ( input::checkValidity(argc, argv) )
       {
-         input::implementation::checkValidityOfVertexClasses(cone, maps);
+         input::implementation::checkValidityOfVertexClasses(cone, maps, concurrency::numberOfThreads(argc, argv));
       }
       return cone;
    }
-   Vertices<int> readVerticesReducedConical(int argc, char** argv, std::ifstream& file, const Maps& maps)
+   template <typename Integer>
+   Vertices<Integer> readVerticesReducedConical(int argc, char** argv, std::ifstream& file, const Maps& maps)
    {
-      auto cone = input::implementation::verticesConical(file);
+      auto cone = input::implementation::verticesConical<Integer>(file);
       if ( input::checkValidity(argc, argv) )
       {
          std::cerr << "Warning: validity of input rays cannot be verified for reduced input.\n";
@@ -89,18 +110,20 @@ namespace
       expandVertices(cone, maps);
       return cone;
    }
-   Inequalities<int> readInequalities(int argc, char** argv, std::ifstream& file, const Names& names, const Maps& maps)
+   template <typename Integer>
+   Inequalities<Integer> readInequalities(int argc, char** argv, std::ifstream& file, const Names& names, const Maps& maps)
    {
-      const auto inequalities = input::implementation::constraints<ConstraintType::Inequality>(file, names);
+      const auto inequalities = input::implementation::constraints<ConstraintType::Inequality, Integer>(file, names);
       if ( input::checkValidity(argc, argv) )
       {
-         input::implementation::checkValidityOfInequalityClasses(inequalities, maps);
+         input::implementation::checkValidityOfInequalityClasses(inequalities, maps, concurrency::numberOfThreads(argc, argv));
       }
       return inequalities;
    }
-   Inequalities<int> readReducedInequalities(int argc, char** argv, std::ifstream& file, const Names& names, const Maps& maps, const Equations<int>& equations)
+   template <typename Integer>
+   Inequalities<Integer> readReducedInequalities(int argc, char** argv, std::ifstream& file, const Names& names, const Maps& maps, const Equations<Integer>& equations)
    {
-      auto inequalities = input::implementation::constraints<ConstraintType::Inequality>(file, names);
+      auto inequalities = input::implementation::constraints<ConstraintType::Inequality, Integer>(file, names);
       if ( input::checkValidity(argc, argv) )
       {
          std::cerr << "Warning: validity of input inequalities cannot be checked for reduced input.\n";
@@ -115,8 +138,8 @@ namespace
    }
 }
 
-template <>
-std::tuple<Vertices<int>, Names, Maps, Inequalities<int>, std::optional<VertexGroup>> panda::input::vertices<int>(int argc, char** argv)
+template <typename Integer>
+std::tuple<Vertices<Integer>, Names, Maps, Inequalities<Integer>, std::optional<VertexGroup>> panda::input::vertices(int argc, char** argv)
 {
    const auto filename = getFilename(argc, argv);
    std::ifstream file(filename.c_str());
@@ -124,8 +147,8 @@ std::tuple<Vertices<int>, Names, Maps, Inequalities<int>, std::optional<VertexGr
    {
       throw std::invalid_argument("Failed to open file \"" + filename + "\".");
    }
-   ConvexHull<int> conv;
-   ConvexHull<int> cone;
+   ConvexHull<Integer> conv;
+   ConvexHull<Integer> cone;
    std::size_t dimension = std::numeric_limits<std::size_t>::max();
    Names names;
    Maps maps;
@@ -170,19 +193,19 @@ std::tuple<Vertices<int>, Names, Maps, Inequalities<int>, std::optional<VertexGr
       }
       else if ( implementation::isKeywordConvexHull(token) )
       {
-         conv = readVerticesConvex(argc, argv, file, maps);
+         conv = readVerticesConvex<Integer>(argc, argv, file, maps);
       }
       else if ( implementation::isKeywordReducedConvexHull(token) )
       {
-         conv = readVerticesReducedConvex(argc, argv, file, maps);
+         conv = readVerticesReducedConvex<Integer>(argc, argv, file, maps);
       }
       else if ( implementation::isKeywordConicalHull(token) )
       {
-         cone = readVerticesConical(argc, argv, file, maps);
+         cone = readVerticesConical<Integer>(argc, argv, file, maps);
       }
       else if ( implementation::isKeywordReducedConicalHull(token) )
       {
-         cone = readVerticesReducedConical(argc, argv, file, maps);
+         cone = readVerticesReducedConical<Integer>(argc, argv, file, maps);
       }
       else
       {
@@ -190,13 +213,19 @@ std::tuple<Vertices<int>, Names, Maps, Inequalities<int>, std::optional<VertexGr
       }
    }
    implementation::checkConsistency(conv, cone, names, maps, dimension);
+   Matrix<Integer> file_order;
+   if ( !vertex_permutation_generators.empty() )
+   {
+      file_order.insert(file_order.end(), cone.cbegin(), cone.cend());
+      file_order.insert(file_order.end(), conv.cbegin(), conv.cend());
+   }
    sort(argc, argv, cone);
    sort(argc, argv, conv);
-   Matrix<int> vertices;
+   Matrix<Integer> vertices;
    vertices.reserve(cone.size() + conv.size());
    vertices.insert(vertices.end(), cone.cbegin(), cone.cend());
    vertices.insert(vertices.end(), conv.cbegin(), conv.cend());
-   auto known_facets = knownFacets(argc, argv, names);
+   auto known_facets = knownFacets<Integer>(argc, argv, names);
    if ( input::checkValidity(argc, argv) )
    {
       input::implementation::checkValidityOfInequalities(vertices, known_facets);
@@ -204,13 +233,13 @@ std::tuple<Vertices<int>, Names, Maps, Inequalities<int>, std::optional<VertexGr
    std::optional<VertexGroup> vertex_group;
    if ( !vertex_permutation_generators.empty() )
    {
-      vertex_group.emplace(vertex_permutation_generators, vertices.size());
+      vertex_group.emplace(relabel(vertex_permutation_generators, file_order, vertices), vertices.size());
    }
    return std::make_tuple(vertices, names, maps, known_facets, vertex_group);
 }
 
-template <>
-std::tuple<Inequalities<int>, Names, Maps, Vertices<int>, std::optional<VertexGroup>> panda::input::inequalities<int>(int argc, char** argv)
+template <typename Integer>
+std::tuple<Inequalities<Integer>, Names, Maps, Vertices<Integer>, std::optional<VertexGroup>> panda::input::inequalities(int argc, char** argv)
 {
    const auto filename = getFilename(argc, argv);
    std::ifstream file(filename.c_str());
@@ -218,8 +247,8 @@ std::tuple<Inequalities<int>, Names, Maps, Vertices<int>, std::optional<VertexGr
    {
       throw std::invalid_argument("Failed to open file \"" + filename + "\".");
    }
-   Equations<int> equations;
-   Inequalities<int> inequalities;
+   Equations<Integer> equations;
+   Inequalities<Integer> inequalities;
    std::size_t dimension = std::numeric_limits<std::size_t>::max();
    Names names;
    Maps maps;
@@ -251,16 +280,25 @@ std::tuple<Inequalities<int>, Names, Maps, Vertices<int>, std::optional<VertexGr
       }
       else if ( implementation::isKeywordVertexPermutations(token) )
       {
-         // Vertex Permutations are not supported for inequality input (facet enumeration mode)
-         throw std::invalid_argument("\"Vertex Permutations\" are only supported with vertex input files, not inequality files.");
+         // in an inequality file, the permutations act on the indices of the inequalities.
+         if ( has_maps )
+         {
+            throw std::invalid_argument("Cannot have both \"Maps\" and \"Vertex Permutations\" in the same file.");
+         }
+         has_vertex_permutations = true;
+         if ( inequalities.empty() )
+         {
+            throw std::invalid_argument("\"Vertex Permutations\" section must come after \"Inequalities\" section.");
+         }
+         vertex_permutation_generators = implementation::vertexPermutations(file, inequalities.size());
       }
       else if ( implementation::isKeywordEquations(token) )
       {
-         equations = implementation::constraints<ConstraintType::Equation>(file, names);
+         equations = implementation::constraints<ConstraintType::Equation, Integer>(file, names);
       }
       else if ( implementation::isKeywordInequalities(token) )
       {
-         inequalities = readInequalities(argc, argv, file, names, maps);
+         inequalities = readInequalities<Integer>(argc, argv, file, names, maps);
       }
       else if ( implementation::isKeywordReducedInequalities(token) )
       {
@@ -272,21 +310,27 @@ std::tuple<Inequalities<int>, Names, Maps, Vertices<int>, std::optional<VertexGr
       }
    }
    implementation::checkConsistency(inequalities, names, dimension);
+   const auto file_order = vertex_permutation_generators.empty() ? Inequalities<Integer>{} : inequalities;
    inequalities.reserve(inequalities.size() + 2 * equations.size());
    for ( const auto& equation : equations )
    {
       inequalities.push_back(equation);
-      inequalities.push_back(-1 * equation);
+      inequalities.push_back(Integer(-1) * equation);
    }
    sort(argc, argv, inequalities);
-   inequalities.emplace_back(inequalities.back().size(), 0);
-   inequalities.back().back() = -1;
-   auto known_vertices = knownVertices(argc, argv);
+   inequalities.emplace_back(inequalities.back().size(), Integer(0));
+   inequalities.back().back() = Integer(-1);
+   auto known_vertices = knownVertices<Integer>(argc, argv);
    if ( input::checkValidity(argc, argv) )
    {
       input::implementation::checkValidityOfVertices(inequalities, known_vertices);
    }
-   return std::make_tuple(inequalities, names, maps, known_vertices, std::optional<VertexGroup>{});
+   std::optional<VertexGroup> vertex_group;
+   if ( !vertex_permutation_generators.empty() )
+   {
+      vertex_group.emplace(relabel(vertex_permutation_generators, file_order, inequalities), inequalities.size());
+   }
+   return std::make_tuple(inequalities, names, maps, known_vertices, vertex_group);
 }
 
 namespace
@@ -363,7 +407,8 @@ namespace
       return "";
    }
 
-   Inequalities<int> knownFacets(int argc, char** argv, const Names& names)
+   template <typename Integer>
+   Inequalities<Integer> knownFacets(int argc, char** argv, const Names& names)
    {
       const auto filename = getFilenameKnownFacets(argc, argv);
       if ( filename.empty() )
@@ -379,12 +424,13 @@ namespace
       input::advanceToNextKeyword(file, token);
       if ( input::implementation::isKeywordInequalities(token) )
       {
-         return readInequalities(argc, argv, file, names, {});
+         return readInequalities<Integer>(argc, argv, file, names, {});
       }
       throw std::invalid_argument("Expected no other keyword than \"Inequalities\" in a file containing known facets.");
    }
 
-   Vertices<int> knownVertices(int argc, char** argv)
+   template <typename Integer>
+   Vertices<Integer> knownVertices(int argc, char** argv)
    {
       const auto filename = getFilenameKnownVertices(argc, argv);
       if ( filename.empty() )
@@ -396,17 +442,17 @@ namespace
       {
          throw std::invalid_argument("Failed to open file \"" + filename + "\".");
       }
-      Vertices<int> conv;
-      Vertices<int> cone;
+      Vertices<Integer> conv;
+      Vertices<Integer> cone;
       for ( std::string token; input::advanceToNextKeyword(file, token); )
       {
          if ( input::implementation::isKeywordConvexHull(token) )
          {
-            conv = readVerticesConvex(argc, argv, file, {});
+            conv = readVerticesConvex<Integer>(argc, argv, file, {});
          }
          else if ( input::implementation::isKeywordConicalHull(token) )
          {
-            cone = readVerticesConical(argc, argv, file, {});
+            cone = readVerticesConical<Integer>(argc, argv, file, {});
          }
          else
          {
@@ -421,7 +467,8 @@ namespace
 
 namespace
 {
-   void sort(int argc, char** argv, Matrix<int>& matrix)
+   template <typename Integer>
+   void sort(int argc, char** argv, Matrix<Integer>& matrix)
    {
       const auto order = getInputOrder(argc, argv);
       switch ( order )
@@ -438,7 +485,7 @@ namespace
          }
          case InputOrder::NonZeroEntriesAscending:
          {
-            std::sort(matrix.begin(), matrix.end(), [](const Row<int>& a, const Row<int>& b)
+            std::sort(matrix.begin(), matrix.end(), [](const Row<Integer>& a, const Row<Integer>& b)
             {
                const auto zero_entries_a = std::count(a.cbegin(), a.cend(), 0);
                const auto zero_entries_b = std::count(b.cbegin(), b.cend(), 0);
@@ -452,7 +499,7 @@ namespace
          }
          case InputOrder::NonZeroEntriesDescending:
          {
-            std::sort(matrix.begin(), matrix.end(), [](const Row<int>& a, const Row<int>& b)
+            std::sort(matrix.begin(), matrix.end(), [](const Row<Integer>& a, const Row<Integer>& b)
             {
                const auto zero_entries_a = std::count(a.cbegin(), a.cend(), 0);
                const auto zero_entries_b = std::count(b.cbegin(), b.cend(), 0);
@@ -476,32 +523,36 @@ namespace
       }
    }
 
-   void expandInequalities(Matrix<int>& matrix, const Maps& maps)
+   template <typename Integer>
+   void expandInequalities(Matrix<Integer>& matrix, const Maps& maps)
    {
       if ( maps.empty() )
       {
          throw std::invalid_argument("The system of inequalities cannot be a reduced system without any maps. Maps must be declared before the section of inequalities.");
       }
-      Matrix<int> all;
+      const MapGroup map_group(maps);
+      Matrix<Integer> all;
       for ( const auto& row : matrix )
       {
-         const auto row_class = algorithm::getClass(row, maps, tag::facet{});
+         const auto row_class = algorithm::getClass(row, map_group, tag::facet{});
          all.reserve(all.size() + row_class.size());
          all.insert(all.end(), row_class.cbegin(), row_class.cend());
       }
       matrix = std::move(all);
    }
 
-   void expandVertices(Matrix<int>& matrix, const Maps& maps)
+   template <typename Integer>
+   void expandVertices(Matrix<Integer>& matrix, const Maps& maps)
    {
       if ( maps.empty() )
       {
          throw std::invalid_argument("The system of vertices / rays cannot be a reduced system without any maps. Maps must be declared before the section of vertices / rays.");
       }
-      Matrix<int> all;
+      const MapGroup map_group(maps);
+      Matrix<Integer> all;
       for ( const auto& row : matrix )
       {
-         const auto row_class = algorithm::getClass(row, maps, tag::vertex{});
+         const auto row_class = algorithm::getClass(row, map_group, tag::vertex{});
          all.reserve(all.size() + row_class.size());
          all.insert(all.end(), row_class.cbegin(), row_class.cend());
       }
@@ -509,3 +560,42 @@ namespace
    }
 }
 
+namespace
+{
+   template <typename Integer>
+   std::vector<std::vector<std::size_t>> relabel(const std::vector<std::vector<std::size_t>>& permutations, const Matrix<Integer>& file_order, const Matrix<Integer>& matrix)
+   {
+      // the k-th copy of a row in the file is the k-th copy in the matrix.
+      std::map<Row<Integer>, std::deque<std::size_t>> positions;
+      for ( std::size_t i = 0; i < matrix.size(); ++i )
+      {
+         positions[matrix[i]].push_back(i);
+      }
+      std::vector<std::size_t> new_index(file_order.size());
+      for ( std::size_t i = 0; i < file_order.size(); ++i )
+      {
+         auto& position = positions[file_order[i]];
+         assert( !position.empty() );
+         new_index[i] = position.front();
+         position.pop_front();
+      }
+      std::vector<std::vector<std::size_t>> result;
+      result.reserve(permutations.size());
+      for ( const auto& permutation : permutations )
+      {
+         assert( permutation.size() == file_order.size() );
+         std::vector<std::size_t> relabeled(matrix.size());
+         for ( std::size_t i = 0; i < matrix.size(); ++i )
+         {
+            relabeled[i] = i;
+         }
+         for ( std::size_t i = 0; i < permutation.size(); ++i )
+         {
+            relabeled[new_index[i]] = new_index[permutation[i]];
+         }
+         result.push_back(std::move(relabeled));
+      }
+      return result;
+   }
+}
+
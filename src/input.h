@@ -26,14 +26,8 @@ namespace panda
       /// Reads an inequality description with optional names and maps.
       template <typename Integer>
       std::tuple<Inequalities<Integer>, Names, Maps, Vertices<Integer>, std::optional<VertexGroup>> inequalities(int, char**);
-
-      // explicit template instantiations
-      template <>
-      std::tuple<Vertices<int>, Names, Maps, Inequalities<int>, std::optional<VertexGroup>> vertices<int>(int, char**);
-      template <>
-      std::tuple<Inequalities<int>, Names, Maps, Vertices<int>, std::optional<VertexGroup>> inequalities<int>(int, char**);
    }
 }
 
-#include "input.tpp"
+#include "input.eti"
 
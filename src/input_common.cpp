@@ -4,11 +4,18 @@
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
 //-------------------------------------------------------------------------------//
 
+#define COMPILE_TEMPLATE_INPUT_COMMON
 #include "input_common.h"
+#undef COMPILE_TEMPLATE_INPUT_COMMON
 
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
 #include <sstream>
 #include <stdexcept>
+#include <system_error>
+#include <type_traits>
 
 #include "algorithm_row_operations.h"
 #include "input_keywords.h"
@@ -17,6 +24,16 @@
 
 using namespace panda;
 
+namespace
+{
+   /// Converts a sign followed by decimal digits into a native integer.
+   template <typename Integer>
+   Integer fromDigits(const std::string&, std::true_type);
+   /// Converts a sign followed by decimal digits into any other integer type.
+   template <typename Integer>
+   Integer fromDigits(const std::string&, std::false_type);
+}
+
 bool panda::input::isIdentifier(std::istream& stream)
 {
    const auto guard = makeScopeGuard([&]()
@@ -224,11 +241,12 @@ bool panda::input::containsNames(const Names& names, std::istream& stream)
    return false;
 }
 
-Row<int> panda::input::normalize(Row<int> row, RelationOperator relation)
+template <typename Integer>
+Row<Integer> panda::input::normalize(Row<Integer> row, RelationOperator relation)
 {
    if ( relation == RelationOperator::GreaterEqual )
    {
-      row *= -1; // invert, now row satisfies LessEqual.
+      row *= Integer(-1); // invert, now row satisfies LessEqual.
    }
    return row;
 }
@@ -252,6 +270,48 @@ int panda::input::toInt(const std::string& string)
    return result;
 }
 
+template <typename Integer>
+Integer panda::input::toInteger(const std::string& string)
+{
+   if ( string.empty() || string == "+" )
+   {
+      return Integer(1);
+   }
+   if ( string == "-" )
+   {
+      return Integer(-1);
+   }
+   std::istringstream stream(string);
+   Integer result;
+   if ( !readInteger(stream, result) )
+   {
+      throw std::invalid_argument("toInteger: Argument is not an integer.");
+   }
+   return result;
+}
+
+template <typename Integer>
+std::istream& panda::input::readInteger(std::istream& stream, Integer& value)
+{
+   std::string digits;
+   stream >> std::ws;
+   if ( stream.peek() == '+' || stream.peek() == '-' )
+   {
+      digits.push_back(static_cast<char>(stream.get()));
+   }
+   while ( std::isdigit(stream.peek()) )
+   {
+      digits.push_back(static_cast<char>(stream.get()));
+   }
+   if ( digits.empty() || !std::isdigit(static_cast<unsigned char>(digits.back())) )
+   {
+      stream.setstate(std::ios_base::failbit);
+      return stream;
+   }
+   value = fromDigits<Integer>(digits, std::is_integral<Integer>{});
+   return stream;
+}
+
 std::istream& panda::input::advanceToNextKeyword(std::istream& stream, std::string& string)
 {
    while ( stream )
@@ -294,3 +354,44 @@ std::string panda::input::peekWord(std::istream& stream)
    return token;
 }
 
+namespace
+{
+   template <typename Integer>
+   Integer fromDigits(const std::string& digits, std::true_type)
+   {
+      // std::from_chars does not accept a leading '+'.
+      const auto first = digits.data() + ((digits.front() == '+') ? 1 : 0);
+      const auto last = digits.data() + digits.size();
+      Integer value{};
+      const auto result = std::from_chars(first, last, value);
+      if ( result.ec != std::errc{} || result.ptr != last )
+      {
+         throw std::invalid_argument("The number " + digits + " does not fit into the selected integer type.");
+      }
+      return value;
+   }
+
+   template <typename Integer>
+   Integer fromDigits(const std::string& digits, std::false_type)
+   {
+      // blocks of 18 digits always fit into int64_t.
+      constexpr std::size_t block_length = 18;
+      const bool negative = (digits.front() == '-');
+      std::size_t position = (digits.front() == '-' || digits.front() == '+') ? 1 : 0;
+      Integer value(0);
+      while ( position < digits.size() )
+      {
+         const auto length = std::min(block_length, digits.size() - position);
+         int64_t block = 0;
+         int64_t scale = 1;
+         std::from_chars(digits.data() + position, digits.data() + position + length, block);
+         for ( std::size_t i = 0; i < length; ++i )
+         {
+            scale *= 10;
+         }
+         value = value * Integer(scale) + Integer(block);
+         position += length;
+      }
+      return negative ? -value : value;
+   }
+}
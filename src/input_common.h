@@ -58,10 +58,19 @@ namespace panda
       void errorWithLineInformation(const std::string&, const std::string&);
 
       /// Brings a row into normal form (c^T x <= b).
-      Row<int> normalize(Row<int>, RelationOperator);
+      template <typename Integer>
+      Row<Integer> normalize(Row<Integer>, RelationOperator);
       /// Converts a string into an integer. Empty string, '+' and '-' are considered
       /// valid numbers (1, 1, -1 respectively).
       int toInt(const std::string&);
+      /// Converts a string into an integer of the given type. Empty string, '+' and '-'
+      /// are considered valid numbers (1, 1, -1 respectively).
+      template <typename Integer>
+      Integer toInteger(const std::string&);
+      /// Reads an integer like "operator>>", but directly into the given integer type.
+      /// Throws if the number does not fit into the type.
+      template <typename Integer>
+      std::istream& readInteger(std::istream&, Integer&);
 
       /// Consume all tokens until the next token is a keyword.
       std::istream& advanceToNextKeyword(std::istream&, std::string&);
@@ -73,4 +82,5 @@ namespace panda
 }
 
 #include "input_common.tpp"
+#include "input_common.eti"
 
@@ -4,7 +4,9 @@
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
 //-------------------------------------------------------------------------------//
 
+#define COMPILE_TEMPLATE_INPUT_CONSISTENCY
 #include "input_consistency.h"
+#undef COMPILE_TEMPLATE_INPUT_CONSISTENCY
 
 #include <limits>
 #include <stdexcept>
@@ -20,7 +22,8 @@ namespace
 }
 
 /// A convex hull is considered valid if non-empty and each vertex has the same dimension.
-void panda::input::implementation::checkConsistency(const ConvexHull<int>& conv)
+template <typename Integer>
+void panda::input::implementation::checkConsistency(const ConvexHull<Integer>& conv)
 {
    if ( conv.empty() )
    {
@@ -31,12 +34,14 @@ void panda::input::implementation::checkConsistency(const ConvexHull<int>& conv)
 }
 
 /// A mixed description (cone + conv) is considered valid if the dimension matches and |cone| + |conv| > 0.
-void panda::input::implementation::checkConsistency(const ConvexHull<int>& conv, const ConicalHull<int>& cone, const Names& names, const Maps& maps, const std::size_t dimension)
+template <typename Integer>
+void panda::input::implementation::checkConsistency(const ConvexHull<Integer>& conv, const ConicalHull<Integer>& cone, const Names& names, const Maps& maps, const std::size_t dimension)
 {
-   checkConsistency(conv, cone, {}, names, maps, dimension);
+   checkConsistency(conv, cone, Inequalities<Integer>{}, names, maps, dimension);
 }
 
-void panda::input::implementation::checkConsistency(const Inequalities<int>& inequalities, const Names& names, const std::size_t dimension)
+template <typename Integer>
+void panda::input::implementation::checkConsistency(const Inequalities<Integer>& inequalities, const Names& names, const std::size_t dimension)
 {
    if ( inequalities.empty() )
    {
@@ -54,7 +59,8 @@ void panda::input::implementation::checkConsistency(const Inequalities<int>& ine
    }
 }
 
-void panda::input::implementation::checkConsistency(const ConvexHull<int>& conv, const ConicalHull<int>& cone, const Inequalities<int>& inequalities, const Names& names, const Maps& maps, const std::size_t dimension)
+template <typename Integer>
+void panda::input::implementation::checkConsistency(const ConvexHull<Integer>& conv, const ConicalHull<Integer>& cone, const Inequalities<Integer>& inequalities, const Names& names, const Maps& maps, const std::size_t dimension)
 {
    if ( conv.empty() && cone.empty() )
    {
@@ -17,14 +17,20 @@ namespace panda
       namespace implementation
       {
          /// Checks the consistency of a convex hull description.
-         void checkConsistency(const ConvexHull<int>&);
+         template <typename Integer>
+         void checkConsistency(const ConvexHull<Integer>&);
          /// Checks the consistency of a convex/conical hull description.
-         void checkConsistency(const ConvexHull<int>&, const ConicalHull<int>&, const Names&, const Maps&, const std::size_t);
+         template <typename Integer>
+         void checkConsistency(const ConvexHull<Integer>&, const ConicalHull<Integer>&, const Names&, const Maps&, const std::size_t);
          /// Checks the consistency of an inequality description.
-         void checkConsistency(const Inequalities<int>&, const Names&, const std::size_t);
+         template <typename Integer>
+         void checkConsistency(const Inequalities<Integer>&, const Names&, const std::size_t);
          /// Checks the consistency of a polytope.
-         void checkConsistency(const ConvexHull<int>&, const ConicalHull<int>&, const Inequalities<int>&, const Names&, const Maps&, const std::size_t);
+         template <typename Integer>
+         void checkConsistency(const ConvexHull<Integer>&, const ConicalHull<Integer>&, const Inequalities<Integer>&, const Names&, const Maps&, const std::size_t);
       }
    }
 }
 
+#include "input_consistency.eti"
+
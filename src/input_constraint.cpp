@@ -24,15 +24,15 @@ namespace
 {
    template <ConstraintType>
    void keyword_condition(std::istream&);
-   template <ConstraintType>
-   Row<int> potentiallyNamedConstraint(std::istream&, const Names&);
+   template <ConstraintType, typename Integer>
+   Row<Integer> potentiallyNamedConstraint(std::istream&, const Names&);
 }
 
-template <ConstraintType type>
-Matrix<int> panda::input::implementation::constraints(std::istream& stream, const Names& names)
+template <ConstraintType type, typename Integer>
+Matrix<Integer> panda::input::implementation::constraints(std::istream& stream, const Names& names)
 {
    keyword_condition<type>(stream);
-   Matrix<int> rows;
+   Matrix<Integer> rows;
    std::string token;
    while ( stream && !isKeyword(trimWhitespace(peekLine(stream))) )
    {
@@ -41,7 +41,7 @@ Matrix<int> panda::input::implementation::constraints(std::istream& stream, cons
          std::getline(stream, token);
          continue;
       }
-      const auto row = potentiallyNamedConstraint<type>(stream, names);
+      const auto row = potentiallyNamedConstraint<type, Integer>(stream, names);
       if ( !row.empty() )
       {
          rows.push_back(row);
@@ -92,16 +92,16 @@ namespace
       }
    }
 
-   template <ConstraintType type>
-   Row<int> potentiallyNamedConstraint(std::istream& stream, const Names& names)
+   template <ConstraintType type, typename Integer>
+   Row<Integer> potentiallyNamedConstraint(std::istream& stream, const Names& names)
    {
       if ( names.empty() || !input::containsNames(names, stream) )
       {
-         return input::implementation::constraint<type>(stream);
+         return input::implementation::constraint<type, Integer>(stream);
       }
       else
       {
-         return input::implementation::constraint<type>(stream, names);
+         return input::implementation::constraint<type, Integer>(stream, names);
       }
    }
 }
@@ -19,8 +19,8 @@ namespace panda
       namespace implementation
       {
          /// Reads constraints in PANDA format.
-         template <ConstraintType>
-         Matrix<int> constraints(std::istream&, const Names&);
+         template <ConstraintType, typename Integer>
+         Matrix<Integer> constraints(std::istream&, const Names&);
       }
    }
 }
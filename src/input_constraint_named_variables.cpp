@@ -4,7 +4,9 @@
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
 //-------------------------------------------------------------------------------//
 
+#define COMPILE_TEMPLATE_INPUT_CONSTRAINT_NAMED_VARIABLES
 #include "input_constraint_named_variables.h"
+#undef COMPILE_TEMPLATE_INPUT_CONSTRAINT_NAMED_VARIABLES
 
 #include <algorithm>
 #include <cassert>
@@ -22,33 +24,29 @@ using namespace panda;
 namespace
 {
    using Index = std::size_t;
-   using Coefficient = int;
    using Token = std::string;
    using Identifier = std::string;
+   template <typename Coefficient>
    std::pair<Index, Coefficient> term(const Token&, const Names&, const Identifier&);
-   Row<int> constraint(std::istream&, const Names&, ConstraintType);
+   template <typename Integer>
+   Row<Integer> constraint(std::istream&, const Names&, ConstraintType);
 }
 
-template <>
-Row<int> panda::input::implementation::constraint<ConstraintType::Equation>(std::istream& stream, const Names& names)
+template <ConstraintType type, typename Integer>
+Row<Integer> panda::input::implementation::constraint(std::istream& stream, const Names& names)
 {
-   return ::constraint(stream, names, ConstraintType::Equation);
-}
-
-template <>
-Row<int> panda::input::implementation::constraint<ConstraintType::Inequality>(std::istream& stream, const Names& names)
-{
-   return ::constraint(stream, names, ConstraintType::Inequality);
+   return ::constraint<Integer>(stream, names, type);
 }
 
 namespace
 {
    using namespace input;
+   template <typename Coefficient>
    std::pair<Index, Coefficient> term(const Token& token, const Names& names, const Identifier& id)
    {
       assert( !token.empty() );
       const auto end_of_factor = token.find_first_not_of("+-0123456789");
-      const auto factor = toInt(token.substr(0, end_of_factor));
+      const auto factor = toInteger<Coefficient>(token.substr(0, end_of_factor));
       if ( end_of_factor == std::string::npos ) // this is the RHS (because there is no name).
       {
          // c.f. algorithm_inequality_operations.tpp: the rhs is stored negated.
@@ -64,9 +62,11 @@ namespace
       return std::make_pair(index, factor);
    }
 
-   Row<int> constraint(std::istream& stream, const Names& names, ConstraintType type)
+   template <typename Integer>
+   Row<Integer> constraint(std::istream& stream, const Names& names, ConstraintType type)
    {
-      Inequality<int> ieq(names.size() + 1, 0);
+      using Coefficient = Integer;
+      Inequality<Integer> ieq(names.size() + 1, Integer(0));
       auto relation = RelationOperator::Undecided;
       bool has_rhs = false;
       skipWhitespace(stream);
@@ -75,7 +75,7 @@ namespace
       auto line = peekLine(stream);
       if ( line.empty() )
       {
-         return Row<int>{};
+         return Row<Integer>{};
       }
       for ( ; stream && !isEndOfLine(stream) && !isEndOfFile(stream); skipWhitespace(stream) )
       {
@@ -104,19 +104,19 @@ namespace
          {
             bool is_plus = token == "+";
             stream >> token;
-            std::tie(index, coefficient) = term(token, names, id);
+            std::tie(index, coefficient) = term<Coefficient>(token, names, id);
             if ( coefficient < 0 )
             {
                errorWithLineInformation<std::invalid_argument>("Excessive \"+\" or \"-\"", id);
             }
             if ( !is_plus )
             {
-               coefficient *= -1;
+               coefficient *= Coefficient(-1);
             }
          }
          else
          {
-            std::tie(index, coefficient) = term(token, names, id);
+            std::tie(index, coefficient) = term<Coefficient>(token, names, id);
          }
          if ( ieq[index] != 0 && index + 1 < ieq.size() )
          {
@@ -19,15 +19,11 @@ namespace panda
       namespace implementation
       {
          /// Reads a row which use variable names.
-         template <ConstraintType>
-         Row<int> constraint(std::istream&, const Names&);
-
-         // specializations
-         template <>
-         Row<int> constraint<ConstraintType::Equation>(std::istream&, const Names&);
-         template <>
-         Row<int> constraint<ConstraintType::Inequality>(std::istream&, const Names&);
+         template <ConstraintType, typename Integer>
+         Row<Integer> constraint(std::istream&, const Names&);
       }
    }
 }
 
+#include "input_constraint_named_variables.eti"
+
@@ -4,7 +4,9 @@
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
 //-------------------------------------------------------------------------------//
 
+#define COMPILE_TEMPLATE_INPUT_CONSTRAINT_UNNAMED_VARIABLES
 #include "input_constraint_unnamed_variables.h"
+#undef COMPILE_TEMPLATE_INPUT_CONSTRAINT_UNNAMED_VARIABLES
 
 #include <stdexcept>
 
@@ -14,19 +16,14 @@ using namespace panda;
 
 namespace
 {
-   Row<int> constraint(std::istream&, ConstraintType);
+   template <typename Integer>
+   Row<Integer> constraint(std::istream&, ConstraintType);
 }
 
-template <>
-Row<int> panda::input::implementation::constraint<ConstraintType::Equation>(std::istream& stream)
+template <ConstraintType type, typename Integer>
+Row<Integer> panda::input::implementation::constraint(std::istream& stream)
 {
-   return ::constraint(stream, ConstraintType::Equation);
-}
-
-template <>
-Row<int> panda::input::implementation::constraint<ConstraintType::Inequality>(std::istream& stream)
-{
-   return ::constraint(stream, ConstraintType::Inequality);
+   return ::constraint<Integer>(stream, type);
 }
 
 namespace
@@ -35,10 +32,11 @@ namespace
    /// Raw format (no names, no relation operator) and PANDA format without names.
    /// This only differs in the presence of the missing relation operator.
    /// We allow a leading "()"-enclosed identifier in both cases.
-   Row<int> constraint(std::istream& stream, ConstraintType type)
+   template <typename Integer>
+   Row<Integer> constraint(std::istream& stream, ConstraintType type)
    {
       using namespace input;
-      Inequality<int> ieq;
+      Inequality<Integer> ieq;
       RelationOperator relation = RelationOperator::Undecided;
       bool has_rhs = false;
       skipWhitespace(stream);
@@ -64,8 +62,8 @@ namespace
          }
          else
          {
-            int coefficient;
-            if ( !(stream >> coefficient) )
+            Integer coefficient;
+            if ( !readInteger(stream, coefficient) )
             {
                errorWithLineInformation<std::invalid_argument>("Non-integral token in inequality", id);
             }
@@ -87,11 +85,11 @@ namespace
       }
       if ( ieq.empty() )
       {
-         return Row<int>{};
+         return Row<Integer>{};
       }
       if ( relation != RelationOperator::Undecided ) // invert the last entry if input was in PANDA format
       {
-         ieq.back() *= -1;
+         ieq.back() *= Integer(-1);
       }
       return normalize(ieq, relation);
    }
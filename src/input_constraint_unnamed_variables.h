@@ -18,15 +18,11 @@ namespace panda
       namespace implementation
       {
          /// Reads a row that is represented by its coefficients (without names).
-         template <ConstraintType>
-         Row<int> constraint(std::istream&);
-
-         // specializations
-         template <>
-         Row<int> constraint<ConstraintType::Equation>(std::istream&);
-         template <>
-         Row<int> constraint<ConstraintType::Inequality>(std::istream&);
+         template <ConstraintType, typename Integer>
+         Row<Integer> constraint(std::istream&);
       }
    }
 }
 
+#include "input_constraint_unnamed_variables.eti"
+
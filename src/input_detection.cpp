@@ -86,6 +86,10 @@ InputOrder panda::getInputOrder(int argc, char** argv)
       {
          // handled by recursion::sampling(), skip here
       }
+      else if ( std::strncmp(argv[i], "--sub-masters", 13) == 0 )
+      {
+         // handled by hierarchy::subMasters(), skip here
+      }
       else if ( std::strncmp(argv[i], "-s", 2) == 0 || std::strncmp(argv[i], "--s", 3) == 0 )
       {
          throw std::invalid_argument("Illegal parameter. Did you mean \"-s <order>\" or \"--sorting=<order>\"?");
@@ -101,6 +105,11 @@ OperationMode panda::detectOperationMode(int argc, char** argv)
    {
       return cmd_mode;
    }
+   return detectOperationModeOfFile(argc, argv);
+}
+
+OperationMode panda::detectOperationModeOfFile(int argc, char** argv)
+{
    const auto filename = getFilename(argc, argv);
    std::ifstream file(filename.c_str());
    const auto words = keywords(file);
@@ -258,6 +267,13 @@ namespace
             return OperationMode::Version;
          }
       }
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strncmp(argv[i], "--expand=", 9) == 0 )
+         {
+            return OperationMode::Expansion;
+         }
+      }
       return OperationMode::Undecided;
    }
 }
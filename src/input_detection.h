@@ -18,5 +18,8 @@ namespace panda
    InputOrder getInputOrder(int, char**);
    /// Returns the user-provided operation mode.
    OperationMode detectOperationMode(int, char**);
+   /// Returns the operation mode that fits the description in the input file
+   /// (facet enumeration for vertices / rays, vertex enumeration for inequalities).
+   OperationMode detectOperationModeOfFile(int, char**);
 }
 
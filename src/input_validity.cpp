@@ -4,7 +4,9 @@
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
 //-------------------------------------------------------------------------------//
 
+#define COMPILE_TEMPLATE_INPUT_VALIDITY
 #include "input_validity.h"
+#undef COMPILE_TEMPLATE_INPUT_VALIDITY
 
 #include <algorithm>
 #include <cstring>
@@ -16,20 +18,26 @@
 #include "algorithm_map_operations.h"
 #include "algorithm_matrix_operations.h"
 #include "algorithm_row_operations.h"
+#include "row_index.h"
 
 using namespace panda;
 
 namespace
 {
-   bool inequalityIsValid(const Matrix<int>&, const Inequality<int>&, const std::size_t);
-   void checkValidityOfInequality(const Matrix<int>&, const Inequality<int>&, const std::size_t);
-   void checkValidityOfVertex(const Matrix<int>&, const Vertex<int>&, const std::size_t);
-   void checkValidityInequalities(const Matrix<int>&, const Map&);
-   void checkValidityVertices(const Matrix<int>&, const Map&);
+   template <typename Integer>
+   bool inequalityIsValid(const Matrix<Integer>&, const Inequality<Integer>&, const std::size_t);
+   template <typename Integer>
+   void checkValidityOfInequality(const Matrix<Integer>&, const Inequality<Integer>&, const std::size_t);
+   template <typename Integer>
+   void checkValidityOfVertex(const Matrix<Integer>&, const Vertex<Integer>&, const std::size_t);
+   /// Checks that each map is a bijection on the rows (looked up in a hash index).
+   template <typename Integer, typename TagType>
+   void checkValidityClasses(const Matrix<Integer>&, const Maps&, TagType, const char*, int);
 }
 
 /// Input is considered valid if and only if each inequality is facet-defining.
-void panda::input::implementation::checkValidityOfInequalities(const Matrix<int>& matrix, const Inequalities<int>& inequalities)
+template <typename Integer>
+void panda::input::implementation::checkValidityOfInequalities(const Matrix<Integer>& matrix, const Inequalities<Integer>& inequalities)
 {
    if ( inequalities.empty() )
    {
@@ -43,7 +51,8 @@ void panda::input::implementation::checkValidityOfInequalities(const Matrix<int>
 }
 
 /// Input is considered valid if and only if each vertex / ray is extremal.
-void panda::input::implementation::checkValidityOfVertices(const Matrix<int>& matrix, const Vertices<int>& vertices)
+template <typename Integer>
+void panda::input::implementation::checkValidityOfVertices(const Matrix<Integer>& matrix, const Vertices<Integer>& vertices)
 {
    if ( vertices.empty() )
    {
@@ -57,25 +66,22 @@ void panda::input::implementation::checkValidityOfVertices(const Matrix<int>& ma
 }
 
 /// Input is considered valid if and only if each map is a bijection on the set of inequalities.
-void panda::input::implementation::checkValidityOfInequalityClasses(const Inequalities<int>& inequalities, const Maps& maps)
+template <typename Integer>
+void panda::input::implementation::checkValidityOfInequalityClasses(const Inequalities<Integer>& inequalities, const Maps& maps, const int thread_count)
 {
-   for ( const auto& map : maps )
-   {
-      checkValidityInequalities(inequalities, map);
-   }
+   checkValidityClasses(inequalities, maps, tag::facet{}, "inequalities", thread_count);
 }
 
 /// Input is considered valid if and only if each map is a bijection on the set of vertices.
-void panda::input::implementation::checkValidityOfVertexClasses(const Vertices<int>& vertices, const Maps& maps)
+template <typename Integer>
+void panda::input::implementation::checkValidityOfVertexClasses(const Vertices<Integer>& vertices, const Maps& maps, const int thread_count)
 {
-   for ( const auto& map : maps )
-   {
-      checkValidityVertices(vertices, map);
-   }
+   checkValidityClasses(vertices, maps, tag::vertex{}, "vertices / rays", thread_count);
 }
 
 /// Input is considered valid if and only if each inequality is facet-defining.
-void panda::input::implementation::filterInvalidInequalities(const Matrix<int>& matrix, Inequalities<int>& inequalities)
+template <typename Integer>
+void panda::input::implementation::filterInvalidInequalities(const Matrix<Integer>& matrix, Inequalities<Integer>& inequalities)
 {
    if ( inequalities.empty() )
    {
@@ -97,7 +103,8 @@ void panda::input::implementation::filterInvalidInequalities(const Matrix<int>&
 }
 
 /// Input is considered valid analogous to the case of inequalities.
-void panda::input::implementation::filterInvalidVertices(const Matrix<int>& matrix, Vertices<int>& vertices)
+template <typename Integer>
+void panda::input::implementation::filterInvalidVertices(const Matrix<Integer>& matrix, Vertices<Integer>& vertices)
 {
    filterInvalidInequalities(matrix, vertices);
 }
@@ -128,11 +135,12 @@ bool panda::input::filterInvalidInput(int argc, char** argv) noexcept
 
 namespace
 {
-   bool inequalityIsValid(const Matrix<int>& matrix, const Inequality<int>& inequality, const std::size_t dimension)
+   template <typename Integer>
+   bool inequalityIsValid(const Matrix<Integer>& matrix, const Inequality<Integer>& inequality, const std::size_t dimension)
    {
       // identify vertices and rays that satisfy the inequality with equality
       // check if any distance is less than 0
-      Matrix<int> active;
+      Matrix<Integer> active;
       for ( const auto& row : matrix )
       {
          const auto dist = algorithm::distance(inequality, row);
@@ -149,11 +157,12 @@ namespace
       return !active.empty() && (algorithm::dimension(active) + 1 == dimension);
    }
 
-   void checkValidityOfInequality(const Matrix<int>& matrix, const Inequality<int>& inequality, const std::size_t dimension)
+   template <typename Integer>
+   void checkValidityOfInequality(const Matrix<Integer>& matrix, const Inequality<Integer>& inequality, const std::size_t dimension)
    {
       // identify vertices and rays that satisfy the inequality with equality
       // check if any distance is less than 0
-      Matrix<int> active;
+      Matrix<Integer> active;
       for ( const auto& row : matrix )
       {
          const auto dist = algorithm::distance(inequality, row);
@@ -182,9 +191,10 @@ namespace
       }
    }
 
-   void checkValidityOfVertex(const Matrix<int>& matrix, const Vertex<int>& vertex, const std::size_t dimension)
+   template <typename Integer>
+   void checkValidityOfVertex(const Matrix<Integer>& matrix, const Vertex<Integer>& vertex, const std::size_t dimension)
    {
-      Matrix<int> active;
+      Matrix<Integer> active;
       for ( const auto& row : matrix )
       {
          const auto dist = algorithm::distance(row, vertex);
@@ -213,58 +223,34 @@ namespace
       }
    }
 
-   void checkValidityInequalities(const Matrix<int>& matrix, const Map& map)
+   template <typename Integer, typename TagType>
+   void checkValidityClasses(const Matrix<Integer>& matrix, const Maps& maps, TagType tag, const char* set_name, const int thread_count)
    {
-      std::vector<std::size_t> indices(matrix.size());
-      for ( std::size_t i = 0; i < matrix.size(); ++i )
+      const auto all_indices = algorithm::images(maps, matrix, tag, thread_count);
+      for ( std::size_t m = 0; m < maps.size(); ++m )
       {
-         const auto& row = matrix[i];
-         const auto mapped_row = algorithm::apply(map, row, tag::facet{});
-         const auto offset = std::find(matrix.cbegin(), matrix.cend(), mapped_row) - matrix.cbegin();
-         indices[i] = static_cast<std::size_t>(offset);
-         if ( indices[i] >= matrix.size() )
+         const auto& map = maps[m];
+         auto indices = all_indices[m];
+         for ( std::size_t i = 0; i < matrix.size(); ++i )
          {
-            std::stringstream stream;
-            stream << "Map invalid: " << map << " maps " << row << " to " << mapped_row << " which is not present in the set of inequalities.";
-            throw std::invalid_argument(stream.str());
+            if ( indices[i] == RowIndex<Integer>::npos )
+            {
+               const auto& row = matrix[i];
+               const auto mapped_row = algorithm::apply(map, row, tag);
+               std::stringstream stream;
+               stream << "Map invalid: " << map << " maps " << row << " to " << mapped_row << " which is not present in the set of " << set_name << '.';
+               throw std::invalid_argument(stream.str());
+            }
          }
-      }
-      std::sort(indices.begin(), indices.end());
-      for ( std::size_t i = 0; i < indices.size(); ++i )
-      {
-         if ( indices[i] != i )
+         std::sort(indices.begin(), indices.end());
+         for ( std::size_t i = 0; i < indices.size(); ++i )
          {
-            std::stringstream stream;
-            stream << "Map invalid: " << map << " is not a bijection on the set of inequalities.";
-            throw std::invalid_argument(stream.str());
-         }
-      }
-   }
-
-   void checkValidityVertices(const Matrix<int>& matrix, const Map& map)
-   {
-      std::vector<std::size_t> indices(matrix.size());
-      for ( std::size_t i = 0; i < matrix.size(); ++i )
-      {
-         const auto& row = matrix[i];
-         const auto mapped_row = algorithm::apply(map, row, tag::vertex{});
-         const auto offset = std::find(matrix.cbegin(), matrix.cend(), mapped_row) - matrix.cbegin();
-         indices[i] = static_cast<std::size_t>(offset);
-         if ( indices[i] >= matrix.size() )
-         {
-            std::stringstream stream;
-            stream << "Map invalid: " << map << " maps " << row << " to " << mapped_row << " which is not present in the set of vertices / rays.";
-            throw std::invalid_argument(stream.str());
-         }
-      }
-      std::sort(indices.begin(), indices.end());
-      for ( std::size_t i = 0; i < indices.size(); ++i )
-      {
-         if ( indices[i] != i )
-         {
-            std::stringstream stream;
-            stream << "Map invalid: " << map << " is not a bijection on the set of vertices / rays.";
-            throw std::invalid_argument(stream.str());
+            if ( indices[i] != i )
+            {
+               std::stringstream stream;
+               stream << "Map invalid: " << map << " is not a bijection on the set of " << set_name << '.';
+               throw std::invalid_argument(stream.str());
+            }
          }
       }
    }
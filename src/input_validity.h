@@ -16,18 +16,24 @@ namespace panda
    {
       namespace implementation
       {
-         /// Checks the validity of a set of maps on an inequality description.
-         void checkValidityOfInequalityClasses(const Inequalities<int>&, const Maps&);
-         /// Checks the validity of a set of maps on an inner description.
-         void checkValidityOfVertexClasses(const Vertices<int>&, const Maps&);
+         /// Checks the validity of a set of maps on an inequality description (maps in parallel).
+         template <typename Integer>
+         void checkValidityOfInequalityClasses(const Inequalities<Integer>&, const Maps&, int thread_count);
+         /// Checks the validity of a set of maps on an inner description (maps in parallel).
+         template <typename Integer>
+         void checkValidityOfVertexClasses(const Vertices<Integer>&, const Maps&, int thread_count);
          /// Checks the validity of a set of inequalities.
-         void checkValidityOfInequalities(const Matrix<int>&, const Inequalities<int>&);
+         template <typename Integer>
+         void checkValidityOfInequalities(const Matrix<Integer>&, const Inequalities<Integer>&);
          /// Checks the validity of a set of vertices.
-         void checkValidityOfVertices(const Matrix<int>&, const Vertices<int>&);
+         template <typename Integer>
+         void checkValidityOfVertices(const Matrix<Integer>&, const Vertices<Integer>&);
          /// Filters inequalities that are invalid.
-         void filterInvalidInequalities(const Matrix<int>&, Inequalities<int>&);
+         template <typename Integer>
+         void filterInvalidInequalities(const Matrix<Integer>&, Inequalities<Integer>&);
          /// Filters vertices that are invalid.
-         void filterInvalidVertices(const Matrix<int>&, Vertices<int>&);
+         template <typename Integer>
+         void filterInvalidVertices(const Matrix<Integer>&, Vertices<Integer>&);
       }
 
       /// Returns true if the user provided the --check parameter.
@@ -37,3 +43,5 @@ namespace panda
    }
 }
 
+#include "input_validity.eti"
+
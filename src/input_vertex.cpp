@@ -4,7 +4,9 @@
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
 //-------------------------------------------------------------------------------//
 
+#define COMPILE_TEMPLATE_INPUT_VERTEX
 #include "input_vertex.h"
+#undef COMPILE_TEMPLATE_INPUT_VERTEX
 
 #include <cassert>
 #include <stdexcept>
@@ -19,12 +21,14 @@ using namespace panda;
 
 namespace
 {
-   Row<int> vertex(std::istream&);
+   template <typename Integer>
+   Row<Integer> vertex(std::istream&);
 }
 
-ConicalHull<int> panda::input::implementation::verticesConical(std::istream& stream)
+template <typename Integer>
+ConicalHull<Integer> panda::input::implementation::verticesConical(std::istream& stream)
 {
-   ConicalHull<int> cone;
+   ConicalHull<Integer> cone;
    std::string token;
    if ( !std::getline(stream, token) )
    {
@@ -42,10 +46,10 @@ ConicalHull<int> panda::input::implementation::verticesConical(std::istream& str
          std::getline(stream, token);
          continue;
       }
-      auto ray = ::vertex(stream);
+      auto ray = ::vertex<Integer>(stream);
       if ( !ray.empty() )
       {
-         ray.back() = 0;
+         ray.back() = Integer(0);
          cone.push_back(ray);
       }
       else
@@ -60,9 +64,10 @@ ConicalHull<int> panda::input::implementation::verticesConical(std::istream& str
    return cone;
 }
 
-ConvexHull<int> panda::input::implementation::verticesConvex(std::istream& stream)
+template <typename Integer>
+ConvexHull<Integer> panda::input::implementation::verticesConvex(std::istream& stream)
 {
-   ConvexHull<int> conv;
+   ConvexHull<Integer> conv;
    std::string token;
    if ( !std::getline(stream, token) )
    {
@@ -80,7 +85,7 @@ ConvexHull<int> panda::input::implementation::verticesConvex(std::istream& strea
          std::getline(stream, token);
          continue;
       }
-      auto vertex = ::vertex(stream);
+      auto vertex = ::vertex<Integer>(stream);
       if ( !vertex.empty() )
       {
          conv.push_back(vertex);
@@ -93,12 +98,13 @@ ConvexHull<int> panda::input::implementation::verticesConvex(std::istream& strea
    return conv;
 }
 
-ConvexHull<int> panda::input::implementation::vertices(std::istream& stream)
+template <typename Integer>
+ConvexHull<Integer> panda::input::implementation::vertices(std::istream& stream)
 {
-   ConvexHull<int> conv;
+   ConvexHull<Integer> conv;
    while ( stream )
    {
-      const auto vertex = ::vertex(stream);
+      const auto vertex = ::vertex<Integer>(stream);
       if ( !vertex.empty() )
       {
          conv.push_back(vertex);
@@ -110,22 +116,22 @@ ConvexHull<int> panda::input::implementation::vertices(std::istream& stream)
 namespace
 {
    using namespace input;
-   Row<int> vertex(std::istream& stream)
+   template <typename Integer>
+   Row<Integer> vertex(std::istream& stream)
    {
       skipWhitespace(stream);
       const auto id = isIdentifier(stream) ? identifier(stream) : "";
       skipWhitespace(stream);
-      Row<int> numerator;
-      Row<int> denominator;
-      for ( int tmp; stream >> tmp; )
+      Row<Integer> numerator;
+      Row<Integer> denominator;
+      for ( Integer tmp; readInteger(stream, tmp); )
       {
          numerator.push_back(tmp);
          skipWhitespace(stream);
          if ( stream.peek() == '/' )
          {
             stream.get(); // consume division operator
-            stream >> tmp;
-            if ( tmp == 0 )
+            if ( !readInteger(stream, tmp) || tmp == 0 )
             {
                errorWithLineInformation<std::invalid_argument>("Division by zero", id);
             }
@@ -133,7 +139,7 @@ namespace
          }
          else
          {
-            denominator.push_back(1);
+            denominator.push_back(Integer(1));
          }
          skipWhitespace(stream);
          if ( stream.peek() == '\n' )
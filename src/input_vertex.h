@@ -17,12 +17,17 @@ namespace panda
       namespace implementation
       {
          /// Returns a conical hull (PANDA format).
-         ConicalHull<int> verticesConical(std::istream&);
+         template <typename Integer>
+         ConicalHull<Integer> verticesConical(std::istream&);
          /// Returns a convex hull (PANDA format).
-         ConvexHull<int> verticesConvex(std::istream&);
+         template <typename Integer>
+         ConvexHull<Integer> verticesConvex(std::istream&);
          /// Returns a convex hull (raw format).
-         ConvexHull<int> vertices(std::istream&);
+         template <typename Integer>
+         ConvexHull<Integer> vertices(std::istream&);
       }
    }
 }
 
+#include "input_vertex.eti"
+
@@ -11,13 +11,26 @@
 //#define BENCHMARK_LOAD_BALANCING
 
 #include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <utility>
 
 #include "algorithm_row_operations.h"
+#include "master_hierarchy.h"
 
 using namespace panda;
 
+namespace
+{
+   /// Duration of a round trip to a slave that the batch size aims for.
+   constexpr BatchSize::Duration target_round_trip(0.05);
+   /// Maximal number of jobs sent to a slave at once.
+   constexpr std::size_t maximum_batch_size = 256;
+}
+
 template <typename Integer, typename TagType>
 void panda::JobManager<Integer, TagType>::put(const Matrix<Integer>& matrix) const
 {
@@ -33,48 +46,90 @@ void panda::JobManager<Integer, TagType>::put(const Row<Integer>& row) const
 template <typename Integer, typename TagType>
 Row<Integer> panda::JobManager<Integer, TagType>::get() const
 {
-   return rows.get();
+   const auto start = Clock::now();
+   auto job = rows.get();
+   idle_time.record(Clock::now() - start);
+   return job;
 }
 
-#ifndef MPI_SUPPORT
-   #pragma GCC diagnostic push
-   #pragma GCC diagnostic ignored "-Wunused-parameter"
-   #pragma clang diagnostic push
-   #pragma clang diagnostic ignored "-Wunused-parameter"
-#endif
 template <typename Integer, typename TagType>
-panda::JobManager<Integer, TagType>::JobManager(const Names& names_, const int number_of_processors, const int threads_per_processor, const std::optional<VertexGroup>& vertex_group_, const Matrix<Integer>& vertices_)
+panda::JobManager<Integer, TagType>::JobManager(const Names& names_, const int number_of_processors, const int threads_per_processor, const std::optional<VertexGroup>& vertex_group_, const Matrix<Integer>& vertices_, const std::optional<std::chrono::seconds>& lease_duration_, const std::size_t prefetch_depth_, const int sub_masters_)
 :
    communication(),
    rows(names_, vertex_group_, vertices_),
+   number_of_nodes(number_of_processors),
+   sub_masters(sub_masters_),
+   lease_duration(lease_duration_),
+   prefetch_depth(prefetch_depth_),
+   idle_time(),
+   lease_mutex(),
+   next_lease(1),
+   leases(),
+   lease_clock(lease_duration_ ? std::optional<LeaseClock::Clock::duration>(*lease_duration_) : std::nullopt),
+   failed_nodes(),
    request_threads() // vital implementation detail: threads may access other members, hence, the threads must be destroyed first (Destruction in reverse order of construction).
 {
-   #ifdef MPI_SUPPORT
    assert( number_of_processors > 0 );
    assert( threads_per_processor > 0 );
-   for ( int id = 1; id < number_of_processors; ++id ) // for all nodes except the master
+   for ( const auto id : hierarchy::slaves(0, number_of_processors, sub_masters) )
    {
+      // a sub-master hands the jobs on to its slaves, hence it takes larger batches.
+      const auto group_size = 1 + hierarchy::slaves(id, number_of_processors, sub_masters).size();
       for ( int i = 0; i < threads_per_processor; ++i )
       {
-         request_threads.emplace_front([&,id]() // capture id by value, as it is a local variable
+         request_threads.emplace_front([&,id,group_size]() // capture by value, as these are local variables
          {
             #ifdef BENCHMARK_LOAD_BALANCING
             std::size_t count(0);
             #endif
-            while ( true )
+            // the batches sent ahead wait at the slave, hence their round trips take longer.
+            BatchSize batch_size(static_cast<double>(prefetch_depth + 1) * target_round_trip, group_size * maximum_batch_size);
+            // batches sent by this thread whose results haven't been received yet.
+            std::size_t outstanding = 0;
+            bool failed = false;
+            while ( !failed )
             {
-               const auto facet = rows.get();
-               communication.toSlave(facet, id);
-               if ( facet.empty() ) // if facet is empty, the slave will stop working.
+               // further batches are only sent ahead if jobs are available right now, as the
+               // results of the outstanding ones may be needed to create new jobs.
+               while ( outstanding <= prefetch_depth )
+               {
+                  const auto jobs = ( outstanding == 0 ) ? rows.get(batch_size.get()) : rows.tryGet(batch_size.get());
+                  if ( jobs.empty() )
+                  {
+                     break;
+                  }
+                  const auto lease = open(jobs, id);
+                  if ( !lease || !communication.toSlave(jobs, *lease, id, deadline(id)) )
+                  {
+                     failed = true;
+                     break;
+                  }
+                  ++outstanding;
+                  #ifdef BENCHMARK_LOAD_BALANCING
+                  count += jobs.size();
+                  #endif
+               }
+               if ( failed || outstanding == 0 ) // all jobs are done.
                {
                   break;
                }
-               #ifdef BENCHMARK_LOAD_BALANCING
-               ++count;
-               #endif
-               const auto results = communication.fromSlave<Integer>(id);
-               put(results);
+               // the results may belong to the lease of another thread serving the same node.
+               auto results = communication.fromSlave<Integer>(id, deadline(id));
+               if ( !results )
+               {
+                  failed = true;
+                  break;
+               }
+               --outstanding;
+               const auto done = close(std::move(*results));
+               batch_size.record(done.first, done.second);
+            }
+            if ( failed )
+            {
+               expire(id);
             }
+            // an empty batch makes the slave thread stop (even if the node has been given up on).
+            communication.toSlave(Matrix<Integer>{}, 0, id, deadline(id));
             #ifdef BENCHMARK_LOAD_BALANCING
             std::stringstream stream;
             stream << "Node " << id << ": " << count << '\n';
@@ -83,10 +138,104 @@ panda::JobManager<Integer, TagType>::JobManager(const Names& names_, const int n
          });
       }
    }
-   #endif // MPI_SUPPORT
 }
-#ifndef MPI_SUPPORT
-   #pragma GCC diagnostic pop
-   #pragma clang diagnostic pop
-#endif
+
+template <typename Integer, typename TagType>
+panda::JobManager<Integer, TagType>::~JobManager()
+{
+   if ( number_of_nodes > 1 )
+   {
+      std::stringstream stream;
+      stream << "Node 0: waiting for jobs " << std::fixed << std::setprecision(1) << 100.0 * idle_time.fraction() << "% of the time\n";
+      std::cerr << stream.str();
+   }
+}
+
+template <typename Integer, typename TagType>
+std::optional<std::size_t> panda::JobManager<Integer, TagType>::open(const Matrix<Integer>& jobs, const int node) const
+{
+   {
+      std::lock_guard<std::mutex> lock(lease_mutex);
+      if ( failed_nodes.count(node) == 0 )
+      {
+         const auto id = next_lease++;
+         const auto now = Clock::now();
+         leases.emplace(id, Lease{jobs, node, now});
+         lease_clock.sent(node, now);
+         return id;
+      }
+   }
+   rows.requeue(jobs);
+   return std::nullopt;
+}
+
+template <typename Integer, typename TagType>
+std::pair<std::size_t, BatchSize::Duration> panda::JobManager<Integer, TagType>::close(Communication::Results<Integer>&& results) const
+{
+   std::size_t jobs = 0;
+   BatchSize::Duration elapsed(0);
+   {
+      std::lock_guard<std::mutex> lock(lease_mutex);
+      const auto it = leases.find(results.lease);
+      if ( it != leases.end() )
+      {
+         const auto now = Clock::now();
+         jobs = it->second.jobs.size();
+         elapsed = now - it->second.opened;
+         // the node is alive and starts on the next of its batches.
+         lease_clock.received(it->second.node, now);
+         leases.erase(it);
+      }
+   }
+   // the slave computed the canonical supports, hence only lookups are left here.
+   rows.put(results.rows, std::move(results.supports), jobs);
+   return std::make_pair(jobs, elapsed);
+}
+
+template <typename Integer, typename TagType>
+Communication::Deadline panda::JobManager<Integer, TagType>::deadline(const int node) const
+{
+   std::lock_guard<std::mutex> lock(lease_mutex);
+   auto end = lease_clock.deadline(node, Clock::now());
+   if ( end && hierarchy::isSubMaster(node, sub_masters) )
+   {
+      *end += *lease_duration;
+   }
+   return end;
+}
+
+template <typename Integer, typename TagType>
+void panda::JobManager<Integer, TagType>::expire(const int node) const
+{
+   Matrix<Integer> jobs;
+   {
+      std::lock_guard<std::mutex> lock(lease_mutex);
+      if ( !failed_nodes.insert(node).second )
+      {
+         return;
+      }
+      for ( auto it = leases.begin(); it != leases.end(); )
+      {
+         if ( it->second.node == node )
+         {
+            jobs.insert(jobs.end(), it->second.jobs.begin(), it->second.jobs.end());
+            it = leases.erase(it);
+         }
+         else
+         {
+            ++it;
+         }
+      }
+   }
+   communication.abandon(node);
+   // the slaves of a sub-master wait for it, hence they are given up on as well.
+   for ( const auto slave : hierarchy::slaves(node, number_of_nodes, sub_masters) )
+   {
+      communication.abandon(slave);
+   }
+   std::stringstream stream;
+   stream << "Node " << node << " missed the deadline of its lease, its " << jobs.size() << " jobs are handed out again.\n";
+   std::cerr << stream.str();
+   rows.requeue(jobs);
+}
 
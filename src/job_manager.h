@@ -6,11 +6,20 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <list>
+#include <map>
+#include <mutex>
 #include <optional>
+#include <set>
+#include <utility>
 
+#include "batch_size.h"
 #include "communication.h"
+#include "idle_time.h"
 #include "joining_thread.h"
+#include "lease_clock.h"
 #include "list.h"
 #include "matrix.h"
 #include "names.h"
@@ -20,6 +29,10 @@
 
 namespace panda
 {
+   /// Hands out the jobs to the threads of the master and to the slaves (or the sub-masters,
+   /// see SubMasterJobManager). Each batch sent to a slave is a lease: if the slave misses
+   /// its deadline (see LeaseClock), the master gives up on the slave and the jobs of its
+   /// leases are handed out again. Late results only add rows, which the list deduplicates.
    template <typename Integer, typename TagType>
    class JobManager
    {
@@ -35,10 +48,49 @@ namespace panda
          /// (only relevant for printing inequalities).
          /// The second argument must be the number of processors,
          /// the third argument must be the number of threads per processor.
-         JobManager(const Names&, const int, const int, const std::optional<VertexGroup>& vertex_group = std::nullopt, const Matrix<Integer>& vertices = Matrix<Integer>{});
+         /// The last arguments are the time a slave has for a batch (std::nullopt: no deadline),
+         /// the number of batches sent ahead to each thread of a slave and the number of
+         /// sub-masters (if any, the master serves these only).
+         JobManager(const Names&, const int, const int, const std::optional<VertexGroup>& vertex_group = std::nullopt, const Matrix<Integer>& vertices = Matrix<Integer>{}, const std::optional<std::chrono::seconds>& lease_duration = std::nullopt, std::size_t prefetch_depth = 1, int sub_masters = 0);
+         /// Destructor: reports the fraction of the time the threads of the master waited for jobs.
+         ~JobManager();
+      private:
+         using Clock = std::chrono::steady_clock;
+         /// A batch of jobs handed to a slave.
+         struct Lease
+         {
+            Matrix<Integer> jobs;
+            int node;
+            Clock::time_point opened;
+         };
+         /// Registers a lease of the jobs for the node and returns its ID (std::nullopt if the
+         /// node has been given up on, the jobs are handed out again then).
+         std::optional<std::size_t> open(const Matrix<Integer>&, int) const;
+         /// Merges the results of a lease with the list (only the rows if the lease expired).
+         /// Returns the number of jobs of the lease and the time since it was opened.
+         std::pair<std::size_t, BatchSize::Duration> close(Communication::Results<Integer>&&) const;
+         /// Returns the deadline of the node. A sub-master gets twice the lease, as it needs one
+         /// to give up on a slave of its own before the jobs are done by others.
+         Communication::Deadline deadline(int) const;
+         /// Gives up on the node (and the slaves of a sub-master): the jobs of its leases are
+         /// handed out again.
+         void expire(int) const;
       private:
          Communication communication;
          mutable List<Integer, TagType> rows;
+         const int number_of_nodes;
+         const int sub_masters;
+         const std::optional<std::chrono::seconds> lease_duration;
+         const std::size_t prefetch_depth;
+         mutable IdleTime idle_time;
+         mutable std::mutex lease_mutex;
+         mutable std::size_t next_lease;
+         /// leases that are neither closed nor expired.
+         mutable std::map<std::size_t, Lease> leases;
+         /// deadlines of the nodes.
+         mutable LeaseClock lease_clock;
+         /// nodes given up on.
+         mutable std::set<int> failed_nodes;
          mutable std::list<JoiningThread> request_threads;
       private:
          /// Copy construction is not allowed.
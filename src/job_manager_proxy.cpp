@@ -8,41 +8,128 @@
 #include "job_manager_proxy.h"
 #undef COMPILE_TEMPLATE_JOB_MANAGER_PROXY
 
-#ifdef MPI_SUPPORT
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#include "master_hierarchy.h"
+#include "message_passing_interface_session.h"
 
 using namespace panda;
 
+namespace
+{
+   /// Maximal number of raw supports whose canonical forms are kept.
+   constexpr std::size_t canonical_forms_capacity = std::size_t{1} << 16;
+   /// Maximal number of canonical supports of sent classes that are kept.
+   constexpr std::size_t sent_classes_capacity = std::size_t{1} << 16;
+}
+
 template <typename Integer, typename TagType>
 void panda::JobManagerProxy<Integer, TagType>::put(const Matrix<Integer>& container) const
 {
-   communication.toMaster(container);
+   auto& current = batch();
+   if ( !vertex_group )
+   {
+      current.results.insert(current.results.end(), container.begin(), container.end());
+      return;
+   }
+   // the canonical supports are computed here, hence the master only has to look them up.
+   std::vector<Support> supports;
+   supports.reserve(container.size());
+   for ( const auto& row : container )
+   {
+      supports.push_back(incidence.supportBitset(row));
+   }
+   canonical_forms.canonicalize(*vertex_group, supports);
+   for ( std::size_t i = 0; i < container.size(); ++i )
+   {
+      if ( sent_classes.find(supports[i]) ) // the master knows the class already.
+      {
+         continue;
+      }
+      // only the keys are of interest.
+      sent_classes.insert(supports[i], Support{});
+      current.results.push_back(container[i]);
+      current.supports.push_back(std::move(supports[i]));
+   }
 }
 
 template <typename Integer, typename TagType>
 Row<Integer> panda::JobManagerProxy<Integer, TagType>::get() const
 {
-   return communication.fromMaster<Integer>();
+   auto& current = batch();
+   if ( current.next == current.jobs.size() )
+   {
+      if ( !current.jobs.empty() )
+      {
+         // the master sends batches ahead, hence the next one is usually here already
+         // and computed while the results are uploaded.
+         communication.toMaster(current.results, current.supports, current.lease, master);
+         current.results.clear();
+         current.supports.clear();
+      }
+      const auto start = IdleTime::Clock::now();
+      std::tie(current.jobs, current.lease) = communication.fromMaster<Integer>(master);
+      idle_time.record(IdleTime::Clock::now() - start);
+      current.next = 0;
+      if ( current.jobs.empty() ) // the master has no more jobs.
+      {
+         reportStatistics();
+         return Row<Integer>{};
+      }
+   }
+   return current.jobs[current.next++];
 }
 
-#else
 
 template <typename Integer, typename TagType>
-void panda::JobManagerProxy<Integer, TagType>::put(const Matrix<Integer>&) const
+panda::JobManagerProxy<Integer, TagType>::JobManagerProxy(const Names&, const int number_of_processors, const int, const std::optional<VertexGroup>& vertex_group_, const Matrix<Integer>& vertices_, const std::optional<std::chrono::seconds>&, std::size_t, const int sub_masters)
+:
+   communication(),
+   master(hierarchy::master(mpi::getSession().getRank(), number_of_processors, sub_masters)),
+   vertex_group(vertex_group_),
+   vertices(vertices_),
+   incidence(vertices),
+   canonical_forms(vertex_group_ ? canonical_forms_capacity : 1),
+   sent_classes(vertex_group_ ? sent_classes_capacity : 1),
+   mutex(),
+   batches(),
+   statistics_reported(false),
+   idle_time()
 {
 }
 
 template <typename Integer, typename TagType>
-panda::Row<Integer> panda::JobManagerProxy<Integer, TagType>::get() const
+panda::JobManagerProxy<Integer, TagType>::~JobManagerProxy()
 {
-   return panda::Row<Integer>{};
+   std::stringstream stream;
+   stream << "Node " << mpi::getSession().getRank() << ": waiting for jobs " << std::fixed << std::setprecision(1) << 100.0 * idle_time.fraction() << "% of the time\n";
+   std::cerr << stream.str();
 }
 
-#endif
+template <typename Integer, typename TagType>
+typename panda::JobManagerProxy<Integer, TagType>::Batch& panda::JobManagerProxy<Integer, TagType>::batch() const
+{
+   // elements of a map keep their address, hence the reference outlives the lock.
+   std::lock_guard<std::mutex> lock(mutex);
+   return batches[std::this_thread::get_id()];
+}
 
 template <typename Integer, typename TagType>
-panda::JobManagerProxy<Integer, TagType>::JobManagerProxy(const Names&, const int, const int, const std::optional<VertexGroup>&, const Matrix<Integer>&)
-:
-   communication()
+void panda::JobManagerProxy<Integer, TagType>::reportStatistics() const
 {
+   std::lock_guard<std::mutex> lock(mutex);
+   if ( !vertex_group || statistics_reported )
+   {
+      return;
+   }
+   statistics_reported = true;
+   std::stringstream stream;
+   stream << "Results dropped before sending (class sent recently): " << sent_classes.hits() << " of " << sent_classes.lookups() << '\n';
+   std::cerr << stream.str();
 }
 
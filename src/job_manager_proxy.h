@@ -6,13 +6,22 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
+#include <map>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <vector>
 
 #include "communication.h"
+#include "idle_time.h"
+#include "incidence.h"
 #include "matrix.h"
 #include "names.h"
 #include "row.h"
+#include "support.h"
+#include "support_cache.h"
 #include "tags.h"
 #include "vertex_group.h"
 
@@ -21,6 +30,8 @@ namespace panda
    /// For a slave node, there is no JobManager in shared memory.
    /// Instead, this proxy uses a communicator to forward the request to the master.
    /// The class exhibits the same interface to have templated code on master and slaves.
+   /// With a vertex group, the canonical supports of the results are computed here and
+   /// sent along, and results of classes that were sent recently are dropped.
    template <typename Integer, typename TagType>
    class JobManagerProxy
    {
@@ -29,10 +40,45 @@ namespace panda
          void put(const Matrix<Integer>&) const;
          /// Returns facet that wasn't ever returned here before. Blocks the caller until data is available.
          Row<Integer> get() const;
-         /// Constructor. The arguments are deliberately ignored in JobManagerProxy.
-         JobManagerProxy(const Names&, const int, const int, const std::optional<VertexGroup>& = std::nullopt, const Matrix<Integer>& = Matrix<Integer>{});
+         /// Constructor. The names, number of threads, the lease duration and the prefetch
+         /// depth (both handled by the master) are deliberately ignored. The number of nodes
+         /// and the number of sub-masters determine the master of this node.
+         JobManagerProxy(const Names&, const int, const int, const std::optional<VertexGroup>& = std::nullopt, const Matrix<Integer>& = Matrix<Integer>{}, const std::optional<std::chrono::seconds>& = std::nullopt, std::size_t = 1, int sub_masters = 0);
+         /// Destructor: reports the fraction of the time the threads waited for jobs.
+         ~JobManagerProxy();
       private:
+         /// Jobs received from the master in one message, and the results found so far.
+         /// The results are sent back in one message once all jobs of the batch are done.
+         struct Batch
+         {
+            Matrix<Integer> jobs{};
+            /// the lease of the jobs, sent back with the results.
+            std::size_t lease{0};
+            std::size_t next{0};
+            Matrix<Integer> results{};
+            /// canonical supports of the results (empty if there is no vertex group).
+            std::vector<Support> supports{};
+         };
          Communication communication;
+         /// the node handing out the jobs (the master or a sub-master).
+         const int master;
+         const std::optional<VertexGroup> vertex_group;
+         const Matrix<Integer> vertices;
+         const Incidence<Integer> incidence;
+         /// canonical forms of raw supports computed before (only used with a vertex group).
+         mutable SupportCache canonical_forms;
+         /// canonical supports of the classes sent recently (only used with a vertex group).
+         mutable SupportCache sent_classes;
+         mutable std::mutex mutex;
+         /// the batch each calling thread is working on.
+         mutable std::map<std::thread::id, Batch> batches;
+         mutable bool statistics_reported;
+         mutable IdleTime idle_time;
+      private:
+         /// Returns the batch of the calling thread.
+         Batch& batch() const;
+         /// Reports (once) how many results were dropped because of the sent classes.
+         void reportStatistics() const;
    };
 }
 
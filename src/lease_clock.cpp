@@ -0,0 +1,51 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "lease_clock.h"
+
+#include <cassert>
+
+using namespace panda;
+
+panda::LeaseClock::LeaseClock(const std::optional<Clock::duration>& duration_)
+:
+   duration(duration_),
+   nodes()
+{
+}
+
+void panda::LeaseClock::sent(const int node, const Clock::time_point now)
+{
+   auto& state = nodes[node];
+   if ( state.outstanding == 0 )
+   {
+      state.renewed = now;
+   }
+   ++state.outstanding;
+}
+
+void panda::LeaseClock::received(const int node, const Clock::time_point now)
+{
+   auto& state = nodes[node];
+   assert( state.outstanding > 0 );
+   --state.outstanding;
+   state.renewed = now;
+}
+
+LeaseClock::Deadline panda::LeaseClock::deadline(const int node, const Clock::time_point now) const
+{
+   if ( !duration )
+   {
+      return std::nullopt;
+   }
+   const auto it = nodes.find(node);
+   if ( it == nodes.end() || it->second.outstanding == 0 )
+   {
+      return now + *duration;
+   }
+   return it->second.renewed + *duration;
+}
+
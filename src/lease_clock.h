@@ -0,0 +1,45 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <optional>
+
+namespace panda
+{
+   /// Deadlines of the nodes that work on leases ("--lease=<seconds>"). The clock of a node
+   /// starts when it gets a batch while none is outstanding and restarts with each of its
+   /// results. Batches sent ahead wait at the node until the previous ones are done, hence
+   /// their waiting doesn't count against the lease: a slow node only misses its deadline if
+   /// it doesn't finish any batch within the lease. Not synchronized, the owner locks.
+   class LeaseClock
+   {
+      public:
+         using Clock = std::chrono::steady_clock;
+         using Deadline = std::optional<Clock::time_point>;
+         /// Constructor: argument is the duration of a lease (std::nullopt: no deadlines).
+         explicit LeaseClock(const std::optional<Clock::duration>&);
+         /// Records a batch sent to the node at the given time.
+         void sent(int, Clock::time_point);
+         /// Records the results of a batch received from the node at the given time.
+         void received(int, Clock::time_point);
+         /// Returns the deadline of the node, given the current time.
+         Deadline deadline(int, Clock::time_point) const;
+      private:
+         struct Node
+         {
+            /// number of batches whose results haven't been received yet.
+            std::size_t outstanding{0};
+            /// start of the current clock of the node.
+            Clock::time_point renewed{};
+         };
+         const std::optional<Clock::duration> duration;
+         std::map<int, Node> nodes;
+   };
+}
+
@@ -0,0 +1,63 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "lease_duration.h"
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace panda;
+
+namespace
+{
+   std::chrono::seconds interpretParameter(char*);
+}
+
+std::optional<std::chrono::seconds> panda::lease::duration(int argc, char** argv)
+{
+   assert( argc > 0 && argv != nullptr );
+   for ( int i = 1; i < argc; ++i )
+   {
+      if ( std::strncmp(argv[i], "--lease=", 8) == 0 )
+      {
+         return interpretParameter(argv[i] + 8);
+      }
+      else if ( std::strncmp(argv[i], "--lease", 7) == 0 )
+      {
+         throw std::invalid_argument("Illegal parameter. Did you mean \"--lease=<seconds>\"?");
+      }
+   }
+   return std::nullopt;
+}
+
+namespace
+{
+   std::chrono::seconds interpretParameter(char* string)
+   {
+      assert( string != nullptr );
+      std::istringstream stream(string);
+      long long n;
+      if ( !(stream >> n) )
+      {
+         throw std::invalid_argument("Command line option \"--lease=<seconds>\" needs an integral parameter.");
+      }
+      std::string rest;
+      stream >> rest;
+      if ( !rest.empty() )
+      {
+         throw std::invalid_argument("Command line option \"--lease=<seconds>\" needs an integral parameter.");
+      }
+      if ( n <= 0 )
+      {
+         throw std::invalid_argument("Command line option \"--lease=<seconds>\" needs an integral parameter greater zero.");
+      }
+      return std::chrono::seconds(n);
+   }
+}
+
@@ -0,0 +1,22 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace panda
+{
+   namespace lease
+   {
+      /// Returns the time a slave has for a batch of jobs ("--lease=<seconds>"), before the
+      /// master gives up on it and hands the jobs out again. Without the option, the master
+      /// waits forever.
+      std::optional<std::chrono::seconds> duration(int, char**);
+   }
+}
+
@@ -8,15 +8,24 @@
 #include "list.h"
 #undef COMPILE_TEMPLATE_LIST
 
+#include <cassert>
 #include <cstddef>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <utility>
+#include <vector>
 
-#include "algorithm_inequality_operations.h"
 #include "algorithm_row_operations.h"
 
 using namespace panda;
 
+namespace
+{
+   /// Maximal number of raw supports whose canonical forms are kept.
+   constexpr std::size_t canonical_forms_capacity = std::size_t{1} << 16;
+}
+
 #define PRINT_DONE_COUNTER /// if enabled, the beginning of processing a row will be announced.
 
 #ifdef PRINT_DONE_COUNTER
@@ -24,14 +33,15 @@ using namespace panda;
    #if HAS_FEATURE_THREAD_LOCAL != 0
       namespace
       {
-         thread_local std::size_t index;
+         /// numbers of the jobs taken by the current thread in its last call of get.
+         thread_local std::vector<std::size_t> job_indices;
       }
    #else
       #include <map>
       #include <thread>
       namespace
       {
-         std::map<std::thread::id, std::size_t> indices;
+         std::map<std::thread::id, std::vector<std::size_t>> indices;
       }
    #endif
 #endif
@@ -39,22 +49,57 @@ using namespace panda;
 template <typename Integer, typename TagType>
 void panda::List<Integer, TagType>::put(const Matrix<Integer>& matrix) const
 {
-   for ( const auto& row : matrix )
+   put(matrix, 1);
+}
+
+template <typename Integer, typename TagType>
+void panda::List<Integer, TagType>::put(const Matrix<Integer>& matrix, const std::size_t jobs) const
+{
+   // canonical supports are computed outside the lock, all in one batch.
+   std::vector<Support> supports;
+   if ( vertex_group )
    {
-      put(row);
+      supports.reserve(matrix.size());
+      for ( const auto& row : matrix )
+      {
+         supports.push_back(incidence.supportBitset(row));
+      }
+      canonical_forms.canonicalize(*vertex_group, supports);
+   }
+   put(matrix, std::move(supports), jobs);
+}
+
+template <typename Integer, typename TagType>
+void panda::List<Integer, TagType>::put(const Matrix<Integer>& matrix, std::vector<Support>&& supports, const std::size_t jobs) const
+{
+   assert( !vertex_group || supports.size() == matrix.size() );
+   supports.resize(matrix.size());
+   for ( std::size_t i = 0; i < matrix.size(); ++i )
+   {
+      const auto added = insert(matrix[i], std::move(supports[i]));
+      if ( added.second != nullptr )
+      {
+         countOrbit(added.first, *added.second);
+      }
    }
    std::lock_guard<std::mutex> lock(mutex);
-   --workers;
+   assert( workers >= jobs );
+   workers -= jobs;
+   if ( jobs > 0 && workers == 0 && iterators.empty() )
+   {
+      idle_condition.notify_all();
+   }
    #ifdef PRINT_DONE_COUNTER
    #if HAS_FEATURE_THREAD_LOCAL == 0
-   auto index = indices[std::this_thread::get_id()];
+   auto& job_indices = indices[std::this_thread::get_id()];
    #endif
-   if ( index > 0 )
+   std::stringstream stream;
+   for ( const auto job_index : job_indices )
    {
-      std::stringstream stream;
-      stream << "Done processing #" << index << '\n';
-      std::cerr << stream.str();
+      stream << "Done processing #" << job_index << '\n';
    }
+   job_indices.clear();
+   std::cerr << stream.str();
    #endif
 }
 
@@ -62,30 +107,35 @@ template <typename Integer, typename TagType>
 void panda::List<Integer, TagType>::put(const Row<Integer>& row) const
 {
    // If vertex_group is available, compute canonical support outside the lock
-   std::vector<std::size_t> canonical;
+   std::vector<Support> canonical(1);
    if ( vertex_group )
    {
-      std::vector<std::size_t> support;
-      for ( std::size_t i = 0; i < vertices.size(); ++i )
-      {
-         if ( algorithm::distance(row, vertices[i]) == 0 )
-         {
-            support.push_back(i);
-         }
-      }
-      canonical = vertex_group->canonicalSupport(support);
+      canonical.front() = incidence.supportBitset(row);
+      canonical_forms.canonicalize(*vertex_group, canonical);
    }
+   const auto added = insert(row, std::move(canonical.front()));
+   if ( added.second != nullptr )
+   {
+      countOrbit(added.first, *added.second);
+   }
+}
 
+template <typename Integer, typename TagType>
+std::pair<std::size_t, const Support*> panda::List<Integer, TagType>::insert(const Row<Integer>& row, Support&& canonical) const
+{
    std::lock_guard<std::mutex> lock(mutex);
 
    // Canonical support dedup: skip if this canonical form was already seen
+   const Support* stored = nullptr;
    if ( vertex_group )
    {
       auto result = seen_supports.insert(std::move(canonical));
       if ( !result.second )
       {
-         return;
+         return std::make_pair(rows.size(), nullptr);
       }
+      // elements of an unordered set keep their address on rehashing.
+      stored = &*result.first;
    }
 
    Iterator it;
@@ -104,43 +154,79 @@ void panda::List<Integer, TagType>::put(const Row<Integer>& row) const
       std::cout.flush();
       iterators.push_back(it);
       condition.notify_one();
+      return std::make_pair(rows.size(), stored);
    }
+   return std::make_pair(rows.size(), nullptr);
+}
+
+template <typename Integer, typename TagType>
+void panda::List<Integer, TagType>::countOrbit(const std::size_t number, const Support& canonical) const
+{
+   // the stabilizer is computed outside the lock.
+   const auto orbit_size = vertex_group->orbitSize(canonical);
+   std::lock_guard<std::mutex> lock(mutex);
+   total_orbit_size += orbit_size;
+   std::stringstream stream;
+   stream << "Class #" << number << ": orbit size " << orbit_size << " (total so far: " << total_orbit_size << ")\n";
+   std::cerr << stream.str();
 }
 
 template <typename Integer, typename TagType>
 Row<Integer> panda::List<Integer, TagType>::get() const
 {
+   const auto jobs = get(1);
+   return jobs.empty() ? Row<Integer>{} : jobs.front();
+}
+
+template <typename Integer, typename TagType>
+Matrix<Integer> panda::List<Integer, TagType>::get(const std::size_t count) const
+{
+   assert( count > 0 );
    if ( empty() ) // abort
    {
-      const auto it = rows.insert(Row<Integer>{}).first;
-      std::unique_lock<std::mutex> lock(mutex);
-      iterators.push_back(it);
-      condition.notify_all();
+      finish();
    }
    std::unique_lock<std::mutex> lock(mutex);
    condition.wait(lock, [&](){ return !iterators.empty(); });
-   ++workers;
-   const auto row = *iterators.front();
-   if ( !row.empty() )
-   {
-      iterators.erase(iterators.begin());
-   }
+   return take(count);
+}
+
+template <typename Integer, typename TagType>
+Matrix<Integer> panda::List<Integer, TagType>::tryGet(const std::size_t count) const
+{
+   assert( count > 0 );
+   std::lock_guard<std::mutex> lock(mutex);
+   return take(count);
+}
+
+template <typename Integer, typename TagType>
+Matrix<Integer> panda::List<Integer, TagType>::take(const std::size_t count) const
+{
    #ifdef PRINT_DONE_COUNTER
-   if ( !row.empty() )
+   #if HAS_FEATURE_THREAD_LOCAL == 0
+   auto& job_indices = indices[std::this_thread::get_id()];
+   #endif
+   job_indices.clear();
+   std::stringstream stream;
+   #endif
+   Matrix<Integer> jobs;
+   // the empty row marks the end and stays in place for all other callers.
+   while ( jobs.size() < count && !iterators.empty() && !iterators.front()->empty() )
    {
+      ++workers;
+      jobs.push_back(*iterators.front());
+      iterators.erase(iterators.begin());
+      #ifdef PRINT_DONE_COUNTER
       ++counter;
-      #if HAS_FEATURE_THREAD_LOCAL == 0
-      indices[std::this_thread::get_id()] = counter;
-      #else
-      index = counter;
-      #endif
-      std::stringstream stream;
+      job_indices.push_back(counter);
       stream << "Processing #" << counter << " of at least " << rows.size();
       stream << " class" << ((rows.size() == 1) ? "" : "es") << '\n';
-      std::cerr << stream.str();
+      #endif
    }
+   #ifdef PRINT_DONE_COUNTER
+   std::cerr << stream.str();
    #endif
-   return row;
+   return jobs;
 }
 
 template <typename Integer, typename TagType>
@@ -149,20 +235,129 @@ panda::List<Integer, TagType>::List(const Names& names_, const std::optional<Ver
    names(names_),
    vertex_group(vertex_group_),
    vertices(vertices_),
+   incidence(vertices),
    mutex(),
    workers(1),
    condition(),
+   idle_condition(),
+   held(false),
    rows(),
    iterators(),
    counter(0),
-   seen_supports()
+   seen_supports(),
+   canonical_forms(vertex_group_ ? canonical_forms_capacity : 1),
+   statistics_reported(false),
+   total_orbit_size(0)
 {
 }
 
 template <typename Integer, typename TagType>
-bool panda::List<Integer, TagType>::empty() const
+void panda::List<Integer, TagType>::requeue(const Matrix<Integer>& jobs) const
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      assert( workers >= jobs.size() );
+      // the jobs are older than the queued ones, hence they are returned first.
+      std::vector<Iterator> returned;
+      returned.reserve(jobs.size());
+      for ( const auto& job : jobs )
+      {
+         const auto it = rows.find(job);
+         assert( it != rows.end() );
+         returned.push_back(it);
+      }
+      iterators.insert(iterators.begin(), returned.begin(), returned.end());
+      workers -= jobs.size();
+   }
+   condition.notify_all();
+}
+
+template <typename Integer, typename TagType>
+void panda::List<Integer, TagType>::hold() const
+{
+   const std::lock_guard<std::mutex> lock(mutex);
+   held = true;
+}
+
+template <typename Integer, typename TagType>
+void panda::List<Integer, TagType>::release() const
+{
+   {
+      const std::lock_guard<std::mutex> lock(mutex);
+      held = false;
+   }
+   // callers of get may be waiting already, hence they don't check for the end again.
+   if ( empty() )
+   {
+      finish();
+   }
+}
+
+template <typename Integer, typename TagType>
+bool panda::List<Integer, TagType>::idle() const
 {
    const std::lock_guard<std::mutex> lock(mutex);
    return workers == 0 && iterators.empty();
 }
 
+template <typename Integer, typename TagType>
+void panda::List<Integer, TagType>::waitUntilIdle() const
+{
+   std::unique_lock<std::mutex> lock(mutex);
+   idle_condition.wait(lock, [&](){ return workers == 0 && iterators.empty(); });
+}
+
+template <typename Integer, typename TagType>
+bool panda::List<Integer, TagType>::empty() const
+{
+   const std::lock_guard<std::mutex> lock(mutex);
+   return !held && workers == 0 && iterators.empty();
+}
+
+template <typename Integer, typename TagType>
+void panda::List<Integer, TagType>::finish() const
+{
+   const auto it = rows.insert(Row<Integer>{}).first;
+   std::unique_lock<std::mutex> lock(mutex);
+   iterators.push_back(it);
+   condition.notify_all();
+   if ( !statistics_reported )
+   {
+      statistics_reported = true;
+      lock.unlock();
+      report(statistics());
+   }
+}
+
+template <typename Integer, typename TagType>
+void panda::List<Integer, TagType>::withholdStatistics() const
+{
+   const std::lock_guard<std::mutex> lock(mutex);
+   statistics_reported = true;
+}
+
+template <typename Integer, typename TagType>
+ClassStatistics panda::List<Integer, TagType>::statistics() const
+{
+   const std::lock_guard<std::mutex> lock(mutex);
+   return ClassStatistics{seen_supports.size(), total_orbit_size, canonical_forms.lookups(), canonical_forms.hits()};
+}
+
+template <typename Integer, typename TagType>
+void panda::List<Integer, TagType>::report(const ClassStatistics& statistics_) const
+{
+   if ( !vertex_group )
+   {
+      return;
+   }
+   std::stringstream stream;
+   stream << "Canonical form cache: " << statistics_.hits << " hits of " << statistics_.lookups << " lookups";
+   if ( statistics_.lookups > 0 )
+   {
+      stream << " (" << std::fixed << std::setprecision(1) << 100.0 * static_cast<double>(statistics_.hits) / static_cast<double>(statistics_.lookups) << "%)";
+   }
+   stream << '\n';
+   stream << "Classes: " << statistics_.classes << ", total number of " << (std::is_same<TagType, tag::facet>::value ? "facets" : "vertices") << ": " << statistics_.orbit_sizes << '\n';
+   std::cerr << stream.str();
+}
+
@@ -11,11 +11,19 @@
 #include <mutex>
 #include <optional>
 #include <set>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include <gmpxx.h>
+
+#include "class_statistics.h"
+#include "incidence.h"
 #include "matrix.h"
 #include "names.h"
 #include "row.h"
+#include "support.h"
+#include "support_cache.h"
 #include "tags.h"
 #include "vertex_group.h"
 
@@ -27,11 +35,44 @@ namespace panda
       public:
          /// merges rows with the list of rows held in the list.
          void put(const Matrix<Integer>&) const;
+         /// merges the rows found by a batch of jobs (second argument: number of jobs)
+         /// with the list of rows held in the list.
+         void put(const Matrix<Integer>&, std::size_t) const;
+         /// merges the rows found by a batch of jobs, whose canonical supports have been
+         /// computed already (e.g. on a slave), with the list of rows held in the list.
+         /// Without a vertex group, the supports are ignored.
+         void put(const Matrix<Integer>&, std::vector<Support>&&, std::size_t) const;
          /// merges a row with the list of rows held in the list.
          void put(const Row<Integer>&) const;
          /// Returns a row that wasn't ever returned here before. Blocks the
          /// caller until data is available.
          Row<Integer> get() const;
+         /// Returns up to the given number of rows that weren't ever returned here before.
+         /// Blocks the caller until at least one row is available. An empty matrix
+         /// signals that all jobs are done.
+         Matrix<Integer> get(std::size_t) const;
+         /// Like get, but returns an empty matrix at once if no row is available (this
+         /// doesn't signal the end).
+         Matrix<Integer> tryGet(std::size_t) const;
+         /// Returns jobs that weren't done (e.g. because their node failed) to the list,
+         /// get returns them again.
+         void requeue(const Matrix<Integer>&) const;
+         /// Keeps the list from signaling the end once all jobs are done, until release is
+         /// called (e.g. while other nodes may still send rows).
+         void hold() const;
+         /// Undoes hold, the end is signaled if all jobs are done.
+         void release() const;
+         /// Checks if no job is queued or being processed.
+         bool idle() const;
+         /// Blocks the caller until no job is queued or being processed.
+         void waitUntilIdle() const;
+         /// Keeps the list from reporting its statistics at the end, e.g. because they are
+         /// summed up over the nodes and reported on one of them.
+         void withholdStatistics() const;
+         /// Returns the statistics of the classes added so far.
+         ClassStatistics statistics() const;
+         /// Reports the statistics (with a vertex group only).
+         void report(const ClassStatistics&) const;
          #pragma GCC diagnostic push
          #pragma GCC diagnostic ignored "-Weffc++"
          /// Constructor: special thing here: number of active workers is initialized
@@ -42,17 +83,37 @@ namespace panda
          const Names names;
          const std::optional<VertexGroup> vertex_group;
          const Matrix<Integer> vertices;
+         const Incidence<Integer> incidence;
          mutable std::mutex mutex;
          mutable std::size_t workers;
          mutable std::condition_variable condition;
+         /// signaled whenever the last job is done and no other job is queued.
+         mutable std::condition_variable idle_condition;
+         mutable bool held;
          mutable std::set<Row<Integer>> rows;
          using Iterator = typename std::set<Row<Integer>>::iterator;
          mutable std::vector<Iterator> iterators;
          mutable std::size_t counter;
-         mutable std::set<std::vector<std::size_t>> seen_supports;
+         /// canonical supports of the rows added so far (only used with a vertex group).
+         mutable std::unordered_set<Support, Support::Hash> seen_supports;
+         /// canonical forms of raw supports computed before (only used with a vertex group).
+         mutable SupportCache canonical_forms;
+         mutable bool statistics_reported;
+         /// sum of the orbit sizes of the classes added so far (only used with a vertex group).
+         mutable mpz_class total_orbit_size;
       private:
-         /// checks if all jobs are done.
+         /// checks if all jobs are done (and the list isn't held).
          bool empty() const;
+         /// signals the end to all callers of get and reports the statistics (once).
+         void finish() const;
+         /// hands out up to the given number of queued rows (the caller has to hold the lock).
+         Matrix<Integer> take(std::size_t) const;
+         /// adds a row unless its canonical support has been seen before. Returns the number
+         /// of the new class and its stored canonical support (nullptr if nothing was added
+         /// or there is no vertex group).
+         std::pair<std::size_t, const Support*> insert(const Row<Integer>&, Support&&) const;
+         /// adds the orbit size of a new class to the total and reports both.
+         void countOrbit(std::size_t, const Support&) const;
    };
 }
 
@@ -0,0 +1,194 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "local_processes.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LOCAL_PROCESSES_SUPPORT
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "shared_memory_transport.h"
+
+using namespace panda;
+
+namespace
+{
+   int interpretParameter(char*);
+   /// group of this process, set by launch.
+   local::ProcessGroup process_group{0, 1, nullptr};
+   bool launched = false;
+   #ifdef LOCAL_PROCESSES_SUPPORT
+   /// processes forked by this process in the order of their IDs (ID 0 only).
+   std::vector<pid_t> children;
+   #endif
+   /// IDs of the processes given up on.
+   std::set<int> abandoned;
+   std::mutex abandoned_mutex;
+}
+
+int panda::local::numberOfProcesses(int argc, char** argv)
+{
+   assert( argc > 0 && argv != nullptr );
+   for ( int i = 1; i < argc; ++i )
+   {
+      if ( std::strncmp(argv[i], "--processes=", 12) == 0 )
+      {
+         return interpretParameter(argv[i] + 12);
+      }
+      else if ( std::strncmp(argv[i], "--processes", 11) == 0 || std::strncmp(argv[i], "--process", 9) == 0 )
+      {
+         throw std::invalid_argument("Illegal parameter. Did you mean \"--processes=<n>\"?");
+      }
+   }
+   return 1;
+}
+
+void panda::local::launch(int argc, char** argv)
+{
+   const auto count = numberOfProcesses(argc, argv);
+   if ( count == 1 || launched )
+   {
+      return;
+   }
+   #ifdef LOCAL_PROCESSES_SUPPORT
+   const auto bytes = SharedMemoryTransport::bytes(count);
+   // an anonymous shared mapping is inherited by the forked processes at the same address.
+   void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   if ( memory == MAP_FAILED )
+   {
+      throw std::runtime_error("Shared memory for the local processes couldn't be mapped.");
+   }
+   SharedMemoryTransport::initialize(memory, count);
+   // buffered output would be written once by every process otherwise.
+   std::cout.flush();
+   std::cerr.flush();
+   std::fflush(nullptr);
+   launched = true;
+   process_group = ProcessGroup{0, count, memory};
+   for ( int rank = 1; rank < count; ++rank )
+   {
+      const auto pid = fork();
+      if ( pid < 0 )
+      {
+         // the processes started so far would wait for the others forever.
+         for ( const auto child : children )
+         {
+            kill(child, SIGTERM);
+         }
+         throw std::runtime_error("Local process couldn't be started.");
+      }
+      if ( pid == 0 )
+      {
+         process_group.rank = rank;
+         children.clear();
+         return;
+      }
+      children.push_back(pid);
+   }
+   #else
+   throw std::invalid_argument("Command line option \"--processes=<n>\" isn't supported on this platform.");
+   #endif
+}
+
+const local::ProcessGroup* panda::local::group() noexcept
+{
+   return launched ? &process_group : nullptr;
+}
+
+void panda::local::abandon(const int rank)
+{
+   if ( launched )
+   {
+      std::lock_guard<std::mutex> lock(abandoned_mutex);
+      abandoned.insert(rank);
+   }
+}
+
+int panda::local::join(const int exit_code, const std::optional<std::chrono::seconds>& patience)
+{
+   int result = exit_code;
+   #ifdef LOCAL_PROCESSES_SUPPORT
+   std::lock_guard<std::mutex> lock(abandoned_mutex);
+   const auto deadline = std::chrono::steady_clock::now() + patience.value_or(std::chrono::seconds(0));
+   for ( std::size_t i = 0; i < children.size(); ++i )
+   {
+      const auto rank = static_cast<int>(i) + 1;
+      // the jobs of an abandoned process have been done by others, hence its end doesn't matter.
+      bool given_up = abandoned.count(rank) > 0;
+      int status = 0;
+      auto waited = given_up ? 0 : waitpid(children[i], &status, patience ? WNOHANG : 0);
+      while ( waited == 0 && !given_up )
+      {
+         if ( std::chrono::steady_clock::now() >= deadline )
+         {
+            // the results are complete, hence the process is given up on instead of waited for.
+            std::stringstream stream;
+            stream << "Node " << rank << " didn't end in time, it is killed.\n";
+            std::cerr << stream.str();
+            given_up = true;
+            break;
+         }
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+         waited = waitpid(children[i], &status, WNOHANG);
+      }
+      if ( given_up )
+      {
+         kill(children[i], SIGKILL);
+         waited = waitpid(children[i], &status, 0);
+      }
+      const auto failed = waited < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+      if ( failed && !given_up )
+      {
+         result = (result != 0) ? result : 1;
+      }
+   }
+   children.clear();
+   #endif
+   return result;
+}
+
+namespace
+{
+   int interpretParameter(char* string)
+   {
+      assert( string != nullptr );
+      std::istringstream stream(string);
+      int n;
+      if ( !(stream >> n) )
+      {
+         throw std::invalid_argument("Command line option \"--processes=<n>\" needs an integral parameter.");
+      }
+      std::string rest;
+      stream >> rest;
+      if ( !rest.empty() )
+      {
+         throw std::invalid_argument("Command line option \"--processes=<n>\" needs an integral parameter.");
+      }
+      if ( n <= 0 )
+      {
+         throw std::invalid_argument("Command line option \"--processes=<n>\" needs an integral parameter greater zero.");
+      }
+      return n;
+   }
+}
+
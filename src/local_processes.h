@@ -0,0 +1,46 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+namespace panda
+{
+   namespace local
+   {
+      /// Processes on one machine that take the roles of MPI nodes without MPI. They are
+      /// forked from one process and communicate through shared memory.
+      struct ProcessGroup
+      {
+         /// ID of this process (0 for the process that forked the others).
+         int rank;
+         /// number of processes.
+         int size;
+         /// shared memory, mapped at the same address in all processes.
+         void* memory;
+      };
+
+      /// Returns the number of local processes ("--processes=<n>", default 1).
+      int numberOfProcesses(int, char**);
+      /// Starts the local processes if more than one is requested: the shared memory is
+      /// mapped and the calling process forks the others, which return from here with their
+      /// own ID. Has to be called before any thread is started and before the MPI session.
+      void launch(int, char**);
+      /// Returns the group of this process (nullptr unless launch started other processes).
+      const ProcessGroup* group() noexcept;
+      /// Gives up on the process with the given ID (e.g. because it stopped responding): it is
+      /// killed by join instead of waited for. Does nothing unless local processes are used.
+      void abandon(int);
+      /// Waits for the other processes (on ID 0 only), at most for the given time (std::nullopt:
+      /// no limit). The processes that haven't ended by then are killed, e.g. a slave that
+      /// stopped after its last batch. Returns the exit code of the group, given the exit code
+      /// of this process.
+      int join(int, const std::optional<std::chrono::seconds>& = std::nullopt);
+   }
+}
+
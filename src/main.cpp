@@ -10,6 +10,7 @@
 #include "git_revision.h"
 #include "help.h"
 #include "input_detection.h"
+#include "method_expansion.h"
 #include "method_facet_enumeration.h"
 #include "method_vertex_enumeration.h"
 
@@ -34,6 +35,10 @@ int main(int argc, char** argv)
       {
          return method::vertexEnumeration(argc, argv);
       }
+      case OperationMode::Expansion:
+      {
+         return method::expansion(argc, argv);
+      }
       case OperationMode::HelpCommand:
       {
          return help::command(argc, argv);
@@ -95,6 +100,27 @@ namespace
                 << "\t--sampling\n"
                 << "\t\tin recursive AD, only analyse initial facets without enqueuing newly found ones.\n"
                 << '\n'
+                << "\t--detect-symmetry\n"
+                << "\t\tin AD, detects the linear symmetries of the input and enumerates one facet / vertex per orbit.\n"
+                << '\n'
+                << "\t--expand=<path/to/file>\n"
+                << "\t\texpands the classes in a reduced output to all facets / vertices, using the symmetries of the input file.\n"
+                << '\n'
+                << "\t--distributed\n"
+                << "\t\tin AD with MPI, stores the classes distributed over all nodes instead of on the master only.\n"
+                << '\n'
+                << "\t--lease=<seconds>\n"
+                << "\t\tin AD with slaves, hands the jobs of a slave out again if it doesn't answer in time (default: no deadline).\n"
+                << '\n'
+                << "\t--prefetch=<n>\n"
+                << "\t\tin AD with slaves, number of batches of jobs sent ahead to each thread of a slave (default: 1).\n"
+                << '\n'
+                << "\t--sub-masters=<n>\n"
+                << "\t\tin AD with slaves, number of sub-masters between the master and the slaves (default: 0, disabled).\n"
+                << '\n'
+                << "\t--processes=<n>\n"
+                << "\t\tin AD, runs <n> local processes communicating through shared memory instead of MPI (default: 1).\n"
+                << '\n'
                 << "\t-h <arg>\n\t--help=<arg>\n\t--help-command=<arg>\n"
                 << "\t\twith <arg> being a valid command (i.e. one occuring in this list).\n"
                 << '\n'
@@ -0,0 +1,54 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "map_group.h"
+
+#include <cassert>
+#include <utility>
+
+using namespace panda;
+
+panda::MapGroup::MapGroup(Maps maps_)
+:
+   generating_maps(std::move(maps_)),
+   signed_permutation_group(SignedPermutationGroup::create(generating_maps)),
+   facet_generators(),
+   vertex_generators()
+{
+   if ( !signed_permutation_group )
+   {
+      return;
+   }
+   for ( const auto& map : SignedPermutationGroup::minimalGeneratingSet(generating_maps) )
+   {
+      auto facet_map = CompiledMap::create(map, tag::facet{});
+      auto vertex_map = CompiledMap::create(map, tag::vertex{});
+      assert( facet_map && vertex_map );
+      facet_generators.push_back(std::move(*facet_map));
+      vertex_generators.push_back(std::move(*vertex_map));
+   }
+}
+
+const Maps& panda::MapGroup::maps() const noexcept
+{
+   return generating_maps;
+}
+
+const SignedPermutationGroup* panda::MapGroup::group() const noexcept
+{
+   return signed_permutation_group ? &*signed_permutation_group : nullptr;
+}
+
+const std::vector<CompiledMap>* panda::MapGroup::generators(tag::facet) const noexcept
+{
+   return signed_permutation_group ? &facet_generators : nullptr;
+}
+
+const std::vector<CompiledMap>* panda::MapGroup::generators(tag::vertex) const noexcept
+{
+   return signed_permutation_group ? &vertex_generators : nullptr;
+}
+
@@ -0,0 +1,43 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "compiled_map.h"
+#include "maps.h"
+#include "signed_permutation_group.h"
+#include "tags.h"
+
+namespace panda
+{
+   /// Maps together with the signed permutation group they generate and the compiled maps of
+   /// a minimal generating set. It is built once where the maps are fixed and handed to the
+   /// computations of classes along with the maps.
+   class MapGroup
+   {
+      public:
+         /// Constructor. Builds the group and compiles its generators if the maps are signed
+         /// permutations.
+         explicit MapGroup(Maps);
+         /// Returns the maps.
+         const Maps& maps() const noexcept;
+         /// Returns the group generated by the maps or nullptr if they are no signed permutations.
+         const SignedPermutationGroup* group() const noexcept;
+         /// Returns the compiled generators for facets or nullptr if there is no group.
+         const std::vector<CompiledMap>* generators(tag::facet) const noexcept;
+         /// Returns the compiled generators for vertices or nullptr if there is no group.
+         const std::vector<CompiledMap>* generators(tag::vertex) const noexcept;
+      private:
+         Maps generating_maps;
+         std::optional<SignedPermutationGroup> signed_permutation_group;
+         std::vector<CompiledMap> facet_generators;
+         std::vector<CompiledMap> vertex_generators;
+   };
+}
+
@@ -0,0 +1,108 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "master_hierarchy.h"
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace panda;
+
+namespace
+{
+   int interpretParameter(char*);
+}
+
+int panda::hierarchy::subMasters(int argc, char** argv, const int number_of_nodes)
+{
+   assert( argc > 0 && argv != nullptr );
+   assert( number_of_nodes > 0 );
+   for ( int i = 1; i < argc; ++i )
+   {
+      if ( std::strncmp(argv[i], "--sub-masters=", 14) == 0 )
+      {
+         const auto n = interpretParameter(argv[i] + 14);
+         if ( number_of_nodes - 1 - n < n )
+         {
+            throw std::invalid_argument("Command line option \"--sub-masters=<n>\" needs at least one slave per sub-master.");
+         }
+         return n;
+      }
+      else if ( std::strncmp(argv[i], "--sub-masters", 13) == 0 )
+      {
+         throw std::invalid_argument("Illegal parameter. Did you mean \"--sub-masters=<n>\"?");
+      }
+   }
+   return 0;
+}
+
+int panda::hierarchy::master(const int node, [[maybe_unused]] const int number_of_nodes, const int sub_masters)
+{
+   assert( node >= 0 && node < number_of_nodes );
+   assert( sub_masters >= 0 );
+   if ( sub_masters == 0 || node <= sub_masters )
+   {
+      return 0;
+   }
+   return 1 + (node - sub_masters - 1) % sub_masters;
+}
+
+std::vector<int> panda::hierarchy::slaves(const int node, const int number_of_nodes, const int sub_masters)
+{
+   assert( node >= 0 && node < number_of_nodes );
+   assert( sub_masters >= 0 );
+   std::vector<int> nodes;
+   if ( node == 0 )
+   {
+      const int last = ( sub_masters > 0 ) ? sub_masters : number_of_nodes - 1;
+      for ( int id = 1; id <= last; ++id )
+      {
+         nodes.push_back(id);
+      }
+   }
+   else if ( isSubMaster(node, sub_masters) )
+   {
+      for ( int id = node + sub_masters; id < number_of_nodes; id += sub_masters )
+      {
+         nodes.push_back(id);
+      }
+   }
+   return nodes;
+}
+
+bool panda::hierarchy::isSubMaster(const int node, const int sub_masters)
+{
+   return node > 0 && node <= sub_masters;
+}
+
+namespace
+{
+   int interpretParameter(char* string)
+   {
+      assert( string != nullptr );
+      std::istringstream stream(string);
+      int n;
+      if ( !(stream >> n) )
+      {
+         throw std::invalid_argument("Command line option \"--sub-masters=<n>\" needs an integral parameter.");
+      }
+      std::string rest;
+      stream >> rest;
+      if ( !rest.empty() )
+      {
+         throw std::invalid_argument("Command line option \"--sub-masters=<n>\" needs an integral parameter.");
+      }
+      if ( n < 0 )
+      {
+         throw std::invalid_argument("Command line option \"--sub-masters=<n>\" needs a non-negative integral parameter.");
+      }
+      return n;
+   }
+}
+
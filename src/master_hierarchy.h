@@ -0,0 +1,32 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <vector>
+
+namespace panda
+{
+   /// Two-level hierarchy of masters ("--sub-masters=<n>"): the nodes 1, ..., n are
+   /// sub-masters, each serving every n-th of the remaining nodes, and the master serves
+   /// the sub-masters only. Without sub-masters, the master serves all other nodes.
+   namespace hierarchy
+   {
+      /// Returns the number of sub-masters ("--sub-masters=<n>", default 0). The last
+      /// argument is the number of nodes, there has to be at least one slave per sub-master.
+      int subMasters(int, char**, int);
+      /// Returns the node handing out the jobs to the node (first argument). The other
+      /// arguments are the number of nodes and the number of sub-masters.
+      int master(int, int, int);
+      /// Returns the nodes the node (first argument) hands out jobs to. The other arguments
+      /// are the number of nodes and the number of sub-masters.
+      std::vector<int> slaves(int, int, int);
+      /// Checks if the node (first argument) is a sub-master. The other argument is the
+      /// number of sub-masters.
+      bool isSubMaster(int, int);
+   }
+}
+
@@ -0,0 +1,359 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_MATRIX_SERIALIZATION
+#include "matrix_serialization.h"
+#undef COMPILE_TEMPLATE_MATRIX_SERIALIZATION
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "big_integer.h"
+#include "safe_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Identifies the encoding of the coefficients (first byte of a buffer).
+   enum class Encoding : char
+   {
+      Plain = 0,
+      Varint = 1,
+      Limbs = 2
+   };
+   /// Fixed width representation of the coefficients of a native integer type.
+   template <typename Integer>
+   struct Word
+   {
+      using Type = Integer;
+      static Type get(const Integer value) noexcept
+      {
+         return value;
+      }
+      static Integer make(const Type word) noexcept
+      {
+         return word;
+      }
+   };
+   template <>
+   struct Word<SafeInteger>
+   {
+      using Type = SafeInteger::DataType;
+      static Type get(const SafeInteger& value) noexcept
+      {
+         return value.value();
+      }
+      static SafeInteger make(const Type word) noexcept
+      {
+         return SafeInteger(word);
+      }
+   };
+   /// Largest magnitude of a BigInteger coefficient that is sent as a single varint.
+   constexpr std::uint64_t small_limit = std::uint64_t{1} << 62;
+   /// Writes the coefficients of a fixed width type.
+   template <typename Integer>
+   void putCoefficients(const Matrix<Integer>&, std::size_t, std::vector<char>&);
+   /// Writes the coefficients of arbitrary precision.
+   void putCoefficients(const Matrix<BigInteger>&, std::size_t, std::vector<char>&);
+   /// Reads the coefficients of a fixed width type at the position, which is advanced.
+   template <typename Integer>
+   void getCoefficients(Encoding, const std::vector<char>&, std::size_t&, Matrix<Integer>&);
+   /// Reads the coefficients of arbitrary precision at the position, which is advanced.
+   void getCoefficients(Encoding, const std::vector<char>&, std::size_t&, Matrix<BigInteger>&);
+   /// Writes the number of supports, their number of vertices and their words.
+   void putSupports(const std::vector<Support>&, std::vector<char>&);
+   /// Reads the supports written by putSupports at the position, which is advanced.
+   void getSupports(const std::vector<char>&, std::size_t&, std::vector<Support>&);
+   /// Appends an unsigned integer in LEB128 format.
+   void putVarint(std::uint64_t, std::vector<char>&);
+   /// Reads an unsigned integer in LEB128 format at the position, which is advanced.
+   std::uint64_t getVarint(const std::vector<char>&, std::size_t&);
+   /// Maps signed to unsigned integers, such that small absolute values stay small.
+   std::uint64_t zigzag(std::int64_t) noexcept;
+   /// Inverse of zigzag.
+   std::int64_t unzigzag(std::uint64_t) noexcept;
+   /// Writes the header and returns its size.
+   std::size_t putHeader(Encoding, std::size_t, std::size_t, std::size_t, std::vector<char>&);
+}
+
+template <typename Integer>
+void panda::serialization::pack(const Matrix<Integer>& matrix, const std::size_t jobs, std::vector<char>& buffer)
+{
+   pack(matrix, std::vector<Support>{}, jobs, buffer);
+}
+
+template <typename Integer>
+void panda::serialization::pack(const Matrix<Integer>& matrix, const std::vector<Support>& supports, const std::size_t jobs, std::vector<char>& buffer)
+{
+   buffer.clear();
+   putCoefficients(matrix, jobs, buffer);
+   putSupports(supports, buffer);
+}
+
+template <typename Integer>
+std::pair<Matrix<Integer>, std::size_t> panda::serialization::unpack(const std::vector<char>& buffer)
+{
+   std::vector<Support> supports;
+   return unpack<Integer>(buffer, supports);
+}
+
+template <typename Integer>
+std::pair<Matrix<Integer>, std::size_t> panda::serialization::unpack(const std::vector<char>& buffer, std::vector<Support>& supports)
+{
+   if ( buffer.empty() )
+   {
+      throw std::invalid_argument("Empty transmission received.");
+   }
+   const auto encoding = static_cast<Encoding>(buffer.front());
+   std::size_t position = 1;
+   const auto jobs = static_cast<std::size_t>(getVarint(buffer, position));
+   const auto rows = static_cast<std::size_t>(getVarint(buffer, position));
+   const auto columns = static_cast<std::size_t>(getVarint(buffer, position));
+   if ( columns != 0 && rows > buffer.size() / columns )
+   {
+      throw std::invalid_argument("Bad number of bytes received.");
+   }
+   Matrix<Integer> matrix(rows, Row<Integer>(columns));
+   getCoefficients(encoding, buffer, position, matrix);
+   getSupports(buffer, position, supports);
+   if ( position != buffer.size() )
+   {
+      throw std::invalid_argument("Bad number of bytes received.");
+   }
+   return std::make_pair(std::move(matrix), jobs);
+}
+
+namespace
+{
+   template <typename Integer>
+   void putCoefficients(const Matrix<Integer>& matrix, const std::size_t jobs, std::vector<char>& buffer)
+   {
+      using Type = typename Word<Integer>::Type;
+      const auto rows = matrix.size();
+      const auto columns = matrix.empty() ? std::size_t{0} : matrix.front().size();
+      const auto header = putHeader(Encoding::Varint, jobs, rows, columns, buffer);
+      const auto plain = header + rows * columns * sizeof(Type);
+      for ( std::size_t i = 0; i < rows; ++i )
+      {
+         for ( std::size_t j = 0; j < columns; ++j )
+         {
+            // differences are taken modulo 2^64, hence they are exact for every width.
+            const auto above = ( i == 0 ) ? std::int64_t{0} : std::int64_t{Word<Integer>::get(matrix[i - 1][j])};
+            const auto value = std::int64_t{Word<Integer>::get(matrix[i][j])};
+            const auto difference = static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(above);
+            putVarint(zigzag(static_cast<std::int64_t>(difference)), buffer);
+         }
+         if ( buffer.size() > plain ) // large coefficients, hence plain words are shorter.
+         {
+            buffer.clear();
+            putHeader(Encoding::Plain, jobs, rows, columns, buffer);
+            buffer.resize(plain);
+            auto* target = buffer.data() + header;
+            for ( const auto& row : matrix )
+            {
+               for ( const auto& value : row )
+               {
+                  const Type word = Word<Integer>::get(value);
+                  std::memcpy(target, &word, sizeof(word));
+                  target += sizeof(word);
+               }
+            }
+            return;
+         }
+      }
+   }
+
+   void putCoefficients(const Matrix<BigInteger>& matrix, const std::size_t jobs, std::vector<char>& buffer)
+   {
+      const auto columns = matrix.empty() ? std::size_t{0} : matrix.front().size();
+      putHeader(Encoding::Limbs, jobs, matrix.size(), columns, buffer);
+      for ( const auto& row : matrix )
+      {
+         for ( const auto& value : row )
+         {
+            const bool negative = value < 0;
+            const auto limbs = value.limbs();
+            if ( limbs.size() == 1 && limbs.front() < small_limit )
+            {
+               const auto magnitude = static_cast<std::int64_t>(limbs.front());
+               putVarint(zigzag(negative ? -magnitude : magnitude) << 1, buffer);
+               continue;
+            }
+            putVarint((limbs.size() << 2) | (negative ? 2 : 0) | 1, buffer);
+            const auto offset = buffer.size();
+            buffer.resize(offset + limbs.size() * sizeof(std::uint64_t));
+            std::memcpy(buffer.data() + offset, limbs.data(), limbs.size() * sizeof(std::uint64_t));
+         }
+      }
+   }
+
+   template <typename Integer>
+   void getCoefficients(const Encoding encoding, const std::vector<char>& buffer, std::size_t& position, Matrix<Integer>& matrix)
+   {
+      using Type = typename Word<Integer>::Type;
+      const auto columns = matrix.empty() ? std::size_t{0} : matrix.front().size();
+      if ( encoding == Encoding::Plain )
+      {
+         if ( buffer.size() - position < matrix.size() * columns * sizeof(Type) )
+         {
+            throw std::invalid_argument("Bad number of bytes received.");
+         }
+         for ( auto& row : matrix )
+         {
+            for ( auto& value : row )
+            {
+               Type word;
+               std::memcpy(&word, buffer.data() + position, sizeof(word));
+               value = Word<Integer>::make(word);
+               position += sizeof(word);
+            }
+         }
+         return;
+      }
+      if ( encoding != Encoding::Varint )
+      {
+         throw std::invalid_argument("Unknown encoding of transmission.");
+      }
+      for ( std::size_t i = 0; i < matrix.size(); ++i )
+      {
+         for ( std::size_t j = 0; j < columns; ++j )
+         {
+            const auto above = ( i == 0 ) ? std::int64_t{0} : std::int64_t{Word<Integer>::get(matrix[i - 1][j])};
+            const auto difference = static_cast<std::uint64_t>(unzigzag(getVarint(buffer, position)));
+            const auto value = static_cast<std::int64_t>(static_cast<std::uint64_t>(above) + difference);
+            const auto word = static_cast<Type>(value);
+            if ( std::int64_t{word} != value )
+            {
+               throw std::invalid_argument("Coefficient out of range received.");
+            }
+            matrix[i][j] = Word<Integer>::make(word);
+         }
+      }
+   }
+
+   void getCoefficients(const Encoding encoding, const std::vector<char>& buffer, std::size_t& position, Matrix<BigInteger>& matrix)
+   {
+      if ( encoding != Encoding::Limbs )
+      {
+         throw std::invalid_argument("Unknown encoding of transmission.");
+      }
+      std::vector<std::uint64_t> limbs;
+      for ( auto& row : matrix )
+      {
+         for ( auto& value : row )
+         {
+            const auto head = getVarint(buffer, position);
+            if ( (head & 1) == 0 )
+            {
+               value = BigInteger(unzigzag(head >> 1));
+               continue;
+            }
+            const auto count = static_cast<std::size_t>(head >> 2);
+            if ( count > (buffer.size() - position) / sizeof(std::uint64_t) )
+            {
+               throw std::invalid_argument("Truncated transmission received.");
+            }
+            limbs.resize(count);
+            std::memcpy(limbs.data(), buffer.data() + position, count * sizeof(std::uint64_t));
+            position += count * sizeof(std::uint64_t);
+            value = BigInteger((head & 2) != 0, limbs);
+         }
+      }
+   }
+
+   void putSupports(const std::vector<Support>& supports, std::vector<char>& buffer)
+   {
+      putVarint(supports.size(), buffer);
+      if ( supports.empty() )
+      {
+         return;
+      }
+      putVarint(supports.front().size(), buffer);
+      for ( const auto& support : supports )
+      {
+         assert( support.size() == supports.front().size() );
+         const auto& words = support.words();
+         const auto offset = buffer.size();
+         buffer.resize(offset + words.size() * sizeof(Support::Word));
+         std::memcpy(buffer.data() + offset, words.data(), words.size() * sizeof(Support::Word));
+      }
+   }
+
+   void getSupports(const std::vector<char>& buffer, std::size_t& position, std::vector<Support>& supports)
+   {
+      const auto count = static_cast<std::size_t>(getVarint(buffer, position));
+      supports.clear();
+      if ( count == 0 )
+      {
+         return;
+      }
+      const auto vertices = static_cast<std::size_t>(getVarint(buffer, position));
+      const auto words = vertices / 64 + ( vertices % 64 == 0 ? 0 : 1 );
+      const auto available = (buffer.size() - position) / sizeof(Support::Word);
+      if ( words == 0 || words > available || count > available / words )
+      {
+         throw std::invalid_argument("Truncated transmission received.");
+      }
+      const auto bytes = words * sizeof(Support::Word);
+      supports.assign(count, Support(vertices));
+      for ( auto& support : supports )
+      {
+         std::memcpy(support.words().data(), buffer.data() + position, bytes);
+         position += bytes;
+      }
+   }
+
+   void putVarint(std::uint64_t value, std::vector<char>& buffer)
+   {
+      while ( value >= 0x80 )
+      {
+         buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+         value >>= 7;
+      }
+      buffer.push_back(static_cast<char>(value));
+   }
+
+   std::uint64_t getVarint(const std::vector<char>& buffer, std::size_t& position)
+   {
+      std::uint64_t value = 0;
+      for ( unsigned int shift = 0; shift < 64; shift += 7 )
+      {
+         if ( position == buffer.size() )
+         {
+            throw std::invalid_argument("Truncated transmission received.");
+         }
+         const auto byte = static_cast<unsigned char>(buffer[position++]);
+         value |= std::uint64_t{byte & 0x7Fu} << shift;
+         if ( (byte & 0x80) == 0 )
+         {
+            return value;
+         }
+      }
+      throw std::invalid_argument("Malformed transmission received.");
+   }
+
+   std::uint64_t zigzag(const std::int64_t value) noexcept
+   {
+      return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+   }
+
+   std::int64_t unzigzag(const std::uint64_t value) noexcept
+   {
+      return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+   }
+
+   std::size_t putHeader(const Encoding encoding, const std::size_t jobs, const std::size_t rows, const std::size_t columns, std::vector<char>& buffer)
+   {
+      buffer.push_back(static_cast<char>(encoding));
+      putVarint(jobs, buffer);
+      putVarint(rows, buffer);
+      putVarint(columns, buffer);
+      return buffer.size();
+   }
+}
+
@@ -0,0 +1,41 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "matrix.h"
+#include "support.h"
+
+namespace panda
+{
+   namespace serialization
+   {
+      /// Encodes a matrix and a number of jobs into one contiguous buffer (previous
+      /// content is overwritten, the capacity is reused). The header holds the encoding,
+      /// the number of jobs, rows and columns. Fixed width coefficients are stored as
+      /// zig-zag varints of the difference to the coefficient above, unless plain words
+      /// of their width are shorter. Coefficients of arbitrary precision are stored as
+      /// varints if they are small, and as length-prefixed 64-bit limbs otherwise.
+      template <typename Integer>
+      void pack(const Matrix<Integer>&, std::size_t, std::vector<char>&);
+      /// Like pack, followed by supports (e.g. the canonical supports of the rows), which
+      /// all have the same number of vertices and are stored as plain words.
+      template <typename Integer>
+      void pack(const Matrix<Integer>&, const std::vector<Support>&, std::size_t, std::vector<char>&);
+      /// Decodes a matrix and its number of jobs from a buffer created by pack.
+      template <typename Integer>
+      std::pair<Matrix<Integer>, std::size_t> unpack(const std::vector<char>&);
+      /// Like unpack, the supports are stored in the last argument.
+      template <typename Integer>
+      std::pair<Matrix<Integer>, std::size_t> unpack(const std::vector<char>&, std::vector<Support>&);
+   }
+}
+
+#include "matrix_serialization.eti"
+
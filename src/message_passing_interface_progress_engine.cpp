@@ -0,0 +1,224 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "message_passing_interface_progress_engine.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include "message_passing_interface_session.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Without any progress, the thread sleeps between polls. The sleep doubles up to the
+   /// maximum, such that an idle process costs (almost) no CPU time.
+   constexpr std::chrono::microseconds minimum_backoff(1);
+   constexpr std::chrono::microseconds maximum_backoff(500);
+   /// Maximal number of idle buffers kept for reuse.
+   constexpr std::size_t pool_capacity = 256;
+}
+
+mpi::ProgressEngine& panda::mpi::getProgressEngine()
+{
+   // the session is constructed first, hence it is destroyed (MPI_Finalize) after the engine.
+   getSession();
+   static ProgressEngine engine(createTransport());
+   return engine;
+}
+
+std::future<void> panda::mpi::ProgressEngine::send(Buffer&& buffer, const int destination, const int tag)
+{
+   std::promise<void> promise;
+   auto future = promise.get_future();
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      assert( !stopping );
+      queued.push_back(Outgoing{std::move(buffer), destination, tag, std::move(promise)});
+   }
+   condition.notify_one();
+   return future;
+}
+
+std::future<mpi::ProgressEngine::Buffer> panda::mpi::ProgressEngine::receive(const int source, const int tag)
+{
+   return request(source, tag).first;
+}
+
+std::optional<mpi::ProgressEngine::Buffer> panda::mpi::ProgressEngine::receive(const int source, const int tag, const std::chrono::steady_clock::time_point deadline)
+{
+   auto requested = request(source, tag);
+   auto& future = requested.first;
+   if ( future.wait_until(deadline) != std::future_status::ready )
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto& waiting = expected[Key{source, tag}];
+      const auto it = std::find_if(waiting.begin(), waiting.end(), [&](const Waiting& caller) { return caller.id == requested.second; });
+      if ( it != waiting.end() )
+      {
+         waiting.erase(it);
+         return std::nullopt;
+      }
+      // the message was delivered in the meantime.
+   }
+   return future.get();
+}
+
+std::pair<std::future<mpi::ProgressEngine::Buffer>, std::size_t> panda::mpi::ProgressEngine::request(const int source, const int tag)
+{
+   std::promise<Buffer> promise;
+   auto future = promise.get_future();
+   std::lock_guard<std::mutex> lock(mutex);
+   for ( auto& messages : arrived )
+   {
+      const auto matches = ( source == any_source || messages.first.first == source ) && messages.first.second == tag;
+      if ( matches && !messages.second.empty() )
+      {
+         promise.set_value(std::move(messages.second.front()));
+         messages.second.pop_front();
+         return std::make_pair(std::move(future), std::size_t{0});
+      }
+   }
+   const auto id = next_waiting++;
+   expected[Key{source, tag}].push_back(Waiting{id, std::move(promise)});
+   return std::make_pair(std::move(future), id);
+}
+
+mpi::ProgressEngine::Buffer panda::mpi::ProgressEngine::acquire()
+{
+   return pool.acquire();
+}
+
+void panda::mpi::ProgressEngine::release(Buffer&& buffer)
+{
+   pool.release(std::move(buffer));
+}
+
+void panda::mpi::ProgressEngine::abandon(const int id)
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   abandoned.insert(id);
+}
+
+panda::mpi::ProgressEngine::ProgressEngine(std::unique_ptr<Transport> transport_)
+:
+   pool(pool_capacity),
+   transport(std::move(transport_)),
+   mutex(),
+   condition(),
+   stopping(false),
+   queued(),
+   posted(),
+   abandoned(),
+   arrived(),
+   expected(),
+   next_waiting(1),
+   thread([this]() { run(); })
+{
+}
+
+panda::mpi::ProgressEngine::~ProgressEngine()
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+   }
+   condition.notify_one();
+}
+
+void panda::mpi::ProgressEngine::run()
+{
+   std::size_t next_ticket = 0;
+   std::vector<std::size_t> completed;
+   std::vector<std::size_t> failed;
+   std::vector<Transport::Message> received;
+   auto backoff = minimum_backoff;
+   while ( true )
+   {
+      std::deque<Outgoing> posting;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         // messages to abandoned IDs may never be sent.
+         const auto abandoned_only = [&](const std::pair<const std::size_t, Outgoing>& message)
+         {
+            return abandoned.count(message.second.destination) > 0;
+         };
+         if ( stopping && queued.empty() && std::all_of(posted.begin(), posted.end(), abandoned_only) )
+         {
+            break;
+         }
+         posting.swap(queued);
+      }
+      bool progress = !posting.empty();
+      completed.clear();
+      failed.clear();
+      received.clear();
+      for ( auto& message : posting )
+      {
+         // elements of a map keep their address, hence the buffer stays valid until it is sent.
+         const auto ticket = next_ticket++;
+         const auto& outgoing = posted.emplace(ticket, std::move(message)).first->second;
+         if ( !transport->post(outgoing.buffer, outgoing.destination, outgoing.tag, ticket) )
+         {
+            failed.push_back(ticket);
+         }
+      }
+      progress = transport->poll(completed, failed, received, pool) || progress;
+      for ( const auto ticket : completed )
+      {
+         auto it = posted.find(ticket);
+         assert( it != posted.end() );
+         it->second.promise.set_value();
+         pool.release(std::move(it->second.buffer));
+         posted.erase(it);
+      }
+      // the sender decides what a failed message means (e.g. the lease of a slave expires).
+      for ( const auto ticket : failed )
+      {
+         auto it = posted.find(ticket);
+         assert( it != posted.end() );
+         it->second.promise.set_exception(std::make_exception_ptr(std::runtime_error("A message couldn't be sent.")));
+         pool.release(std::move(it->second.buffer));
+         posted.erase(it);
+      }
+      for ( auto& message : received )
+      {
+         deliver(message.source, message.tag, std::move(message.buffer));
+      }
+      if ( progress )
+      {
+         backoff = minimum_backoff;
+         continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      // only new messages cut the wait short: while sends are still posted after stop, the
+      // check at the top of the loop ends it, and waking up on stopping would spin.
+      condition.wait_for(lock, backoff, [&]() { return !queued.empty(); });
+      backoff = std::min(2 * backoff, maximum_backoff);
+   }
+}
+
+void panda::mpi::ProgressEngine::deliver(const int source, const int tag, Buffer&& buffer)
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   // callers waiting for this source are served before those waiting for any source.
+   for ( const auto waiting_source : { source, any_source } )
+   {
+      auto& waiting = expected[Key{waiting_source, tag}];
+      if ( !waiting.empty() )
+      {
+         waiting.front().promise.set_value(std::move(buffer));
+         waiting.pop_front();
+         return;
+      }
+   }
+   arrived[Key{source, tag}].push_back(std::move(buffer));
+}
+
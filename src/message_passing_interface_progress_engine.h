@@ -0,0 +1,114 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "joining_thread.h"
+#include "message_passing_interface_transport.h"
+
+namespace panda
+{
+   namespace mpi
+   {
+      class ProgressEngine;
+
+      /// Returns a reference to the progress engine of this process (started on first use).
+      ProgressEngine& getProgressEngine();
+
+      /// A dedicated thread that makes all calls of the transport (MPI or shared memory) of
+      /// the process. Other threads hand messages over and wait for futures, hence they don't
+      /// need to poll. The thread receives every incoming message eagerly and keeps it until
+      /// it is asked for.
+      class ProgressEngine
+      {
+         public:
+            using Buffer = BufferPool::Buffer;
+            /// Source of a receive call that matches a message from any ID.
+            static constexpr int any_source = -1;
+            /// Queues a message to ID with Tag. The future is ready once the message is sent,
+            /// the buffer is returned to the pool then. If the transport fails to send it, the
+            /// future holds a std::runtime_error instead.
+            std::future<void> send(Buffer&&, int, int);
+            /// Returns a future for the next message from ID (or any_source) with Tag. Messages
+            /// from the same ID with the same Tag are delivered in the order they were sent.
+            std::future<Buffer> receive(int, int);
+            /// Like receive, but waits until the time point at most. Returns std::nullopt if no
+            /// message arrived by then. The receive is withdrawn in that case, hence a message
+            /// arriving later is kept for the next caller.
+            std::optional<Buffer> receive(int, int, std::chrono::steady_clock::time_point);
+            /// Returns an empty buffer from the pool of the engine.
+            Buffer acquire();
+            /// Returns a buffer (e.g. a received message that has been decoded) to the pool.
+            void release(Buffer&&);
+            /// Gives up on ID (e.g. a node that failed): messages to it that aren't sent yet
+            /// don't keep the destructor from returning.
+            void abandon(int);
+            /// Constructor: starts the thread, which makes all calls of the transport.
+            explicit ProgressEngine(std::unique_ptr<Transport>);
+            /// Destructor: sends the queued messages, then stops the thread.
+            ~ProgressEngine();
+            /// Copy construction is not allowed.
+            ProgressEngine(const ProgressEngine&) = delete;
+            /// Copy assignment is not allowed.
+            ProgressEngine& operator=(const ProgressEngine&) = delete;
+         private:
+            /// Loop of the thread.
+            void run();
+            /// Hands a received message to the first caller waiting for it, or stores it.
+            void deliver(int, int, Buffer&&);
+            /// Implementation of receive: returns the future and the ID of the waiting caller
+            /// (zero if the message had arrived already).
+            std::pair<std::future<Buffer>, std::size_t> request(int, int);
+         private:
+            struct Outgoing
+            {
+               Buffer buffer;
+               int destination;
+               int tag;
+               std::promise<void> promise;
+            };
+            /// A caller waiting for a message.
+            struct Waiting
+            {
+               std::size_t id;
+               std::promise<Buffer> promise;
+            };
+            using Key = std::pair<int, int>;
+            BufferPool pool;
+            const std::unique_ptr<Transport> transport;
+            std::mutex mutex;
+            std::condition_variable condition;
+            bool stopping;
+            /// messages handed over, but not yet posted.
+            std::deque<Outgoing> queued;
+            /// messages posted, but not yet sent (only accessed by the thread).
+            std::map<std::size_t, Outgoing> posted;
+            /// IDs given up on.
+            std::set<int> abandoned;
+            /// messages received, but not yet asked for.
+            std::map<Key, std::deque<Buffer>> arrived;
+            /// callers waiting for messages that haven't arrived yet.
+            std::map<Key, std::deque<Waiting>> expected;
+            /// ID of the next caller waiting for a message.
+            std::size_t next_waiting;
+            /// vital implementation detail: the thread accesses the other members, hence it is destroyed first.
+            JoiningThread thread;
+      };
+   }
+}
+
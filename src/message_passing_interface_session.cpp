@@ -8,7 +8,12 @@
 
 #include <cassert>
 
+#include "local_processes.h"
+
 #ifdef MPI_SUPPORT
+#include <iostream>
+#include <thread>
+
 #include "mpi_no_warnings.h"
 #endif
 
@@ -21,45 +26,95 @@ mpi::Session& panda::mpi::getSession() noexcept
    return session;
 }
 
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wold-style-cast"
-
 bool panda::mpi::Session::isMaster() const noexcept
 {
-   #ifdef MPI_SUPPORT
-   int rank;
-   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
    return rank == 0;
-   #else
-   return true;
-   #endif
+}
+
+int panda::mpi::Session::getRank() const noexcept
+{
+   return rank;
 }
 
 int panda::mpi::Session::getNumberOfNodes() const noexcept
 {
-   #ifdef MPI_SUPPORT
-   int size;
-   MPI_Comm_size(MPI_COMM_WORLD, &size);
    assert( size > 0 );
    return size;
-   #else
-   return 1;
-   #endif
 }
 
-#pragma clang diagnostic pop
+void panda::mpi::Session::limitFinalization(const std::optional<std::chrono::seconds>& patience_) noexcept
+{
+   patience = patience_;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wold-style-cast"
 
 panda::mpi::Session::Session() noexcept
+:
+   rank(0),
+   size(1),
+   initialized(false),
+   patience()
 {
+   const auto* processes = local::group();
+   if ( processes != nullptr )
+   {
+      // local processes communicate through shared memory, MPI isn't used.
+      rank = processes->rank;
+      size = processes->size;
+      return;
+   }
    #ifdef MPI_SUPPORT
-   MPI_Init(nullptr, nullptr);
+   initialized = true;
+   // all communication is done by the progress engine, but that isn't the main thread.
+   int provided;
+   MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &provided);
+   if ( provided < MPI_THREAD_SERIALIZED )
+   {
+      std::cerr << "Warning: the MPI implementation doesn't support calls from a thread other than the main thread.\n";
+   }
+   // errors are fatal until the handler is replaced, hence these calls needn't be checked.
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &size);
+   // a failed node costs its leases only (see JobManager), instead of aborting all nodes.
+   // The transport checks the return code of every call.
+   if ( MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_RETURN) != MPI_SUCCESS )
+   {
+      std::cerr << "Warning: the errors of MPI stay fatal, a failed node aborts all nodes.\n";
+   }
    #endif
 }
 
 panda::mpi::Session::~Session()
 {
    #ifdef MPI_SUPPORT
-   MPI_Finalize();
+   if ( initialized )
+   {
+      if ( patience )
+      {
+         // the progress engine is gone, hence this thread may call MPI.
+         const auto deadline = std::chrono::steady_clock::now() + *patience;
+         MPI_Request request;
+         int done = 0;
+         if ( MPI_Ibarrier(MPI_COMM_WORLD, &request) == MPI_SUCCESS )
+         {
+            while ( MPI_Test(&request, &done, MPI_STATUS_IGNORE) == MPI_SUCCESS && done == 0 && (rank != 0 || std::chrono::steady_clock::now() < deadline) )
+            {
+               std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+         }
+         if ( done == 0 && rank == 0 )
+         {
+            // the results are complete, the nodes that didn't get here are given up on.
+            std::cout.flush();
+            std::cerr << "Not all nodes ended in time, they are aborted.\n";
+            MPI_Abort(MPI_COMM_WORLD, 0);
+         }
+      }
+      MPI_Finalize();
+   }
    #endif
 }
 
+#pragma clang diagnostic pop
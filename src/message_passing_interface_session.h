@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
+#include <optional>
 
 namespace panda
 {
@@ -22,14 +24,30 @@ namespace panda
          public:
             /// Returns true if the node ID is zero.
             bool isMaster() const noexcept;
+            /// Returns the node ID.
+            int getRank() const noexcept;
             /// Returns the number of nodes in the setup.
             int getNumberOfNodes() const noexcept;
+            /// Limits the time the nodes wait for each other before MPI is finalized (std::nullopt:
+            /// no limit). If a node doesn't get there in time, e.g. because it stopped, the master
+            /// aborts all nodes, as MPI_Finalize would wait for it forever. Has to be called with
+            /// the same limit on all nodes.
+            void limitFinalization(const std::optional<std::chrono::seconds>&) noexcept;
             friend mpi::Session& mpi::getSession() noexcept;
          private:
             /// Constructor.
             Session() noexcept;
             /// Destructor.
             ~Session();
+         private:
+            /// ID of this node, queried once, such that only the progress engine calls MPI afterwards.
+            int rank;
+            /// number of nodes, queried once.
+            int size;
+            /// true if MPI has been initialized by this session (not for local processes).
+            bool initialized;
+            /// time the nodes wait for each other before MPI is finalized.
+            std::optional<std::chrono::seconds> patience;
       };
    }
 }
@@ -0,0 +1,198 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "message_passing_interface_transport.h"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef MPI_SUPPORT
+#include <cstdlib>
+#include <iostream>
+#endif
+
+#include "local_processes.h"
+#include "shared_memory_transport.h"
+
+#ifdef MPI_SUPPORT
+#include "mpi_no_warnings.h"
+#endif
+
+using namespace panda;
+
+#ifdef MPI_SUPPORT
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wold-style-cast"
+
+namespace
+{
+   /// Transport with MPI: non-blocking sends, and every message that has arrived is
+   /// received (the size of a message is known from its probe). The errors of MPI are
+   /// returned (see Session): a send that fails is reported with its ticket, hence it ends
+   /// the lease of the slave. A receive that fails can't be attributed to a node, it ends
+   /// all processes.
+   class MessagePassingTransport : public mpi::Transport
+   {
+      public:
+         bool post(const Buffer&, int, int, std::size_t) override;
+         bool poll(std::vector<std::size_t>&, std::vector<std::size_t>&, std::vector<Message>&, BufferPool&) override;
+         /// Constructor.
+         MessagePassingTransport();
+         /// Destructor.
+         ~MessagePassingTransport() override;
+      private:
+         /// posted sends and their tickets, in the same order.
+         std::vector<MPI_Request> requests;
+         std::vector<std::size_t> tickets;
+         std::vector<int> indices;
+         std::vector<MPI_Status> statuses;
+   };
+   /// Ends all processes after an error of the MPI function with the given name.
+   [[noreturn]] void abort(const char*, int);
+}
+
+#endif // MPI_SUPPORT
+
+panda::mpi::Transport::~Transport() = default;
+
+std::unique_ptr<mpi::Transport> panda::mpi::createTransport()
+{
+   const auto* processes = local::group();
+   if ( processes != nullptr )
+   {
+      return std::unique_ptr<Transport>(new local::SharedMemoryTransport(*processes));
+   }
+   #ifdef MPI_SUPPORT
+   return std::unique_ptr<Transport>(new MessagePassingTransport());
+   #else
+   throw std::logic_error("Communication between processes needs MPI support or local processes (\"--processes=<n>\").");
+   #endif
+}
+
+#ifdef MPI_SUPPORT
+
+namespace
+{
+   bool MessagePassingTransport::post(const Buffer& buffer, const int destination, const int tag, const std::size_t ticket)
+   {
+      MPI_Request request;
+      if ( MPI_Isend(buffer.data(), static_cast<int>(buffer.size()), MPI_BYTE, destination, tag, MPI_COMM_WORLD, &request) != MPI_SUCCESS )
+      {
+         return false;
+      }
+      requests.push_back(request);
+      tickets.push_back(ticket);
+      return true;
+   }
+
+   bool MessagePassingTransport::poll(std::vector<std::size_t>& completed, std::vector<std::size_t>& failed, std::vector<Message>& received, BufferPool& pool)
+   {
+      bool progress = false;
+      if ( !requests.empty() )
+      {
+         indices.resize(requests.size());
+         statuses.resize(requests.size());
+         int count = 0;
+         const auto code = MPI_Testsome(static_cast<int>(requests.size()), requests.data(), &count, indices.data(), statuses.data());
+         if ( code != MPI_SUCCESS && code != MPI_ERR_IN_STATUS )
+         {
+            abort("MPI_Testsome", code);
+         }
+         if ( count != MPI_UNDEFINED && count > 0 )
+         {
+            progress = true;
+            for ( int i = 0; i < count; ++i )
+            {
+               const auto k = static_cast<std::size_t>(i);
+               const auto index = static_cast<std::size_t>(indices[k]);
+               // the error field is only set if some request failed.
+               if ( code == MPI_ERR_IN_STATUS && statuses[k].MPI_ERROR != MPI_SUCCESS )
+               {
+                  failed.push_back(tickets[index]);
+                  if ( requests[index] != MPI_REQUEST_NULL )
+                  {
+                     MPI_Request_free(&requests[index]);
+                  }
+               }
+               else
+               {
+                  completed.push_back(tickets[index]);
+               }
+            }
+            // completed requests have been set to MPI_REQUEST_NULL.
+            std::size_t kept = 0;
+            for ( std::size_t i = 0; i < requests.size(); ++i )
+            {
+               if ( requests[i] != MPI_REQUEST_NULL )
+               {
+                  requests[kept] = requests[i];
+                  tickets[kept] = tickets[i];
+                  ++kept;
+               }
+            }
+            requests.resize(kept);
+            tickets.resize(kept);
+         }
+      }
+      while ( true ) // receive everything that arrived, the size of a message is known from its probe.
+      {
+         int flag = 0;
+         MPI_Message message;
+         MPI_Status status;
+         auto code = MPI_Improbe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &message, &status);
+         if ( code != MPI_SUCCESS )
+         {
+            abort("MPI_Improbe", code);
+         }
+         if ( !flag )
+         {
+            break;
+         }
+         int bytes = 0;
+         code = MPI_Get_count(&status, MPI_BYTE, &bytes);
+         if ( code != MPI_SUCCESS || bytes == MPI_UNDEFINED )
+         {
+            abort("MPI_Get_count", code);
+         }
+         auto buffer = pool.acquire();
+         buffer.resize(static_cast<std::size_t>(bytes));
+         code = MPI_Mrecv(buffer.data(), bytes, MPI_BYTE, &message, MPI_STATUS_IGNORE);
+         if ( code != MPI_SUCCESS )
+         {
+            abort("MPI_Mrecv", code);
+         }
+         received.push_back(Message{status.MPI_SOURCE, status.MPI_TAG, std::move(buffer)});
+         progress = true;
+      }
+      return progress;
+   }
+
+   MessagePassingTransport::MessagePassingTransport()
+   :
+      requests(),
+      tickets(),
+      indices(),
+      statuses()
+   {
+   }
+
+   MessagePassingTransport::~MessagePassingTransport() = default;
+
+   void abort(const char* function, const int code)
+   {
+      std::cerr << "Error: " << function << " failed with code " << code << ", a received message would be lost.\n";
+      MPI_Abort(MPI_COMM_WORLD, 1);
+      std::abort();
+   }
+}
+
+#pragma clang diagnostic pop
+#pragma GCC diagnostic pop
+
+#endif // MPI_SUPPORT
+
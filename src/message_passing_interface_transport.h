@@ -0,0 +1,55 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "buffer_pool.h"
+
+namespace panda
+{
+   namespace mpi
+   {
+      /// Moves messages between the processes (MPI or shared memory, see createTransport).
+      /// Only the progress engine calls a transport, hence it needn't be thread safe.
+      class Transport
+      {
+         public:
+            using Buffer = BufferPool::Buffer;
+            /// A received message.
+            struct Message
+            {
+               int source;
+               int tag;
+               Buffer buffer;
+            };
+            /// Starts sending the buffer to ID with Tag. The buffer has to stay valid until the
+            /// ticket (last argument) is reported by poll. Returns false if the message can't be
+            /// sent, the ticket isn't reported then.
+            virtual bool post(const Buffer&, int, int, std::size_t) = 0;
+            /// Makes progress without blocking: the tickets of the messages that are sent are
+            /// appended to the first argument, those of messages that failed to the second and the
+            /// messages received to the third (with buffers from the pool). Returns true if
+            /// anything happened.
+            virtual bool poll(std::vector<std::size_t>&, std::vector<std::size_t>&, std::vector<Message>&, BufferPool&) = 0;
+            /// Destructor.
+            virtual ~Transport();
+            /// Default constructor.
+            Transport() = default;
+            /// Copy construction is not allowed.
+            Transport(const Transport&) = delete;
+            /// Copy assignment is not allowed.
+            Transport& operator=(const Transport&) = delete;
+      };
+
+      /// Returns the transport of this process: shared memory between the local processes
+      /// ("--processes=<n>"), MPI otherwise.
+      std::unique_ptr<Transport> createTransport();
+   }
+}
+
@@ -6,17 +6,25 @@
 
 #include "method_adjacency_decomposition.h"
 
+#include <chrono>
 #include <exception>
 #include <iostream>
+#include <optional>
 
 #include "application_name.h"
 #include "delayed_action.h"
+#include "distributed_job_manager.h"
+#include "distributed_mode.h"
 #include "input.h"
 #include "integer_type_selection.h"
 #include "job_manager.h"
 #include "job_manager_proxy.h"
+#include "lease_duration.h"
+#include "local_processes.h"
+#include "master_hierarchy.h"
 #include "message_passing_interface_session.h"
 #include "method_adjacency_decomposition_implementation.h"
+#include "sub_master_job_manager.h"
 
 using namespace panda;
 
@@ -35,34 +43,76 @@ namespace
    {
       static int call(int, char**);
    };
+
+   /// Starts the local processes (if requested), returns false on failure.
+   bool launchLocalProcesses(int, char**);
+   /// Ends the processes of the run, given the exit code of this one. With a lease, they wait
+   /// for each other no longer than for a batch: a process that stopped is killed (local
+   /// processes) or all are aborted (MPI) then. Returns the exit code.
+   int finish(int, int, char**);
 }
 
 template <>
 int panda::method::adjacencyDecomposition<OperationMode::FacetEnumeration>(int argc, char** argv)
 {
    assert( argc > 0 && argv != nullptr );
+   if ( !launchLocalProcesses(argc, argv) )
+   {
+      return 1;
+   }
    const auto& mpi_session = mpi::getSession();
    if ( mpi_session.isMaster() )
    {
       std::cerr << project::application_acronym << " -- facet enumeration with adjacency decomposition\n";
    }
-   return IntegerTypeSelector<FacetEnumerationAdjacencyDecomposition>::select(argc, argv);
+   return finish(IntegerTypeSelector<FacetEnumerationAdjacencyDecomposition>::select(argc, argv), argc, argv);
 }
 
 template <>
 int panda::method::adjacencyDecomposition<OperationMode::VertexEnumeration>(int argc, char** argv)
 {
    assert( argc > 0 && argv != nullptr );
+   if ( !launchLocalProcesses(argc, argv) )
+   {
+      return 1;
+   }
    const auto& mpi_session = mpi::getSession();
    if ( mpi_session.isMaster() )
    {
       std::cerr << project::application_acronym << " -- vertex enumeration with adjacency decomposition\n";
    }
-   return IntegerTypeSelector<VertexEnumerationAdjacencyDecomposition>::select(argc, argv);
+   return finish(IntegerTypeSelector<VertexEnumerationAdjacencyDecomposition>::select(argc, argv), argc, argv);
 }
 
 namespace
 {
+   bool launchLocalProcesses(int argc, char** argv)
+   try
+   {
+      local::launch(argc, argv);
+      return true;
+   }
+   catch ( const std::exception& e )
+   {
+      std::cerr << "Exception caught: " << e.what() << '\n';
+      return false;
+   }
+
+   int finish(const int exit_code, int argc, char** argv)
+   {
+      std::optional<std::chrono::seconds> patience;
+      try
+      {
+         patience = lease::duration(argc, argv);
+      }
+      catch ( const std::exception& )
+      {
+         // the run has reported the bad option already.
+      }
+      mpi::getSession().limitFinalization(patience);
+      return local::join(exit_code, patience);
+   }
+
    template <typename Integer>
    int FacetEnumerationAdjacencyDecomposition<Integer>::call(int argc, char** argv)
    try
@@ -70,10 +120,18 @@ namespace
       assert( argc > 0 && argv != nullptr );
       auto data = input::vertices<Integer>(argc, argv);
       const auto& mpi_session = mpi::getSession();
-      if ( mpi_session.isMaster() )
+      if ( distribution::enabled(argc, argv) )
+      {
+         implementation::adjacencyDecomposition<DistributedJobManager>(argc, argv, data, tag::facet{});
+      }
+      else if ( mpi_session.isMaster() )
       {
          implementation::adjacencyDecomposition<JobManager>(argc, argv, data, tag::facet{});
       }
+      else if ( hierarchy::isSubMaster(mpi_session.getRank(), hierarchy::subMasters(argc, argv, mpi_session.getNumberOfNodes())) )
+      {
+         implementation::adjacencyDecomposition<SubMasterJobManager>(argc, argv, data, tag::facet{});
+      }
       else
       {
          implementation::adjacencyDecomposition<JobManagerProxy>(argc, argv, data, tag::facet{});
@@ -98,10 +156,18 @@ namespace
       assert( argc > 0 && argv != nullptr );
       auto data = input::inequalities<Integer>(argc, argv);
       const auto& mpi_session = mpi::getSession();
-      if ( mpi_session.isMaster() )
+      if ( distribution::enabled(argc, argv) )
+      {
+         implementation::adjacencyDecomposition<DistributedJobManager>(argc, argv, data, tag::vertex{});
+      }
+      else if ( mpi_session.isMaster() )
       {
          implementation::adjacencyDecomposition<JobManager>(argc, argv, data, tag::vertex{});
       }
+      else if ( hierarchy::isSubMaster(mpi_session.getRank(), hierarchy::subMasters(argc, argv, mpi_session.getNumberOfNodes())) )
+      {
+         implementation::adjacencyDecomposition<SubMasterJobManager>(argc, argv, data, tag::vertex{});
+      }
       else
       {
          implementation::adjacencyDecomposition<JobManagerProxy>(argc, argv, data, tag::vertex{});
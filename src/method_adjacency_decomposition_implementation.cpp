@@ -17,39 +17,65 @@
 
 #include "algorithm_classes.h"
 #include "algorithm_fourier_motzkin_elimination.h"
+#include "algorithm_linear_automorphisms.h"
 #include "algorithm_map_operations.h"
 #include "algorithm_matrix_operations.h"
 #include "algorithm_rotation.h"
 #include "algorithm_row_operations.h"
 #include "algorithm_classes_vertex_support.h"
 #include "concurrency.h"
+#include "incidence.h"
 #include "joining_thread.h"
+#include "lease_duration.h"
+#include "map_group.h"
+#include "master_hierarchy.h"
 #include "message_passing_interface_session.h"
+#include "prefetch_depth.h"
 #include "recursion_depth.h"
+#include "symmetry_detection.h"
 #include "vertex_group.h"
 
 using namespace panda;
 
 namespace
 {
+   /// Returns the group acting on the input rows: given in the input, detected from the
+   /// input rows ("--detect-symmetry") or induced by the maps.
+   template <typename Integer, typename TagType>
+   std::optional<VertexGroup> vertexGroup(int, char**, const Matrix<Integer>&, const Maps&, const std::optional<VertexGroup>&, TagType);
+
    template <typename Integer>
    std::pair<Equations<Integer>, Maps> reduce(const JobManager<Integer, tag::facet>&, const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>, std::optional<VertexGroup>>& data);
 
    template <typename Integer>
    std::pair<Equations<Integer>, Maps> reduce(const JobManagerProxy<Integer, tag::facet>&, const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>, std::optional<VertexGroup>>& data);
 
+   template <typename Integer>
+   std::pair<Equations<Integer>, Maps> reduce(const DistributedJobManager<Integer, tag::facet>&, const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>, std::optional<VertexGroup>>& data);
+
+   template <typename Integer>
+   std::pair<Equations<Integer>, Maps> reduce(const SubMasterJobManager<Integer, tag::facet>&, const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>, std::optional<VertexGroup>>& data);
+
    template <typename Integer, template <typename, typename> class JobManagerType>
    std::pair<Equations<Integer>, Maps> reduce(const JobManagerType<Integer, tag::vertex>&, const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>, std::optional<VertexGroup>>& data);
 
    template <typename Integer>
-   std::future<void> initializePool(JobManager<Integer, tag::facet>&, const Matrix<Integer>&, const Maps&, const Matrix<Integer>&, const Equations<Integer>&);
+   std::future<void> initializePool(JobManager<Integer, tag::facet>&, const Matrix<Integer>&, const MapGroup&, const Matrix<Integer>&, const Equations<Integer>&);
 
    template <typename Integer>
-   std::future<void> initializePool(JobManager<Integer, tag::vertex>&, const Matrix<Integer>&, const Maps&, const Matrix<Integer>&, const Equations<Integer>&);
+   std::future<void> initializePool(JobManager<Integer, tag::vertex>&, const Matrix<Integer>&, const MapGroup&, const Matrix<Integer>&, const Equations<Integer>&);
 
    template <typename Integer, typename TagType>
-   std::future<void> initializePool(JobManagerProxy<Integer, TagType>&, const Matrix<Integer>&, const Maps&, const Matrix<Integer>&, const Equations<Integer>&);
+   std::future<void> initializePool(JobManagerProxy<Integer, TagType>&, const Matrix<Integer>&, const MapGroup&, const Matrix<Integer>&, const Equations<Integer>&);
 
+   template <typename Integer>
+   std::future<void> initializePool(DistributedJobManager<Integer, tag::facet>&, const Matrix<Integer>&, const MapGroup&, const Matrix<Integer>&, const Equations<Integer>&);
+
+   template <typename Integer>
+   std::future<void> initializePool(DistributedJobManager<Integer, tag::vertex>&, const Matrix<Integer>&, const MapGroup&, const Matrix<Integer>&, const Equations<Integer>&);
+
+   template <typename Integer, typename TagType>
+   std::future<void> initializePool(SubMasterJobManager<Integer, TagType>&, const Matrix<Integer>&, const MapGroup&, const Matrix<Integer>&, const Equations<Integer>&);
 }
 
 template <template <typename, typename> class JobManagerType, typename Integer, typename TagType>
@@ -65,16 +91,18 @@ void panda::implementation::adjacencyDecomposition(int argc, char** argv, const
    const auto& original_maps = std::get<2>(data);
    const auto& known_output = std::get<3>(data);
    const auto& input_vertex_group = std::get<4>(data);
-   // Use pre-built vertex group from input if available, otherwise try to build from maps
-   const auto vertex_group = input_vertex_group ? input_vertex_group : VertexGroup::create(original_maps, input);
+   const auto vertex_group = vertexGroup(argc, argv, input, original_maps, input_vertex_group, tag);
    if ( vertex_group )
    {
       std::cerr << "Using permutalib for equivalence checking\n";
    }
-   JobManagerType<Integer, TagType> job_manager(names, node_count, thread_count, vertex_group, input);
+   JobManagerType<Integer, TagType> job_manager(names, node_count, thread_count, vertex_group, input, lease::duration(argc, argv), prefetch::depth(argc, argv), hierarchy::subMasters(argc, argv, node_count));
    const auto reduced_data = reduce(job_manager, data);
    const auto& equations = std::get<0>(reduced_data);
-   const auto& maps = std::get<1>(reduced_data);
+   // the group of the maps is built once and shared by all threads.
+   const MapGroup maps(std::get<1>(reduced_data));
+   // the incidence has to outlive the threads (joined on destruction).
+   const Incidence<Integer> incidence(input);
    std::list<JoiningThread> threads;
    auto future = initializePool(job_manager, input, maps, known_output, equations);
    for ( int i = 0; i < thread_count; ++i )
@@ -89,8 +117,8 @@ void panda::implementation::adjacencyDecomposition(int argc, char** argv, const
                break;
             }
             const auto jobs = ( recursion_depth > 0 )
-               ? algorithm::rotationRecursive(input, job, maps, vertex_group, tag, recursion_depth, min_vertices, sampling)
-               : algorithm::rotation(input, job, maps, vertex_group, tag);
+               ? algorithm::rotationRecursive(incidence, job, maps, vertex_group, tag, recursion_depth, min_vertices, sampling)
+               : algorithm::rotation(incidence, job, maps, vertex_group, tag);
             job_manager.put(jobs);
          }
       });
@@ -100,6 +128,29 @@ void panda::implementation::adjacencyDecomposition(int argc, char** argv, const
 
 namespace
 {
+   template <typename Integer, typename TagType>
+   std::optional<VertexGroup> vertexGroup(int argc, char** argv, const Matrix<Integer>& input, const Maps& original_maps, const std::optional<VertexGroup>& input_vertex_group, TagType tag)
+   {
+      if ( input_vertex_group )
+      {
+         return input_vertex_group;
+      }
+      if ( !symmetry::detection(argc, argv) )
+      {
+         return VertexGroup::create(original_maps, input, tag, concurrency::numberOfThreads(argc, argv));
+      }
+      // the maps act linearly on the (homogenized) input rows, hence the detected group contains them.
+      const auto generators = algorithm::linearAutomorphisms(input);
+      if ( generators.empty() )
+      {
+         std::cerr << "Detected symmetry group is trivial\n";
+         return std::nullopt;
+      }
+      VertexGroup group(generators, input.size());
+      std::cerr << "Detected symmetry group of order " << group.order() << " (" << generators.size() << " generators)\n";
+      return group;
+   }
+
    template <typename Integer, typename Callable>
    std::pair<Equations<Integer>, Maps> reduce(const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>, std::optional<VertexGroup>>& data, Callable&& callable)
    {
@@ -133,6 +184,27 @@ namespace
       return reduce(data, [](const Matrix<Integer>&, const Names&) {});
    }
 
+   template <typename Integer>
+   std::pair<Equations<Integer>, Maps> reduce(const SubMasterJobManager<Integer, tag::facet>&, const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>, std::optional<VertexGroup>>& data)
+   {
+      return reduce(data, [](const Matrix<Integer>&, const Names&) {});
+   }
+
+   template <typename Integer>
+   std::pair<Equations<Integer>, Maps> reduce(const DistributedJobManager<Integer, tag::facet>&, const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>, std::optional<VertexGroup>>& data)
+   {
+      const bool is_master = mpi::getSession().isMaster();
+      return reduce(data, [is_master](const Matrix<Integer>& equations, const Names& names)
+      {
+         if ( is_master )
+         {
+            std::cout << "Equations:\n";
+            algorithm::prettyPrint(std::cout, equations, names, "=");
+            std::cout << '\n';
+         }
+      });
+   }
+
    template <typename Integer, template <typename, typename> class JobManagerType>
    std::pair<Equations<Integer>, Maps> reduce(const JobManagerType<Integer, tag::vertex>&, const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>, std::optional<VertexGroup>>& data)
    {
@@ -140,11 +212,11 @@ namespace
       return std::make_pair(Equations<Integer>{}, original_maps);
    }
 
-   template <typename Integer, typename TagType>
-   std::future<void> initializationOnMaster(JobManager<Integer, TagType>& manager, const Matrix<Integer>& matrix, const Maps& maps, const Matrix<Integer>& known_output, const Equations<Integer>& equations, const std::string& type_string)
+   template <typename Integer, typename TagType, template <typename, typename> class JobManagerType>
+   std::future<void> initializationOnMaster(JobManagerType<Integer, TagType>& manager, const Matrix<Integer>& matrix, const MapGroup& maps, const Matrix<Integer>& known_output, const Equations<Integer>& equations, const std::string& type_string)
    {
       assert ( (!std::is_same<TagType, tag::vertex>::value || equations.empty()) );
-      if ( !maps.empty() )
+      if ( !maps.maps().empty() )
       {
          std::cout << "Reduced ";
       }
@@ -179,23 +251,50 @@ namespace
    }
 
    template <typename Integer>
-   std::future<void> initializePool(JobManager<Integer, tag::facet>& manager, const Matrix<Integer>& matrix, const Maps& maps, const Matrix<Integer>& known_output, const Equations<Integer>& equations)
+   std::future<void> initializePool(JobManager<Integer, tag::facet>& manager, const Matrix<Integer>& matrix, const MapGroup& maps, const Matrix<Integer>& known_output, const Equations<Integer>& equations)
    {
       return initializationOnMaster(manager, matrix, maps, known_output, equations, "Inequalities");
    }
 
    template <typename Integer>
-   std::future<void> initializePool(JobManager<Integer, tag::vertex>& manager, const Matrix<Integer>& matrix, const Maps& maps, const Matrix<Integer>& known_output, const Equations<Integer>&)
+   std::future<void> initializePool(JobManager<Integer, tag::vertex>& manager, const Matrix<Integer>& matrix, const MapGroup& maps, const Matrix<Integer>& known_output, const Equations<Integer>&)
    {
       return initializationOnMaster(manager, matrix, maps, known_output, {}, "Vertices / Rays");
    }
 
    template <typename Integer, typename TagType>
-   std::future<void> initializePool(JobManagerProxy<Integer, TagType>&, const ConvexHull<Integer>&, const Maps&, const Inequalities<Integer>&, const Equations<Integer>&)
+   std::future<void> initializePool(JobManagerProxy<Integer, TagType>&, const ConvexHull<Integer>&, const MapGroup&, const Inequalities<Integer>&, const Equations<Integer>&)
    {
       // only the manager on the root node performs a heuristic to get initial facets.
       auto future = std::async(std::launch::async, [](){});
       return future;
    }
+
+   template <typename Integer>
+   std::future<void> initializePool(DistributedJobManager<Integer, tag::facet>& manager, const Matrix<Integer>& matrix, const MapGroup& maps, const Matrix<Integer>& known_output, const Equations<Integer>& equations)
+   {
+      if ( mpi::getSession().isMaster() )
+      {
+         return initializationOnMaster(manager, matrix, maps, known_output, equations, "Inequalities");
+      }
+      return std::async(std::launch::async, [](){});
+   }
+
+   template <typename Integer>
+   std::future<void> initializePool(DistributedJobManager<Integer, tag::vertex>& manager, const Matrix<Integer>& matrix, const MapGroup& maps, const Matrix<Integer>& known_output, const Equations<Integer>&)
+   {
+      if ( mpi::getSession().isMaster() )
+      {
+         return initializationOnMaster(manager, matrix, maps, known_output, {}, "Vertices / Rays");
+      }
+      return std::async(std::launch::async, [](){});
+   }
+
+   template <typename Integer, typename TagType>
+   std::future<void> initializePool(SubMasterJobManager<Integer, TagType>&, const ConvexHull<Integer>&, const MapGroup&, const Inequalities<Integer>&, const Equations<Integer>&)
+   {
+      // the jobs come from the master.
+      return std::async(std::launch::async, [](){});
+   }
 }
 
@@ -16,8 +16,10 @@
 #include "algorithm_matrix_operations.h"
 #include "algorithm_row_operations.h"
 #include "application_name.h"
+#include "concurrency.h"
 #include "input.h"
 #include "integer_type_selection.h"
+#include "vertex_group.h"
 
 using namespace panda;
 
@@ -56,6 +58,29 @@ int panda::method::doubleDescription<OperationMode::VertexEnumeration>(int argc,
 
 namespace
 {
+   /// Returns the group of the input rows given in the input file or induced by the maps,
+   /// std::nullopt if there is none.
+   template <typename Integer, typename TagType>
+   std::optional<VertexGroup> vertexGroup(int argc, char** argv, const Matrix<Integer>& rows, const Maps& maps, const std::optional<VertexGroup>& input_vertex_group, TagType tag)
+   {
+      if ( input_vertex_group )
+      {
+         return input_vertex_group;
+      }
+      return VertexGroup::create(maps, rows, tag, concurrency::numberOfThreads(argc, argv));
+   }
+
+   /// Fourier-Motzkin elimination; with a group, it yields one row per class only.
+   template <typename Integer>
+   Matrix<Integer> eliminate(const Matrix<Integer>& rows, const std::optional<VertexGroup>& group)
+   {
+      if ( group )
+      {
+         return algorithm::fourierMotzkinElimination(rows, *group);
+      }
+      return algorithm::fourierMotzkinElimination(rows);
+   }
+
    template <typename Integer>
    std::pair<std::vector<Vertex<Integer>*>, std::vector<Vertex<Integer>*>> split(Matrix<Integer>& matrix)
    {
@@ -144,10 +169,11 @@ namespace
          std::cout << '\n';
       }
       // computation part 2: identifying inequalities
-      auto inequalities = algorithm::fourierMotzkinElimination(vertices);
+      const auto group = vertexGroup(argc, argv, vertices, maps, std::get<4>(data), tag::facet{});
+      auto inequalities = eliminate(vertices, group);
       inequalities = algorithm::classes(inequalities, reduced_maps, tag::facet{});
       // output
-      const auto is_reduced = !maps.empty();
+      const auto is_reduced = !maps.empty() || group;
       print(std::move(inequalities), std::move(names), is_reduced);
       return 0;
    }
@@ -172,10 +198,11 @@ namespace
       const auto& inequalities = std::get<0>(data);
       const auto& maps = std::get<2>(data);
       // computation: identifying extremal vertices and rays
-      auto matrix = algorithm::fourierMotzkinElimination(inequalities);
+      const auto group = vertexGroup(argc, argv, inequalities, maps, std::get<4>(data), tag::vertex{});
+      auto matrix = eliminate(inequalities, group);
       matrix = algorithm::classes(matrix, maps, tag::vertex{});
       // output
-      const auto is_reduced = !maps.empty();
+      const auto is_reduced = !maps.empty() || group;
       print(std::move(matrix), is_reduced);
       return 0;
    }
@@ -0,0 +1,506 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "method_expansion.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "algorithm_classes.h"
+#include "algorithm_classes_vertex_support.h"
+#include "algorithm_linear_automorphisms.h"
+#include "algorithm_map_operations.h"
+#include "algorithm_matrix_operations.h"
+#include "algorithm_row_operations.h"
+#include "application_name.h"
+#include "concurrency.h"
+#include "incidence.h"
+#include "input.h"
+#include "input_common.h"
+#include "input_constraint.h"
+#include "input_detection.h"
+#include "input_keywords.h"
+#include "integer_type_selection.h"
+#include "joining_thread.h"
+#include "map_group.h"
+#include "signed_permutation_group.h"
+#include "symmetry_detection.h"
+#include "tags.h"
+#include "vertex_group.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Expansion of the facet classes, the input file contains vertices / rays.
+   template <typename Integer>
+   struct FacetExpansion
+   {
+      static int call(int, char**);
+   };
+
+   /// Expansion of the vertex classes, the input file contains inequalities.
+   template <typename Integer>
+   struct VertexExpansion
+   {
+      static int call(int, char**);
+   };
+
+   /// Function that is called for each row of a class.
+   template <typename Integer>
+   using Consumer = std::function<void(const Row<Integer>&)>;
+   /// Function that passes all rows of the class of a representative to a consumer.
+   template <typename Integer>
+   using Expander = std::function<void(const Row<Integer>&, const Consumer<Integer>&)>;
+
+   /// Returns the name of the file with the reduced output ("--expand=<file>").
+   std::string getFilenameReducedOutput(int, char**);
+   /// Returns the inequalities of a reduced output of facet enumeration.
+   template <typename Integer>
+   Inequalities<Integer> reducedInequalities(int, char**, const Names&);
+   /// Returns the vertices / rays of a reduced output of vertex enumeration.
+   template <typename Integer>
+   Vertices<Integer> reducedVertices(int, char**);
+   /// Returns the expander for the symmetries of the input: vertex permutations of the input file,
+   /// the detected symmetry group ("--detect-symmetry") or the maps, in this order.
+   template <typename Integer, typename TagType>
+   Expander<Integer> expander(int, char**, const Matrix<Integer>&, const Maps&, const std::optional<VertexGroup>&, const Equations<Integer>&, TagType);
+   /// Returns the expander for a group of permutations of the input rows. The rows of a class are
+   /// computed from the orbit of the set of input rows on the face of the representative.
+   template <typename Integer>
+   Expander<Integer> supportExpander(const Matrix<Integer>&, const VertexGroup&, const Equations<Integer>&);
+   /// Face of a class representative, given by input rows.
+   struct Face
+   {
+      /// the input rows on the face.
+      std::vector<std::size_t> support{};
+      /// input rows on the face that span the others.
+      std::vector<std::size_t> basis{};
+      /// an input row that isn't on the face.
+      std::size_t outside{};
+      /// number of solutions of the basis rows (the row and the equations).
+      std::size_t solutions{};
+   };
+   /// Returns the face of the input rows in the support. Throws std::invalid_argument if
+   /// they don't define a face.
+   template <typename Integer>
+   Face face(const Matrix<Integer>&, const Support&);
+   /// Returns the row of the image of the face under a permutation of the input rows. The
+   /// images of the basis rows suffice, unless they don't span the image of the face.
+   template <typename Integer>
+   Row<Integer> rowOfImage(const Matrix<Integer>&, const Face&, const std::vector<std::size_t>&, const Equations<Integer>&);
+   /// Returns the row whose face contains exactly the input rows in the support, oriented such that
+   /// the other input rows have positive distance. Normalized according to the equations.
+   template <typename Integer>
+   Row<Integer> rowOfSupport(const Matrix<Integer>&, const Support&, const Equations<Integer>&);
+   /// Expands the representatives in parallel and writes the rows to std::cout. The rows are
+   /// collected in a buffer per thread, which is written whenever it is full, hence the expanded
+   /// rows are never stored. Returns the number of rows.
+   template <typename Integer>
+   std::size_t expand(int, const Matrix<Integer>&, const Expander<Integer>&, const std::function<void(std::ostream&, const Row<Integer>&)>&);
+}
+
+int panda::method::expansion(int argc, char** argv)
+{
+   assert( argc > 0 && argv != nullptr );
+   const auto mode = detectOperationModeOfFile(argc, argv);
+   if ( mode == OperationMode::FacetEnumeration )
+   {
+      std::cerr << project::application_acronym << " -- expansion of facet classes\n";
+      return IntegerTypeSelector<FacetExpansion>::select(argc, argv);
+   }
+   if ( mode == OperationMode::VertexEnumeration )
+   {
+      std::cerr << project::application_acronym << " -- expansion of vertex classes\n";
+      return IntegerTypeSelector<VertexExpansion>::select(argc, argv);
+   }
+   std::cerr << "The input file of the expansion has to contain either vertices / rays or inequalities.\n";
+   return 1;
+}
+
+namespace
+{
+   template <typename Integer>
+   int FacetExpansion<Integer>::call(int argc, char** argv)
+   try
+   {
+      assert( argc > 0 && argv != nullptr );
+      const auto data = input::vertices<Integer>(argc, argv);
+      const auto& vertices = std::get<0>(data);
+      const auto& names = std::get<1>(data);
+      const auto equations = algorithm::extractEquations(vertices);
+      const auto representatives = reducedInequalities<Integer>(argc, argv, names);
+      const auto expand_class = expander(argc, argv, vertices, std::get<2>(data), std::get<4>(data), equations, tag::facet{});
+      if ( !equations.empty() )
+      {
+         std::cout << "Equations:\n";
+         algorithm::prettyPrint(std::cout, equations, names, "=");
+         std::cout << '\n';
+      }
+      std::cout << "Inequalities:\n";
+      const auto count = expand<Integer>(concurrency::numberOfThreads(argc, argv), representatives, expand_class, [&](std::ostream& stream, const Row<Integer>& row)
+      {
+         algorithm::prettyPrintln(stream, row, names, "<=");
+      });
+      std::cerr << "Expanded " << representatives.size() << " classes to " << count << " inequalities\n";
+      return 0;
+   }
+   catch ( const std::exception& e )
+   {
+      std::cerr << "Exception caught: " << e.what() << '\n';
+      return 1;
+   }
+   catch ( ... )
+   {
+      std::cerr << "Unknown exception caught in file " << __FILE__ << '\n';
+      return 1;
+   }
+
+   template <typename Integer>
+   int VertexExpansion<Integer>::call(int argc, char** argv)
+   try
+   {
+      assert( argc > 0 && argv != nullptr );
+      const auto data = input::inequalities<Integer>(argc, argv);
+      const auto& inequalities = std::get<0>(data);
+      const auto representatives = reducedVertices<Integer>(argc, argv);
+      const auto expand_class = expander(argc, argv, inequalities, std::get<2>(data), std::get<4>(data), Equations<Integer>{}, tag::vertex{});
+      std::cout << "Vertices / Rays:\n";
+      const auto count = expand<Integer>(concurrency::numberOfThreads(argc, argv), representatives, expand_class, [](std::ostream& stream, const Row<Integer>& row)
+      {
+         stream << row << '\n';
+      });
+      std::cerr << "Expanded " << representatives.size() << " classes to " << count << " vertices / rays\n";
+      return 0;
+   }
+   catch ( const std::exception& e )
+   {
+      std::cerr << "Exception caught: " << e.what() << '\n';
+      return 1;
+   }
+   catch ( ... )
+   {
+      std::cerr << "Unknown exception caught in file " << __FILE__ << '\n';
+      return 1;
+   }
+
+   std::string getFilenameReducedOutput(int argc, char** argv)
+   {
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strncmp(argv[i], "--expand=", 9) == 0 )
+         {
+            return argv[i] + 9;
+         }
+      }
+      throw std::invalid_argument("Expected argument to option \"--expand=<file>\".");
+   }
+
+   template <typename Integer>
+   Inequalities<Integer> reducedInequalities(int argc, char** argv, const Names& names)
+   {
+      const auto filename = getFilenameReducedOutput(argc, argv);
+      std::ifstream file(filename.c_str());
+      if ( !file )
+      {
+         throw std::invalid_argument("Failed to open file \"" + filename + "\".");
+      }
+      Inequalities<Integer> inequalities;
+      for ( std::string token; file && input::advanceToNextKeyword(file, token); )
+      {
+         if ( input::implementation::isKeywordInequalities(token) || input::implementation::isKeywordReducedInequalities(token) )
+         {
+            const auto rows = input::implementation::constraints<ConstraintType::Inequality, Integer>(file, names);
+            inequalities.insert(inequalities.end(), rows.cbegin(), rows.cend());
+         }
+         else
+         {
+            std::getline(file, token);
+         }
+      }
+      return inequalities;
+   }
+
+   template <typename Integer>
+   Vertices<Integer> reducedVertices(int argc, char** argv)
+   {
+      const auto filename = getFilenameReducedOutput(argc, argv);
+      std::ifstream file(filename.c_str());
+      if ( !file )
+      {
+         throw std::invalid_argument("Failed to open file \"" + filename + "\".");
+      }
+      // the rows are printed homogenized, one per line, below the header "(Reduced) Vertices / Rays:".
+      Vertices<Integer> vertices;
+      for ( std::string line; std::getline(file, line); )
+      {
+         line = input::trimWhitespace(line);
+         if ( line.empty() || line.find_first_not_of("0123456789+- \t") != std::string::npos )
+         {
+            continue;
+         }
+         std::istringstream stream(line);
+         Row<Integer> row;
+         for ( Integer value; input::readInteger(stream, value); )
+         {
+            row.push_back(value);
+            input::skipWhitespace(stream);
+         }
+         vertices.push_back(std::move(row));
+      }
+      return vertices;
+   }
+
+   template <typename Integer, typename TagType>
+   Expander<Integer> expander(int argc, char** argv, const Matrix<Integer>& rows, const Maps& original_maps, const std::optional<VertexGroup>& input_vertex_group, const Equations<Integer>& equations, TagType tag)
+   {
+      if ( input_vertex_group )
+      {
+         return supportExpander(rows, *input_vertex_group, equations);
+      }
+      if ( symmetry::detection(argc, argv) )
+      {
+         const auto permutations = algorithm::linearAutomorphisms(rows);
+         if ( permutations.empty() )
+         {
+            std::cerr << "Detected symmetry group is trivial\n";
+            return [](const Row<Integer>& row, const Consumer<Integer>& consumer) { consumer(row); };
+         }
+         return supportExpander(rows, VertexGroup(permutations, rows.size()), equations);
+      }
+      if ( original_maps.empty() )
+      {
+         throw std::invalid_argument("Expansion needs maps or vertex permutations in the input file, or \"--detect-symmetry\".");
+      }
+      // the group of the maps is built once for all representatives.
+      const auto maps = std::make_shared<const MapGroup>(algorithm::normalize(original_maps, equations));
+      if ( maps->group() )
+      {
+         return [maps](const Row<Integer>& row, const Consumer<Integer>& consumer)
+         {
+            if ( !maps->group()->template orbit<Integer>(row, consumer) )
+            {
+               for ( const auto& element : algorithm::getClass(row, *maps, TagType{}) )
+               {
+                  consumer(element);
+               }
+            }
+         };
+      }
+      // normalized maps are no signed permutations if there are equations, but they may still permute the input rows.
+      const auto permutations = algorithm::computeVertexPermutations(original_maps, rows, tag, concurrency::numberOfThreads(argc, argv));
+      if ( !permutations.empty() )
+      {
+         return supportExpander(rows, VertexGroup(permutations, rows.size()), equations);
+      }
+      return [maps](const Row<Integer>& row, const Consumer<Integer>& consumer)
+      {
+         for ( const auto& element : algorithm::getClass(row, *maps, TagType{}) )
+         {
+            consumer(element);
+         }
+      };
+   }
+
+   template <typename Integer>
+   Expander<Integer> supportExpander(const Matrix<Integer>& rows, const VertexGroup& group, const Equations<Integer>& equations)
+   {
+      // the incidence refers to the rows, which outlive the expander.
+      const auto incidence = std::make_shared<const Incidence<Integer>>(rows);
+      return [&rows, equations, group, incidence](const Row<Integer>& row, const Consumer<Integer>& consumer)
+      {
+         const auto support = incidence->supportBitset(row);
+         // the face is indexed once, its images only need the images of the basis rows.
+         const auto representative = face(rows, support);
+         group.orbit(support, [&](const std::vector<std::size_t>& permutation)
+         {
+            consumer(rowOfImage(rows, representative, permutation, equations));
+         });
+      };
+   }
+
+   template <typename Integer>
+   Face face(const Matrix<Integer>& rows, const Support& support)
+   {
+      assert( support.size() == rows.size() );
+      Face result;
+      result.support = support.indices();
+      if ( result.support.empty() )
+      {
+         throw std::invalid_argument("A class representative doesn't contain any input row.");
+      }
+      if ( result.support.size() == rows.size() )
+      {
+         throw std::invalid_argument("A class representative doesn't define a face of the input.");
+      }
+      Matrix<Integer> matrix;
+      matrix.reserve(result.support.size());
+      for ( const auto index : result.support )
+      {
+         matrix.push_back(rows[index]);
+      }
+      // the pivot rows of the elimination are independent and span the others.
+      algorithm::appendNegativeIdentityMatrix(matrix);
+      const auto pivots = algorithm::gaussianElimination(matrix).second;
+      Matrix<Integer> basis;
+      basis.reserve(pivots.size());
+      for ( const auto pivot : pivots )
+      {
+         result.basis.push_back(result.support[pivot]);
+         basis.push_back(rows[result.support[pivot]]);
+      }
+      while ( support.test(result.outside) )
+      {
+         ++result.outside;
+      }
+      result.solutions = algorithm::extractEquations(basis).size();
+      return result;
+   }
+
+   template <typename Integer>
+   Row<Integer> rowOfImage(const Matrix<Integer>& rows, const Face& face, const std::vector<std::size_t>& permutation, const Equations<Integer>& equations)
+   {
+      assert( permutation.size() == rows.size() );
+      Matrix<Integer> basis;
+      basis.reserve(face.basis.size());
+      for ( const auto index : face.basis )
+      {
+         basis.push_back(rows[permutation[index]]);
+      }
+      const auto candidates = algorithm::extractEquations(basis);
+      // with as many solutions as for the face, the images of the basis rows span the image of the face.
+      if ( candidates.size() == face.solutions )
+      {
+         const auto& outside = rows[permutation[face.outside]];
+         for ( const auto& candidate : candidates )
+         {
+            auto row = algorithm::normalize(candidate, equations);
+            const auto product = row * outside;
+            if ( product != 0 )
+            {
+               if ( product > 0 )
+               {
+                  row *= Integer(-1);
+               }
+               return row;
+            }
+         }
+      }
+      Support support(rows.size());
+      for ( const auto index : face.support )
+      {
+         support.set(permutation[index]);
+      }
+      return rowOfSupport(rows, support, equations);
+   }
+
+   template <typename Integer>
+   Row<Integer> rowOfSupport(const Matrix<Integer>& rows, const Support& support, const Equations<Integer>& equations)
+   {
+      assert( support.size() == rows.size() );
+      Matrix<Integer> face;
+      for ( const auto index : support.indices() )
+      {
+         face.push_back(rows[index]);
+      }
+      if ( face.empty() )
+      {
+         throw std::invalid_argument("A class representative doesn't contain any input row.");
+      }
+      // the solutions of the face rows are the row we are looking for and the equations.
+      for ( const auto& candidate : algorithm::extractEquations(face) )
+      {
+         auto row = algorithm::normalize(candidate, equations);
+         for ( std::size_t i = 0; i < rows.size(); ++i )
+         {
+            if ( support.test(i) )
+            {
+               continue;
+            }
+            const auto product = row * rows[i];
+            if ( product != 0 )
+            {
+               if ( product > 0 )
+               {
+                  row *= Integer(-1);
+               }
+               return row;
+            }
+         }
+      }
+      throw std::invalid_argument("A class representative doesn't define a face of the input.");
+   }
+
+   template <typename Integer>
+   std::size_t expand(const int thread_count, const Matrix<Integer>& representatives, const Expander<Integer>& expand_class, const std::function<void(std::ostream&, const Row<Integer>&)>& print)
+   {
+      constexpr std::streamoff buffer_size = 1 << 16;
+      std::atomic<std::size_t> next_representative{0};
+      std::atomic<std::size_t> count{0};
+      std::mutex output_mutex;
+      std::vector<std::exception_ptr> errors(static_cast<std::size_t>(thread_count));
+      {
+         std::list<JoiningThread> threads;
+         for ( std::size_t t = 0; t < errors.size(); ++t )
+         {
+            threads.emplace_back([&, t]()
+            {
+               try
+               {
+                  std::ostringstream buffer;
+                  const auto flush = [&]()
+                  {
+                     const std::lock_guard<std::mutex> lock(output_mutex);
+                     std::cout << buffer.str();
+                     std::cout.flush();
+                     buffer.str("");
+                  };
+                  std::size_t local_count{0};
+                  for ( auto i = next_representative++; i < representatives.size(); i = next_representative++ )
+                  {
+                     expand_class(representatives[i], [&](const Row<Integer>& row)
+                     {
+                        print(buffer, row);
+                        ++local_count;
+                        if ( buffer.tellp() > buffer_size )
+                        {
+                           flush();
+                        }
+                     });
+                  }
+                  flush();
+                  count += local_count;
+               }
+               catch ( ... )
+               {
+                  errors[t] = std::current_exception();
+               }
+            });
+         }
+      }
+      for ( const auto& error : errors )
+      {
+         if ( error )
+         {
+            std::rethrow_exception(error);
+         }
+      }
+      return count;
+   }
+}
+
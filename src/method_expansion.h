@@ -0,0 +1,17 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+namespace panda
+{
+   namespace method
+   {
+      /// Expansion: the class representatives of a reduced output ("--expand=<file>") are
+      /// expanded to all rows of their classes, using the symmetries of the input file.
+      int expansion(int, char**);
+   }
+}
+
@@ -0,0 +1,34 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstdint>
+
+namespace panda
+{
+   namespace modular
+   {
+      /// The Mersenne prime 2^61 - 1, all residues are taken modulo this prime.
+      constexpr uint64_t prime = (static_cast<uint64_t>(1) << 61) - 1;
+      /// returns n modulo the prime.
+      inline uint64_t reduce(uint64_t) noexcept;
+      /// returns (a + b) modulo the prime, for residues a, b.
+      inline uint64_t add(uint64_t, uint64_t) noexcept;
+      /// returns -a modulo the prime, for a residue a.
+      inline uint64_t negate(uint64_t) noexcept;
+      /// returns (a * b) modulo the prime, for residues a, b.
+      inline uint64_t multiply(uint64_t, uint64_t) noexcept;
+      /// returns (a * 2^k) modulo the prime, for a residue a.
+      inline uint64_t multiplyByPowerOfTwo(uint64_t, unsigned int) noexcept;
+      /// returns the residue of a native integer.
+      template <typename Integer>
+      inline uint64_t residue(Integer) noexcept;
+   }
+}
+
+#include "modular_arithmetic.tpp"
+
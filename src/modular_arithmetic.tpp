@@ -0,0 +1,79 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Since 2^61 = 1 modulo the prime 2^61 - 1, reducing means adding the bits above
+/// position 61 to the lower 61 bits, and multiplying by a power of two is a rotation
+/// of the 61 bit residue. Neither needs a division.
+
+#include <cassert>
+#include <limits>
+#include <type_traits>
+
+namespace panda
+{
+   namespace modular
+   {
+      uint64_t reduce(const uint64_t n) noexcept
+      {
+         const auto folded = (n & prime) + (n >> 61);
+         return (folded >= prime) ? folded - prime : folded;
+      }
+
+      uint64_t add(const uint64_t a, const uint64_t b) noexcept
+      {
+         assert( a < prime && b < prime );
+         const auto sum = a + b;
+         return (sum >= prime) ? sum - prime : sum;
+      }
+
+      uint64_t negate(const uint64_t a) noexcept
+      {
+         assert( a < prime );
+         return (a == 0) ? 0 : prime - a;
+      }
+
+      uint64_t multiply(const uint64_t a, const uint64_t b) noexcept
+      {
+         assert( a < prime && b < prime );
+         #ifdef __SIZEOF_INT128__
+            __extension__ typedef unsigned __int128 Wide;
+            const auto product = static_cast<Wide>(a) * b;
+            return reduce((static_cast<uint64_t>(product) & prime) + static_cast<uint64_t>(product >> 61));
+         #else
+            // schoolbook multiplication with 32 bit halves, the partial products fit into 64 bits.
+            const auto a_high = a >> 32, a_low = a & 0xFFFFFFFFu;
+            const auto b_high = b >> 32, b_low = b & 0xFFFFFFFFu;
+            const auto high = multiplyByPowerOfTwo(reduce(a_high * b_high), 64);
+            const auto middle = multiplyByPowerOfTwo(reduce(a_high * b_low + a_low * b_high), 32);
+            return add(add(high, middle), reduce(a_low * b_low));
+         #endif
+      }
+
+      uint64_t multiplyByPowerOfTwo(const uint64_t a, unsigned int k) noexcept
+      {
+         assert( a < prime );
+         k %= 61;
+         if ( k == 0 )
+         {
+            return a;
+         }
+         return ((a << k) & prime) | (a >> (61 - k));
+      }
+
+      template <typename Integer>
+      uint64_t residue(const Integer n) noexcept
+      {
+         static_assert(std::is_integral<Integer>::value && std::numeric_limits<Integer>::digits <= 64, "residue expects a native integer of at most 64 bits.");
+         using Unsigned = typename std::make_unsigned<Integer>::type;
+         if ( n < 0 )
+         {
+            return negate(reduce(static_cast<Unsigned>(Unsigned(0) - static_cast<Unsigned>(n))));
+         }
+         return reduce(static_cast<Unsigned>(n));
+      }
+   }
+}
+
@@ -12,6 +12,7 @@ namespace panda
    {
       FacetEnumeration,  /// Facet enumeration: input consists of vertices and rays.
       VertexEnumeration, /// Vertex enumeration: input consists of equations and inequalities.
+      Expansion,         /// Expansion of a reduced output to all rows of the classes.
       HelpCommand,       /// Show specific help information for an option.
       Help,              /// Show help information.
       Version,           /// Show version information.
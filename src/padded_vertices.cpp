@@ -0,0 +1,179 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_PADDED_VERTICES
+#include "padded_vertices.h"
+#undef COMPILE_TEMPLATE_PADDED_VERTICES
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <tuple>
+#include <utility>
+
+using namespace panda;
+
+namespace
+{
+   template <typename Integer>
+   using Kernel = void (*)(const Inequality<Integer>&, const std::vector<Integer>&, std::size_t, std::vector<Integer>&);
+   /// Distances for rows of a fixed width. The inequality is padded into an array of that width.
+   template <std::size_t Width, typename Integer>
+   void fixedWidthDistances(const Inequality<Integer>&, const std::vector<Integer>&, std::size_t, std::vector<Integer>&);
+   /// Distances for rows of any width (fallback for large dimensions).
+   template <typename Integer>
+   void variableWidthDistances(const Inequality<Integer>&, const std::vector<Integer>&, std::size_t, std::vector<Integer>&);
+   /// Chooses the smallest fixed width that can hold the dimension and the matching kernel.
+   template <typename Integer>
+   std::pair<std::size_t, Kernel<Integer>> kernelDispatch(std::size_t);
+}
+
+template <typename Integer>
+panda::PaddedVertices<Integer>::PaddedVertices(const Vertices<Integer>& vertices)
+:
+   number_of_vertices(vertices.size()),
+   padded_width(0),
+   data(),
+   kernel(nullptr)
+{
+   if ( vertices.empty() )
+   {
+      return;
+   }
+   std::tie(padded_width, kernel) = kernelDispatch<Integer>(vertices.front().size());
+   data.assign(number_of_vertices * padded_width, Integer(0));
+   auto position = data.begin();
+   for ( const auto& vertex : vertices )
+   {
+      assert( vertex.size() <= padded_width );
+      std::copy(vertex.cbegin(), vertex.cend(), position);
+      position += static_cast<typename std::vector<Integer>::difference_type>(padded_width);
+   }
+}
+
+template <typename Integer>
+bool panda::PaddedVertices<Integer>::empty() const noexcept
+{
+   return number_of_vertices == 0;
+}
+
+template <typename Integer>
+std::size_t panda::PaddedVertices<Integer>::size() const noexcept
+{
+   return number_of_vertices;
+}
+
+template <typename Integer>
+std::size_t panda::PaddedVertices<Integer>::width() const noexcept
+{
+   return padded_width;
+}
+
+template <typename Integer>
+void panda::PaddedVertices<Integer>::distances(const Inequality<Integer>& inequality, std::vector<Integer>& result) const
+{
+   assert( inequality.size() <= padded_width );
+   result.resize(number_of_vertices);
+   if ( !empty() )
+   {
+      kernel(inequality, data, padded_width, result);
+   }
+}
+
+namespace
+{
+   template <std::size_t Width, typename Integer>
+   void fixedWidthDistances(const Inequality<Integer>& inequality, const std::vector<Integer>& data, std::size_t, std::vector<Integer>& result)
+   {
+      std::array<Integer, Width> padded;
+      padded.fill(Integer(0));
+      std::copy(inequality.cbegin(), inequality.cend(), padded.begin());
+      const Integer* row = data.data();
+      for ( auto& distance : result )
+      {
+         Integer sum(0);
+         for ( std::size_t k = 0; k < Width; ++k )
+         {
+            sum += row[k] * padded[k];
+         }
+         distance = -sum;
+         row += Width;
+      }
+   }
+
+   template <typename Integer>
+   void variableWidthDistances(const Inequality<Integer>& inequality, const std::vector<Integer>& data, const std::size_t width, std::vector<Integer>& result)
+   {
+      const Integer* row = data.data();
+      for ( auto& distance : result )
+      {
+         Integer sum(0);
+         for ( std::size_t k = 0; k < width; ++k )
+         {
+            sum += row[k] * inequality[k];
+         }
+         distance = -sum;
+         row += width;
+      }
+   }
+
+   /// Typical dimensions are small (e.g. 37, 49, 81), so the widths are multiples of 8 up to 128.
+   /// Larger dimensions don't profit from a fixed trip count and use the variable width kernel.
+   template <typename Integer>
+   std::pair<std::size_t, Kernel<Integer>> kernelDispatch(const std::size_t dimension)
+   {
+      if ( dimension <= 8u )
+      {
+         return std::make_pair(8u, &fixedWidthDistances<8u, Integer>);
+      }
+      else if ( dimension <= 16u )
+      {
+         return std::make_pair(16u, &fixedWidthDistances<16u, Integer>);
+      }
+      else if ( dimension <= 24u )
+      {
+         return std::make_pair(24u, &fixedWidthDistances<24u, Integer>);
+      }
+      else if ( dimension <= 32u )
+      {
+         return std::make_pair(32u, &fixedWidthDistances<32u, Integer>);
+      }
+      else if ( dimension <= 40u )
+      {
+         return std::make_pair(40u, &fixedWidthDistances<40u, Integer>);
+      }
+      else if ( dimension <= 48u )
+      {
+         return std::make_pair(48u, &fixedWidthDistances<48u, Integer>);
+      }
+      else if ( dimension <= 56u )
+      {
+         return std::make_pair(56u, &fixedWidthDistances<56u, Integer>);
+      }
+      else if ( dimension <= 64u )
+      {
+         return std::make_pair(64u, &fixedWidthDistances<64u, Integer>);
+      }
+      else if ( dimension <= 80u )
+      {
+         return std::make_pair(80u, &fixedWidthDistances<80u, Integer>);
+      }
+      else if ( dimension <= 96u )
+      {
+         return std::make_pair(96u, &fixedWidthDistances<96u, Integer>);
+      }
+      else if ( dimension <= 112u )
+      {
+         return std::make_pair(112u, &fixedWidthDistances<112u, Integer>);
+      }
+      else if ( dimension <= 128u )
+      {
+         return std::make_pair(128u, &fixedWidthDistances<128u, Integer>);
+      }
+      return std::make_pair(dimension, &variableWidthDistances<Integer>);
+   }
+}
+
@@ -0,0 +1,45 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "matrix.h"
+#include "row.h"
+
+namespace panda
+{
+   /// Contiguous copy of a vertex matrix, each row zero-padded to one of a few widths that are
+   /// known at compile time. The distance kernel for this width has a fixed trip count and can
+   /// be unrolled and vectorized by the compiler. The width is selected once from the dimension.
+   template <typename Integer>
+   class PaddedVertices
+   {
+      public:
+         /// Constructor. Empty vertices result in an empty object.
+         explicit PaddedVertices(const Vertices<Integer>&);
+         /// Returns true if no vertices are stored.
+         bool empty() const noexcept;
+         /// Returns the number of vertices.
+         std::size_t size() const noexcept;
+         /// Returns the padded width of the rows.
+         std::size_t width() const noexcept;
+         /// Calculates the distances of all vertices to the inequality.
+         void distances(const Inequality<Integer>&, std::vector<Integer>&) const;
+      private:
+         using Kernel = void (*)(const Inequality<Integer>&, const std::vector<Integer>&, std::size_t, std::vector<Integer>&);
+      private:
+         std::size_t number_of_vertices;
+         std::size_t padded_width;
+         std::vector<Integer> data;
+         Kernel kernel;
+   };
+}
+
+#include "padded_vertices.eti"
+
@@ -0,0 +1,65 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "prefetch_depth.h"
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace panda;
+
+namespace
+{
+   /// Number of batches sent ahead by default.
+   constexpr std::size_t default_depth = 1;
+   std::size_t interpretParameter(char*);
+}
+
+std::size_t panda::prefetch::depth(int argc, char** argv)
+{
+   assert( argc > 0 && argv != nullptr );
+   for ( int i = 1; i < argc; ++i )
+   {
+      if ( std::strncmp(argv[i], "--prefetch=", 11) == 0 )
+      {
+         return interpretParameter(argv[i] + 11);
+      }
+      else if ( std::strncmp(argv[i], "--prefetch", 10) == 0 )
+      {
+         throw std::invalid_argument("Illegal parameter. Did you mean \"--prefetch=<n>\"?");
+      }
+   }
+   return default_depth;
+}
+
+namespace
+{
+   std::size_t interpretParameter(char* string)
+   {
+      assert( string != nullptr );
+      std::istringstream stream(string);
+      int n;
+      if ( !(stream >> n) )
+      {
+         throw std::invalid_argument("Command line option \"--prefetch=<n>\" needs an integral parameter.");
+      }
+      std::string rest;
+      stream >> rest;
+      if ( !rest.empty() )
+      {
+         throw std::invalid_argument("Command line option \"--prefetch=<n>\" needs an integral parameter.");
+      }
+      if ( n < 0 )
+      {
+         throw std::invalid_argument("Command line option \"--prefetch=<n>\" needs a non-negative integral parameter.");
+      }
+      return static_cast<std::size_t>(n);
+   }
+}
+
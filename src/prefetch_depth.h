@@ -0,0 +1,21 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+
+namespace panda
+{
+   namespace prefetch
+   {
+      /// Returns the number of batches of jobs the master sends ahead to each thread of a
+      /// slave ("--prefetch=<n>", default 1), such that the slave doesn't wait for the
+      /// next batch while the results of the previous one are uploaded.
+      std::size_t depth(int, char**);
+   }
+}
+
@@ -0,0 +1,128 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_ROW_INDEX
+#include "row_index.h"
+#undef COMPILE_TEMPLATE_ROW_INDEX
+
+#include <cassert>
+#include <type_traits>
+
+#include "modular_arithmetic.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Base of the polynomial fingerprint (any residue that is not small will do).
+   constexpr uint64_t base = 0x1d8e4e27c47d124fULL % modular::prime;
+   /// Residue of a native integer.
+   template <typename Integer>
+   uint64_t residue(const Integer&, std::true_type) noexcept;
+   /// Residue of any other integer type (provided by the type).
+   template <typename Integer>
+   uint64_t residue(const Integer&, std::false_type) noexcept;
+   /// Fingerprint of a row.
+   template <typename Integer>
+   uint64_t hash(const Row<Integer>&) noexcept;
+}
+
+template <typename Integer>
+panda::RowIndex<Integer>::RowIndex(const Matrix<Integer>& matrix_)
+:
+   matrix(matrix_),
+   hashes(),
+   slots(),
+   duplicates(false)
+{
+   std::size_t capacity = 16;
+   while ( capacity < 2 * matrix.size() )
+   {
+      capacity *= 2;
+   }
+   slots.assign(capacity, npos);
+   hashes.reserve(matrix.size());
+   for ( std::size_t i = 0; i < matrix.size(); ++i )
+   {
+      const auto value = hash(matrix[i]);
+      hashes.push_back(value);
+      auto position = slot(value);
+      for ( ; slots[position] != npos; position = (position + 1) & (slots.size() - 1) )
+      {
+         const auto j = slots[position];
+         if ( hashes[j] == value && matrix[j] == matrix[i] )
+         {
+            duplicates = true;
+            break;
+         }
+      }
+      if ( slots[position] == npos )
+      {
+         slots[position] = i;
+      }
+   }
+}
+
+template <typename Integer>
+std::size_t panda::RowIndex<Integer>::find(const Row<Integer>& row) const
+{
+   const auto value = hash(row);
+   for ( auto position = slot(value); slots[position] != npos; position = (position + 1) & (slots.size() - 1) )
+   {
+      const auto j = slots[position];
+      if ( hashes[j] == value && matrix[j] == row )
+      {
+         return j;
+      }
+   }
+   return npos;
+}
+
+template <typename Integer>
+bool panda::RowIndex<Integer>::hasDuplicates() const noexcept
+{
+   return duplicates;
+}
+
+template <typename Integer>
+std::size_t panda::RowIndex<Integer>::memoryUsage() const noexcept
+{
+   return hashes.capacity() * sizeof(uint64_t) + slots.capacity() * sizeof(std::size_t);
+}
+
+template <typename Integer>
+std::size_t panda::RowIndex<Integer>::slot(const uint64_t value) const noexcept
+{
+   // the fingerprint is uniform modulo the prime, the multiplication spreads it over all bits.
+   return static_cast<std::size_t>((value * 0x9e3779b97f4a7c15ULL) >> 32) & (slots.size() - 1);
+}
+
+namespace
+{
+   template <typename Integer>
+   uint64_t residue(const Integer& value, std::true_type) noexcept
+   {
+      return modular::residue(value);
+   }
+
+   template <typename Integer>
+   uint64_t residue(const Integer& value, std::false_type) noexcept
+   {
+      return value.residue();
+   }
+
+   template <typename Integer>
+   uint64_t hash(const Row<Integer>& row) noexcept
+   {
+      uint64_t value = 0;
+      for ( const auto& entry : row )
+      {
+         value = modular::add(modular::multiply(value, base), residue(entry, std::is_integral<Integer>{}));
+      }
+      return value;
+   }
+}
+
@@ -0,0 +1,48 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "matrix.h"
+#include "row.h"
+
+namespace panda
+{
+   /// Hash index of the rows of a matrix (open addressing with linear probing).
+   /// The hash of a row is a polynomial fingerprint of its entries modulo 2^61 - 1, so it
+   /// works for all integer types. The index refers to the matrix, which has to outlive it.
+   template <typename Integer>
+   class RowIndex
+   {
+      public:
+         /// Returned by find if the row is not in the matrix.
+         static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+      public:
+         /// Constructor.
+         explicit RowIndex(const Matrix<Integer>&);
+         /// Returns the position of the first row in the matrix equal to the argument or npos.
+         std::size_t find(const Row<Integer>&) const;
+         /// Returns true if the matrix contains a row twice.
+         bool hasDuplicates() const noexcept;
+         /// Returns the number of bytes allocated by the index (not counting the matrix).
+         std::size_t memoryUsage() const noexcept;
+      private:
+         std::size_t slot(uint64_t) const noexcept;
+      private:
+         const Matrix<Integer>& matrix;
+         std::vector<uint64_t> hashes;
+         std::vector<std::size_t> slots;
+         bool duplicates;
+   };
+}
+
+#include "row_index.eti"
+
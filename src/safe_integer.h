@@ -104,11 +104,15 @@ namespace panda
          inline SafeInteger operator%(const SafeInteger&) const;
          /// Negation (-a).
          inline SafeInteger operator-() const;
+         /// Residue modulo the prime of modular_arithmetic.h.
+         inline uint64_t residue() const noexcept;
          /// Absolute value.
          friend SafeInteger abs(SafeInteger);
       public:
          /// Underlying data type.
          using DataType = int64_t;
+         /// Returns the underlying value (e.g. for transmissions).
+         inline DataType value() const noexcept;
       private:
          DataType data;
    };
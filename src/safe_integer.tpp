@@ -8,6 +8,8 @@
 #include <stdexcept>
 #include <string>
 
+#include "modular_arithmetic.h"
+
 namespace panda
 {
    namespace
@@ -35,6 +37,16 @@ panda::SafeInteger panda::SafeInteger::operator-() const
    return result;
 }
 
+uint64_t panda::SafeInteger::residue() const noexcept
+{
+   return modular::residue(data);
+}
+
+panda::SafeInteger::DataType panda::SafeInteger::value() const noexcept
+{
+   return data;
+}
+
 panda::SafeInteger panda::abs(SafeInteger n)
 {
    return (n < 0) ? -n : n;
@@ -0,0 +1,213 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "shared_memory_transport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+using namespace panda;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The indices of the rings have to be lock free to be shared between processes.");
+
+namespace
+{
+   /// bytes of payload of a ring.
+   constexpr std::size_t ring_capacity = std::size_t{1} << 18;
+   /// alignment of the indices, such that reader and writer don't share a cache line.
+   constexpr std::size_t cache_line = 64;
+}
+
+struct panda::local::SharedMemoryTransport::Ring
+{
+   /// bytes read so far, only written by the reader.
+   alignas(cache_line) std::atomic<unsigned long long> read{0};
+   /// bytes written so far, only written by the writer.
+   alignas(cache_line) std::atomic<unsigned long long> written{0};
+   alignas(cache_line) char data[ring_capacity];
+};
+
+namespace
+{
+   using Ring = local::SharedMemoryTransport::Ring;
+
+   /// Writes as many of the bytes as fit into the ring, returns the number written.
+   std::size_t push(Ring&, const char*, std::size_t);
+   /// Reads up to the given number of bytes from the ring, returns the number read.
+   std::size_t pull(Ring&, char*, std::size_t);
+}
+
+std::size_t panda::local::SharedMemoryTransport::bytes(const int size)
+{
+   assert( size > 0 );
+   const auto count = static_cast<std::size_t>(size);
+   return count * count * sizeof(Ring);
+}
+
+void panda::local::SharedMemoryTransport::initialize(void* memory, const int size)
+{
+   assert( memory != nullptr && size > 0 );
+   const auto count = static_cast<std::size_t>(size) * static_cast<std::size_t>(size);
+   for ( std::size_t i = 0; i < count; ++i )
+   {
+      new (static_cast<Ring*>(memory) + i) Ring();
+   }
+}
+
+bool panda::local::SharedMemoryTransport::post(const Buffer& buffer, const int destination, const int tag, const std::size_t ticket)
+{
+   assert( destination >= 0 && destination < size && destination != rank );
+   Header header{};
+   const auto tag32 = static_cast<std::int32_t>(tag);
+   const auto length = static_cast<std::uint64_t>(buffer.size());
+   std::memcpy(header.data(), &tag32, sizeof(tag32));
+   std::memcpy(header.data() + 8, &length, sizeof(length));
+   outgoing[static_cast<std::size_t>(destination)].push_back(Outgoing{ticket, &buffer, header, 0});
+   return true;
+}
+
+bool panda::local::SharedMemoryTransport::poll(std::vector<std::size_t>& completed, std::vector<std::size_t>&, std::vector<Message>& received, BufferPool& pool)
+{
+   bool progress = false;
+   for ( int destination = 0; destination < size; ++destination )
+   {
+      auto& queue = outgoing[static_cast<std::size_t>(destination)];
+      auto& channel = ring(rank, destination);
+      while ( !queue.empty() )
+      {
+         auto& message = queue.front();
+         if ( message.offset < header_size )
+         {
+            const auto count = push(channel, message.header.data() + message.offset, header_size - message.offset);
+            message.offset += count;
+            progress = progress || count > 0;
+            if ( message.offset < header_size )
+            {
+               break;
+            }
+         }
+         const auto payload = message.offset - header_size;
+         const auto count = push(channel, message.buffer->data() + payload, message.buffer->size() - payload);
+         message.offset += count;
+         progress = progress || count > 0;
+         if ( message.offset - header_size < message.buffer->size() )
+         {
+            break;
+         }
+         // the buffer is released by the caller, the reader has its own copy.
+         completed.push_back(message.ticket);
+         queue.pop_front();
+         progress = true;
+      }
+   }
+   for ( int source = 0; source < size; ++source )
+   {
+      if ( source == rank )
+      {
+         continue;
+      }
+      auto& message = incoming[static_cast<std::size_t>(source)];
+      auto& channel = ring(source, rank);
+      while ( true )
+      {
+         if ( message.offset < header_size )
+         {
+            const auto count = pull(channel, message.header.data() + message.offset, header_size - message.offset);
+            message.offset += count;
+            progress = progress || count > 0;
+            if ( message.offset < header_size )
+            {
+               break;
+            }
+            std::int32_t tag32;
+            std::uint64_t length;
+            std::memcpy(&tag32, message.header.data(), sizeof(tag32));
+            std::memcpy(&length, message.header.data() + 8, sizeof(length));
+            message.tag = static_cast<int>(tag32);
+            message.length = static_cast<std::size_t>(length);
+            message.buffer = pool.acquire();
+            message.buffer.resize(message.length);
+         }
+         const auto payload = message.offset - header_size;
+         const auto count = pull(channel, message.buffer.data() + payload, message.length - payload);
+         message.offset += count;
+         progress = progress || count > 0;
+         if ( message.offset - header_size < message.length )
+         {
+            break;
+         }
+         received.push_back(Message{source, message.tag, std::move(message.buffer)});
+         message.buffer = Buffer();
+         message.offset = 0;
+         progress = true;
+      }
+   }
+   return progress;
+}
+
+panda::local::SharedMemoryTransport::SharedMemoryTransport(const ProcessGroup& group)
+:
+   rank(group.rank),
+   size(group.size),
+   memory(group.memory),
+   outgoing(static_cast<std::size_t>(group.size)),
+   incoming(static_cast<std::size_t>(group.size), Incoming{Header{}, 0, 0, 0, Buffer()})
+{
+   assert( rank >= 0 && rank < size && memory != nullptr );
+}
+
+panda::local::SharedMemoryTransport::~SharedMemoryTransport() = default;
+
+Ring& panda::local::SharedMemoryTransport::ring(const int source, const int destination) const
+{
+   const auto index = static_cast<std::size_t>(source) * static_cast<std::size_t>(size) + static_cast<std::size_t>(destination);
+   return static_cast<Ring*>(memory)[index];
+}
+
+namespace
+{
+   std::size_t push(Ring& ring, const char* bytes, const std::size_t count)
+   {
+      // the writer is the only one to modify "written", the acquire pairs with the release of the reader.
+      const auto written = ring.written.load(std::memory_order_relaxed);
+      const auto free = ring_capacity - static_cast<std::size_t>(written - ring.read.load(std::memory_order_acquire));
+      const auto total = std::min(free, count);
+      if ( total == 0 )
+      {
+         return 0;
+      }
+      const auto position = static_cast<std::size_t>(written % ring_capacity);
+      const auto first = std::min(total, ring_capacity - position);
+      std::memcpy(ring.data + position, bytes, first);
+      std::memcpy(ring.data, bytes + first, total - first);
+      ring.written.store(written + total, std::memory_order_release);
+      return total;
+   }
+
+   std::size_t pull(Ring& ring, char* bytes, const std::size_t count)
+   {
+      // the reader is the only one to modify "read", the acquire pairs with the release of the writer.
+      const auto done = ring.read.load(std::memory_order_relaxed);
+      const auto available = static_cast<std::size_t>(ring.written.load(std::memory_order_acquire) - done);
+      const auto total = std::min(available, count);
+      if ( total == 0 )
+      {
+         return 0;
+      }
+      const auto position = static_cast<std::size_t>(done % ring_capacity);
+      const auto first = std::min(total, ring_capacity - position);
+      std::memcpy(bytes, ring.data + position, first);
+      std::memcpy(bytes + first, ring.data, total - first);
+      ring.read.store(done + total, std::memory_order_release);
+      return total;
+   }
+}
+
@@ -0,0 +1,80 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "local_processes.h"
+#include "message_passing_interface_transport.h"
+
+namespace panda
+{
+   namespace local
+   {
+      /// Transport between the local processes: every ordered pair of processes has a ring
+      /// buffer in the shared memory with a single writer and a single reader. A message is
+      /// streamed through the ring (header, then payload), hence it may exceed the capacity.
+      class SharedMemoryTransport : public mpi::Transport
+      {
+         public:
+            /// Returns the number of bytes of shared memory needed for the given number of processes.
+            static std::size_t bytes(int);
+            /// Prepares the shared memory for the given number of processes (before any process uses it).
+            static void initialize(void*, int);
+            bool post(const Buffer&, int, int, std::size_t) override;
+            /// Writing to the shared memory doesn't fail, hence no ticket is reported as failed.
+            bool poll(std::vector<std::size_t>&, std::vector<std::size_t>&, std::vector<Message>&, BufferPool&) override;
+            /// Constructor.
+            explicit SharedMemoryTransport(const ProcessGroup&);
+            /// Destructor.
+            ~SharedMemoryTransport() override;
+            /// Copy construction is not allowed.
+            SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+            /// Copy assignment is not allowed.
+            SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+         public:
+            /// bytes in front of every message: tag, padding and length of the payload.
+            static constexpr std::size_t header_size = 16;
+            using Header = std::array<char, header_size>;
+            /// ring buffer of one ordered pair of processes (defined in the translation unit).
+            struct Ring;
+         private:
+            /// a message being written.
+            struct Outgoing
+            {
+               std::size_t ticket;
+               const Buffer* buffer;
+               Header header;
+               /// bytes written (header included).
+               std::size_t offset;
+            };
+            /// a message being read.
+            struct Incoming
+            {
+               Header header;
+               /// bytes read (header included).
+               std::size_t offset;
+               int tag;
+               std::size_t length;
+               Buffer buffer;
+            };
+            Ring& ring(int, int) const;
+            const int rank;
+            const int size;
+            void* const memory;
+            /// messages to each process, in the order they are posted.
+            std::vector<std::deque<Outgoing>> outgoing;
+            /// message being read from each process.
+            std::vector<Incoming> incoming;
+      };
+   }
+}
+
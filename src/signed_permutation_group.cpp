@@ -0,0 +1,428 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_SIGNED_PERMUTATION_GROUP
+#include "signed_permutation_group.h"
+#undef COMPILE_TEMPLATE_SIGNED_PERMUTATION_GROUP
+
+#include <cassert>
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+
+using namespace panda;
+
+namespace
+{
+   using Point = std::uint32_t;
+   using Permutation = std::vector<Point>;
+   const auto no_position = std::numeric_limits<std::size_t>::max();
+
+   /// Returns the permutation "first after second".
+   Permutation compose(const Permutation&, const Permutation&);
+   /// Returns the inverse permutation.
+   Permutation inverse(const Permutation&);
+   /// Returns true if the permutation is the identity.
+   bool isIdentity(const Permutation&) noexcept;
+   /// Returns the identity on the given number of points.
+   Permutation identity(std::size_t);
+   /// Translates a map into a permutation of the signed points. Returns an empty permutation
+   /// if the map is not a signed permutation. Coordinates with empty images are fixed.
+   Permutation toPermutation(const Map&);
+   /// Returns the entry of the row at a signed point (negated for -e_i).
+   template <typename Integer>
+   Integer entry(const Row<Integer>&, Point);
+   /// Returns the image of the row under the inverse of the permutation.
+   template <typename Integer>
+   Row<Integer> image(const Row<Integer>&, const Permutation&);
+   /// Returns true if the row has a non-zero entry at one of the fixed coordinates.
+   template <typename Integer>
+   bool touchesFixedCoordinates(const Row<Integer>&, const std::vector<bool>&);
+}
+
+std::optional<SignedPermutationGroup> panda::SignedPermutationGroup::create(const Maps& maps)
+{
+   if ( maps.empty() || maps.front().empty() )
+   {
+      return std::nullopt;
+   }
+   const auto dimension = maps.front().size();
+   if ( dimension > std::numeric_limits<Point>::max() / 2 )
+   {
+      return std::nullopt;
+   }
+   std::vector<bool> fixed_coordinates(dimension);
+   for ( std::size_t i = 0; i < dimension; ++i )
+   {
+      fixed_coordinates[i] = maps.front()[i].empty();
+   }
+   std::vector<Permutation> generators;
+   for ( const auto& map : maps )
+   {
+      if ( map.size() != dimension )
+      {
+         return std::nullopt;
+      }
+      for ( std::size_t i = 0; i < dimension; ++i )
+      {
+         if ( map[i].empty() != fixed_coordinates[i] )
+         {
+            return std::nullopt;
+         }
+      }
+      auto generator = toPermutation(map);
+      if ( generator.empty() )
+      {
+         return std::nullopt;
+      }
+      if ( !isIdentity(generator) )
+      {
+         generators.push_back(std::move(generator));
+      }
+   }
+   return SignedPermutationGroup(dimension, generators, fixed_coordinates);
+}
+
+Maps panda::SignedPermutationGroup::minimalGeneratingSet(const Maps& maps)
+{
+   const auto group = create(maps);
+   if ( !group )
+   {
+      return maps;
+   }
+   const auto& fixed_coordinates = group->fixed_coordinates;
+   const auto dimension = fixed_coordinates.size();
+   // the chain of the kept maps is rebuilt whenever a map extends the group generated so far.
+   auto generated = SignedPermutationGroup(dimension, {}, fixed_coordinates);
+   std::vector<Permutation> generators;
+   Maps result;
+   for ( const auto& map : maps )
+   {
+      auto generator = toPermutation(map);
+      if ( generated.contains(generator) )
+      {
+         continue;
+      }
+      generators.push_back(std::move(generator));
+      result.push_back(map);
+      generated = SignedPermutationGroup(dimension, generators, fixed_coordinates);
+   }
+   if ( result.empty() )
+   {
+      result.push_back(maps.front()); // keeps the fixed coordinates
+   }
+   return result;
+}
+
+std::size_t panda::SignedPermutationGroup::dimension() const noexcept
+{
+   return fixed_coordinates.size();
+}
+
+template <typename Integer>
+std::optional<Row<Integer>> panda::SignedPermutationGroup::canonicalImage(const Row<Integer>& row) const
+{
+   assert( row.size() == dimension() );
+   if ( touchesFixedCoordinates(row, fixed_coordinates) )
+   {
+      return std::nullopt;
+   }
+   // all candidates share the largest prefix reachable so far; ties are followed in parallel.
+   std::set<Row<Integer>> candidates{row};
+   for ( std::size_t j = 0; j < levels.size(); ++j )
+   {
+      const auto& level = levels[j];
+      if ( level.orbit.size() == 1 && candidates.size() == 1 )
+      {
+         continue; // nothing to choose
+      }
+      Integer best = entry(*candidates.cbegin(), level.orbit.front());
+      for ( const auto& candidate : candidates )
+      {
+         for ( const auto point : level.orbit )
+         {
+            const auto current = entry(candidate, point);
+            if ( current > best )
+            {
+               best = current;
+            }
+         }
+      }
+      std::set<Row<Integer>> next_candidates;
+      for ( const auto& candidate : candidates )
+      {
+         for ( std::size_t k = 0; k < level.orbit.size(); ++k )
+         {
+            if ( entry(candidate, level.orbit[k]) == best )
+            {
+               next_candidates.insert(image(candidate, level.transversal[k]));
+            }
+         }
+      }
+      candidates = std::move(next_candidates);
+   }
+   assert( candidates.size() == 1 );
+   return *candidates.cbegin();
+}
+
+template <typename Integer>
+bool panda::SignedPermutationGroup::orbit(const Row<Integer>& row, const std::function<void(const Row<Integer>&)>& function) const
+{
+   assert( row.size() == dimension() );
+   if ( touchesFixedCoordinates(row, fixed_coordinates) )
+   {
+      return false;
+   }
+   // depth-first search over the stabilizer chain: a node at depth j holds the distinct images
+   // of the row under the transversal products of the levels above j that agree on the first
+   // j entries. Nodes with different prefixes have disjoint subtrees, hence each row of the
+   // orbit is reached by exactly one leaf. The images of the pending nodes are stored, though;
+   // an expansion that must not store them uses VertexGroup::orbit.
+   std::vector<std::pair<std::size_t, std::set<Row<Integer>>>> pending;
+   pending.emplace_back(0, std::set<Row<Integer>>{row});
+   while ( !pending.empty() )
+   {
+      auto depth = pending.back().first;
+      auto candidates = std::move(pending.back().second);
+      pending.pop_back();
+      while ( depth < levels.size() && levels[depth].orbit.size() == 1 && candidates.size() == 1 )
+      {
+         ++depth; // nothing to choose
+      }
+      if ( depth == levels.size() )
+      {
+         assert( candidates.size() == 1 );
+         function(*candidates.cbegin());
+         continue;
+      }
+      const auto& level = levels[depth];
+      std::map<Integer, std::set<Row<Integer>>> children;
+      for ( const auto& candidate : candidates )
+      {
+         for ( std::size_t k = 0; k < level.orbit.size(); ++k )
+         {
+            children[entry(candidate, level.orbit[k])].insert(image(candidate, level.transversal[k]));
+         }
+      }
+      for ( auto& child : children )
+      {
+         pending.emplace_back(depth + 1, std::move(child.second));
+      }
+   }
+   return true;
+}
+
+panda::SignedPermutationGroup::SignedPermutationGroup(const std::size_t dimension, const std::vector<Permutation>& generators, std::vector<bool> fixed)
+:
+   fixed_coordinates(std::move(fixed)),
+   levels(dimension)
+{
+   levels.front().generators = generators;
+   for ( std::size_t i = 0; i < dimension; ++i )
+   {
+      computeOrbit(i);
+   }
+   schreierSims();
+}
+
+void panda::SignedPermutationGroup::computeOrbit(const std::size_t index)
+{
+   auto& level = levels[index];
+   const auto number_of_points = 2 * levels.size();
+   const auto base_point = static_cast<Point>(2 * index);
+   level.orbit.assign(1, base_point);
+   level.transversal.assign(1, identity(number_of_points));
+   level.position.assign(number_of_points, no_position);
+   level.position[base_point] = 0;
+   for ( std::size_t k = 0; k < level.orbit.size(); ++k )
+   {
+      for ( const auto& generator : level.generators )
+      {
+         const auto point = generator[level.orbit[k]];
+         if ( level.position[point] == no_position )
+         {
+            level.position[point] = level.orbit.size();
+            level.orbit.push_back(point);
+            level.transversal.push_back(compose(generator, level.transversal[k]));
+         }
+      }
+   }
+}
+
+std::pair<Permutation, std::size_t> panda::SignedPermutationGroup::strip(Permutation element, const std::size_t index) const
+{
+   for ( std::size_t i = index; i < levels.size(); ++i )
+   {
+      const auto& level = levels[i];
+      const auto k = level.position[element[2 * i]];
+      if ( k == no_position )
+      {
+         return std::make_pair(std::move(element), i);
+      }
+      element = compose(inverse(level.transversal[k]), element);
+   }
+   return std::make_pair(std::move(element), levels.size());
+}
+
+bool panda::SignedPermutationGroup::contains(const Permutation& element) const
+{
+   return isIdentity(strip(element, 0).first);
+}
+
+void panda::SignedPermutationGroup::schreierSims()
+{
+   // deterministic Schreier-Sims: every Schreier generator of a level has to strip
+   // through the levels below it, otherwise its residue extends the chain.
+   std::size_t index = levels.size();
+   while ( index > 0 )
+   {
+      const auto i = index - 1;
+      bool extended = false;
+      for ( std::size_t k = 0; k < levels[i].orbit.size() && !extended; ++k )
+      {
+         for ( std::size_t g = 0; g < levels[i].generators.size() && !extended; ++g )
+         {
+            const auto& level = levels[i];
+            const auto& generator = level.generators[g];
+            const auto& target = level.transversal[level.position[generator[level.orbit[k]]]];
+            auto schreier_generator = compose(inverse(target), compose(generator, level.transversal[k]));
+            Permutation residue;
+            std::size_t failed_level;
+            std::tie(residue, failed_level) = strip(std::move(schreier_generator), i + 1);
+            if ( isIdentity(residue) )
+            {
+               continue;
+            }
+            // a non-trivial residue fixes e_0, ..., e_{failed_level - 1}.
+            assert( failed_level < levels.size() );
+            for ( std::size_t l = i + 1; l <= failed_level; ++l )
+            {
+               levels[l].generators.push_back(residue);
+               computeOrbit(l);
+            }
+            index = failed_level + 1;
+            extended = true;
+         }
+      }
+      if ( !extended )
+      {
+         --index;
+      }
+   }
+}
+
+namespace
+{
+   Permutation compose(const Permutation& first, const Permutation& second)
+   {
+      assert( first.size() == second.size() );
+      Permutation result(second.size());
+      for ( std::size_t i = 0; i < second.size(); ++i )
+      {
+         result[i] = first[second[i]];
+      }
+      return result;
+   }
+
+   Permutation inverse(const Permutation& permutation)
+   {
+      Permutation result(permutation.size());
+      for ( std::size_t i = 0; i < permutation.size(); ++i )
+      {
+         result[permutation[i]] = static_cast<Point>(i);
+      }
+      return result;
+   }
+
+   bool isIdentity(const Permutation& permutation) noexcept
+   {
+      for ( std::size_t i = 0; i < permutation.size(); ++i )
+      {
+         if ( permutation[i] != i )
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   Permutation identity(const std::size_t number_of_points)
+   {
+      Permutation result(number_of_points);
+      for ( std::size_t i = 0; i < number_of_points; ++i )
+      {
+         result[i] = static_cast<Point>(i);
+      }
+      return result;
+   }
+
+   Permutation toPermutation(const Map& map)
+   {
+      const auto number_of_points = 2 * map.size();
+      Permutation permutation(number_of_points);
+      std::vector<bool> hit(number_of_points, false);
+      for ( std::size_t i = 0; i < map.size(); ++i )
+      {
+         const auto& image = map[i];
+         if ( image.empty() )
+         {
+            permutation[2 * i] = static_cast<Point>(2 * i);
+            permutation[2 * i + 1] = static_cast<Point>(2 * i + 1);
+         }
+         else if ( image.size() == 1 && image.front().first < map.size() && (image.front().second == 1 || image.front().second == -1) )
+         {
+            const auto target = static_cast<Point>(2 * image.front().first);
+            const bool negative = image.front().second < 0;
+            permutation[2 * i] = negative ? target + 1 : target;
+            permutation[2 * i + 1] = negative ? target : target + 1;
+         }
+         else
+         {
+            return {};
+         }
+         if ( hit[permutation[2 * i]] )
+         {
+            return {};
+         }
+         hit[permutation[2 * i]] = true;
+         hit[permutation[2 * i + 1]] = true;
+      }
+      return permutation;
+   }
+
+   template <typename Integer>
+   Integer entry(const Row<Integer>& row, const Point point)
+   {
+      const auto& value = row[point / 2];
+      return ( point % 2 == 0 ) ? value : static_cast<Integer>(-value);
+   }
+
+   template <typename Integer>
+   Row<Integer> image(const Row<Integer>& row, const Permutation& permutation)
+   {
+      Row<Integer> result(row.size());
+      for ( std::size_t m = 0; m < result.size(); ++m )
+      {
+         result[m] = entry(row, permutation[2 * m]);
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   bool touchesFixedCoordinates(const Row<Integer>& row, const std::vector<bool>& fixed_coordinates)
+   {
+      for ( std::size_t i = 0; i < row.size(); ++i )
+      {
+         if ( fixed_coordinates[i] && row[i] != 0 )
+         {
+            return true;
+         }
+      }
+      return false;
+   }
+}
+
@@ -0,0 +1,73 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "maps.h"
+#include "row.h"
+
+namespace panda
+{
+   /// Group of signed coordinate permutations, generated by maps whose images are single terms
+   /// with factor +1 or -1. The group is stored as a stabilizer chain (Schreier-Sims) with
+   /// the base e_0, e_1, ..., so the lexicographically largest image of a row can be found
+   /// level by level without enumerating its orbit.
+   class SignedPermutationGroup
+   {
+      public:
+         /// Returns the group generated by the maps or std::nullopt if the maps are empty or
+         /// at least one of them is not a signed permutation. Empty images are allowed if all
+         /// maps agree on them (coordinates eliminated by equations); they are fixed by the group.
+         static std::optional<SignedPermutationGroup> create(const Maps&);
+         /// Returns the maps without those that are generated by the maps before them (including
+         /// identities), which is an irredundant generating set of the same group. Maps that are
+         /// no signed permutations are returned unchanged.
+         static Maps minimalGeneratingSet(const Maps&);
+         /// Returns the lexicographically largest row in the orbit of the row or std::nullopt
+         /// if the row has a non-zero entry at a coordinate with an empty image.
+         template <typename Integer>
+         std::optional<Row<Integer>> canonicalImage(const Row<Integer>&) const;
+         /// Calls the function once for each row in the orbit of the row. The distinct images
+         /// that agree on a prefix are kept while the prefix is explored, which may be a large part
+         /// of the orbit. Returns false (and does not call the function) if the row has a non-zero
+         /// entry at a coordinate with an empty image.
+         template <typename Integer>
+         bool orbit(const Row<Integer>&, const std::function<void(const Row<Integer>&)>&) const;
+         /// Returns the number of coordinates the group acts on.
+         std::size_t dimension() const noexcept;
+      private:
+         /// Permutation of the signed points: 2i stands for +e_i, 2i + 1 stands for -e_i.
+         using Permutation = std::vector<std::uint32_t>;
+         /// One level of the stabilizer chain: the stabilizer of e_0, ..., e_{level - 1},
+         /// the orbit of e_level under it and a transversal element for each orbit point.
+         struct Level
+         {
+            std::vector<Permutation> generators{};
+            std::vector<std::uint32_t> orbit{};
+            std::vector<Permutation> transversal{};
+            std::vector<std::size_t> position{};
+         };
+      private:
+         SignedPermutationGroup(std::size_t, const std::vector<Permutation>&, std::vector<bool>);
+         void computeOrbit(std::size_t);
+         std::pair<Permutation, std::size_t> strip(Permutation, std::size_t) const;
+         bool contains(const Permutation&) const;
+         void schreierSims();
+      private:
+         std::vector<bool> fixed_coordinates;
+         std::vector<Level> levels;
+   };
+}
+
+#include "signed_permutation_group.eti"
+
@@ -0,0 +1,385 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_SUB_MASTER_JOB_MANAGER
+#include "sub_master_job_manager.h"
+#undef COMPILE_TEMPLATE_SUB_MASTER_JOB_MANAGER
+
+#include <cassert>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#include "batch_size.h"
+#include "master_hierarchy.h"
+#include "message_passing_interface_session.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Maximal number of raw supports whose canonical forms are kept.
+   constexpr std::size_t canonical_forms_capacity = std::size_t{1} << 16;
+   /// Maximal number of canonical supports of classes known to the master that are kept.
+   constexpr std::size_t known_classes_capacity = std::size_t{1} << 18;
+   /// Duration of a round trip to a slave that the batch size aims for.
+   constexpr BatchSize::Duration target_round_trip(0.05);
+   /// Maximal number of jobs sent to a slave at once.
+   constexpr std::size_t maximum_batch_size = 256;
+}
+
+template <typename Integer, typename TagType>
+void panda::SubMasterJobManager<Integer, TagType>::put(const Matrix<Integer>& matrix) const
+{
+   std::vector<Support> found;
+   if ( vertex_group )
+   {
+      found.reserve(matrix.size());
+      for ( const auto& row : matrix )
+      {
+         found.push_back(incidence.supportBitset(row));
+      }
+      canonical_forms.canonicalize(*vertex_group, found);
+   }
+   std::size_t lease;
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      lease = current[std::this_thread::get_id()];
+   }
+   gather(std::vector<std::size_t>{lease}, matrix, std::move(found));
+}
+
+template <typename Integer, typename TagType>
+Row<Integer> panda::SubMasterJobManager<Integer, TagType>::get() const
+{
+   const auto start = Clock::now();
+   auto jobs = take(1, true);
+   idle_time.record(Clock::now() - start);
+   if ( jobs.empty() ) // all jobs are done.
+   {
+      return Row<Integer>{};
+   }
+   std::lock_guard<std::mutex> lock(mutex);
+   current[std::this_thread::get_id()] = jobs.front().lease;
+   return std::move(jobs.front().row);
+}
+
+template <typename Integer, typename TagType>
+panda::SubMasterJobManager<Integer, TagType>::SubMasterJobManager(const Names&, const int number_of_processors, const int threads_per_processor_, const std::optional<VertexGroup>& vertex_group_, const Matrix<Integer>& vertices_, const std::optional<std::chrono::seconds>& lease_duration, const std::size_t prefetch_depth_, const int sub_masters)
+:
+   communication(),
+   master(hierarchy::master(mpi::getSession().getRank(), number_of_processors, sub_masters)),
+   threads_per_processor(threads_per_processor_),
+   prefetch_depth(prefetch_depth_),
+   vertex_group(vertex_group_),
+   vertices(vertices_),
+   incidence(vertices),
+   canonical_forms(vertex_group_ ? canonical_forms_capacity : 1),
+   known_classes(vertex_group_ ? known_classes_capacity : 1),
+   idle_time(),
+   mutex(),
+   condition(),
+   queue(),
+   remaining(),
+   results(),
+   supports(),
+   current(),
+   next_batch(1),
+   batches(),
+   lease_clock(lease_duration ? std::optional<LeaseClock::Clock::duration>(*lease_duration) : std::nullopt),
+   failed_slaves(),
+   finished(false),
+   threads() // vital implementation detail: threads may access other members, hence, the threads must be destroyed first (Destruction in reverse order of construction).
+{
+   assert( number_of_processors > 0 );
+   assert( threads_per_processor > 0 );
+   threads.emplace_front([this]() { receive(); });
+   for ( const auto id : hierarchy::slaves(mpi::getSession().getRank(), number_of_processors, sub_masters) )
+   {
+      for ( int i = 0; i < threads_per_processor; ++i )
+      {
+         threads.emplace_front([this,id]() { serve(id); });
+      }
+   }
+}
+
+template <typename Integer, typename TagType>
+panda::SubMasterJobManager<Integer, TagType>::~SubMasterJobManager()
+{
+   // the statistics are complete once the slaves are done.
+   threads.clear();
+   std::stringstream stream;
+   stream << "Node " << mpi::getSession().getRank() << ": waiting for jobs " << std::fixed << std::setprecision(1) << 100.0 * idle_time.fraction() << "% of the time\n";
+   if ( vertex_group )
+   {
+      stream << "Node " << mpi::getSession().getRank() << ": results dropped before sending (class known to the master): " << known_classes.hits() << " of " << known_classes.lookups() << '\n';
+   }
+   std::cerr << stream.str();
+}
+
+template <typename Integer, typename TagType>
+void panda::SubMasterJobManager<Integer, TagType>::receive() const
+{
+   // every thread of the master serving this node says goodbye with an empty batch.
+   int goodbyes = 0;
+   while ( goodbyes < threads_per_processor )
+   {
+      Matrix<Integer> jobs;
+      std::size_t lease;
+      std::tie(jobs, lease) = communication.fromMaster<Integer>(master);
+      if ( jobs.empty() )
+      {
+         ++goodbyes;
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = true;
+            // the master is done or has given up on this node, the jobs left are of no use.
+            queue.clear();
+         }
+         condition.notify_all();
+         continue;
+      }
+      // the classes of the jobs are known to the master, their results are dropped here.
+      if ( vertex_group )
+      {
+         std::vector<Support> keys;
+         keys.reserve(jobs.size());
+         for ( const auto& job : jobs )
+         {
+            keys.push_back(incidence.supportBitset(job));
+         }
+         canonical_forms.canonicalize(*vertex_group, keys);
+         for ( const auto& key : keys )
+         {
+            // only the keys are of interest.
+            known_classes.insert(key, Support{});
+         }
+      }
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         remaining[lease] = jobs.size();
+         for ( auto& job : jobs )
+         {
+            queue.push_back(Job{std::move(job), lease});
+         }
+      }
+      condition.notify_all();
+   }
+}
+
+template <typename Integer, typename TagType>
+void panda::SubMasterJobManager<Integer, TagType>::serve(const int id) const
+{
+   BatchSize batch_size(static_cast<double>(prefetch_depth + 1) * target_round_trip, maximum_batch_size);
+   // batches sent by this thread whose results haven't been received yet.
+   std::size_t outstanding = 0;
+   bool failed = false;
+   while ( !failed )
+   {
+      // further batches are only sent ahead if jobs are available right now.
+      while ( outstanding <= prefetch_depth )
+      {
+         auto jobs = take(batch_size.get(), outstanding == 0);
+         if ( jobs.empty() )
+         {
+            break;
+         }
+         Batch batch;
+         batch.node = id;
+         batch.jobs.reserve(jobs.size());
+         batch.leases.reserve(jobs.size());
+         for ( auto& job : jobs )
+         {
+            batch.jobs.push_back(std::move(job.row));
+            batch.leases.push_back(job.lease);
+         }
+         const auto rows = batch.jobs;
+         const auto number = open(std::move(batch));
+         if ( !number || !communication.toSlave(rows, *number, id, deadline(id)) )
+         {
+            failed = true;
+            break;
+         }
+         ++outstanding;
+      }
+      if ( failed || outstanding == 0 ) // all jobs are done.
+      {
+         break;
+      }
+      // the results may belong to the batch of another thread serving the same node.
+      auto received = communication.fromSlave<Integer>(id, deadline(id));
+      if ( !received )
+      {
+         failed = true;
+         break;
+      }
+      --outstanding;
+      auto batch = close(received->lease);
+      if ( !batch ) // another thread gave up on the slave, the jobs are handed out again.
+      {
+         failed = true;
+         break;
+      }
+      batch_size.record(batch->leases.size(), Clock::now() - batch->opened);
+      gather(batch->leases, received->rows, std::move(received->supports));
+   }
+   if ( failed )
+   {
+      expire(id);
+   }
+   // an empty batch makes the slave thread stop (even if the slave has been given up on).
+   communication.toSlave(Matrix<Integer>{}, 0, id, deadline(id));
+}
+
+template <typename Integer, typename TagType>
+std::optional<std::size_t> panda::SubMasterJobManager<Integer, TagType>::open(Batch&& batch) const
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      if ( failed_slaves.count(batch.node) == 0 )
+      {
+         const auto number = next_batch++;
+         batch.opened = Clock::now();
+         lease_clock.sent(batch.node, batch.opened);
+         batches.emplace(number, std::move(batch));
+         return number;
+      }
+      for ( std::size_t i = 0; i < batch.jobs.size(); ++i )
+      {
+         queue.push_back(Job{std::move(batch.jobs[i]), batch.leases[i]});
+      }
+   }
+   condition.notify_all();
+   return std::nullopt;
+}
+
+template <typename Integer, typename TagType>
+std::optional<typename panda::SubMasterJobManager<Integer, TagType>::Batch> panda::SubMasterJobManager<Integer, TagType>::close(const std::size_t number) const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   const auto it = batches.find(number);
+   if ( it == batches.end() )
+   {
+      return std::nullopt;
+   }
+   // the slave is alive and starts on the next of its batches.
+   lease_clock.received(it->second.node, Clock::now());
+   auto batch = std::move(it->second);
+   batches.erase(it);
+   return batch;
+}
+
+template <typename Integer, typename TagType>
+Communication::Deadline panda::SubMasterJobManager<Integer, TagType>::deadline(const int node) const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return lease_clock.deadline(node, Clock::now());
+}
+
+template <typename Integer, typename TagType>
+void panda::SubMasterJobManager<Integer, TagType>::expire(const int node) const
+{
+   std::size_t count = 0;
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      if ( !failed_slaves.insert(node).second )
+      {
+         return;
+      }
+      for ( auto it = batches.begin(); it != batches.end(); )
+      {
+         if ( it->second.node == node )
+         {
+            // once the master is done, the jobs are of no use.
+            for ( std::size_t i = 0; i < it->second.jobs.size() && !finished; ++i )
+            {
+               queue.push_back(Job{std::move(it->second.jobs[i]), it->second.leases[i]});
+            }
+            count += it->second.jobs.size();
+            it = batches.erase(it);
+         }
+         else
+         {
+            ++it;
+         }
+      }
+   }
+   condition.notify_all();
+   communication.abandon(node);
+   std::stringstream stream;
+   stream << "Node " << node << " missed the deadline of its lease, its " << count << " jobs are handed out again.\n";
+   std::cerr << stream.str();
+}
+
+template <typename Integer, typename TagType>
+std::vector<typename panda::SubMasterJobManager<Integer, TagType>::Job> panda::SubMasterJobManager<Integer, TagType>::take(const std::size_t count, const bool wait) const
+{
+   assert( count > 0 );
+   std::unique_lock<std::mutex> lock(mutex);
+   if ( wait )
+   {
+      condition.wait(lock, [&](){ return !queue.empty() || finished; });
+   }
+   std::vector<Job> jobs;
+   while ( jobs.size() < count && !queue.empty() )
+   {
+      jobs.push_back(std::move(queue.front()));
+      queue.pop_front();
+   }
+   return jobs;
+}
+
+template <typename Integer, typename TagType>
+void panda::SubMasterJobManager<Integer, TagType>::gather(const std::vector<std::size_t>& leases, const Matrix<Integer>& rows, std::vector<Support>&& found) const
+{
+   assert( !vertex_group || found.size() == rows.size() );
+   std::vector<std::size_t> done;
+   Matrix<Integer> gathered;
+   std::vector<Support> gathered_supports;
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      for ( std::size_t i = 0; i < rows.size(); ++i )
+      {
+         if ( vertex_group )
+         {
+            if ( known_classes.find(found[i]) ) // the master knows the class already.
+            {
+               continue;
+            }
+            known_classes.insert(found[i], Support{});
+            supports.push_back(std::move(found[i]));
+         }
+         results.push_back(rows[i]);
+      }
+      for ( const auto lease : leases )
+      {
+         const auto it = remaining.find(lease);
+         assert( it != remaining.end() && it->second > 0 );
+         if ( --it->second == 0 )
+         {
+            remaining.erase(it);
+            done.push_back(lease);
+         }
+      }
+      // the rows are sent with the first lease that is done, which is no later than the
+      // leases of the jobs that found them. Hence the master has them before it is done.
+      if ( !done.empty() )
+      {
+         gathered.swap(results);
+         gathered_supports.swap(supports);
+      }
+   }
+   for ( const auto lease : done )
+   {
+      communication.toMaster(gathered, gathered_supports, lease, master);
+      gathered.clear();
+      gathered_supports.clear();
+   }
+}
+
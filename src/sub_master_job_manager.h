@@ -0,0 +1,143 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "communication.h"
+#include "idle_time.h"
+#include "incidence.h"
+#include "joining_thread.h"
+#include "lease_clock.h"
+#include "matrix.h"
+#include "names.h"
+#include "row.h"
+#include "support.h"
+#include "support_cache.h"
+#include "tags.h"
+#include "vertex_group.h"
+
+namespace panda
+{
+   /// Job manager of a sub-master ("--sub-masters=<n>"). The batches of jobs received from
+   /// the master are computed by the threads of this node and handed on to its slaves in
+   /// smaller batches. The results are gathered here: with a vertex group, rows whose class
+   /// is known to the master (received as a job or sent before) are dropped. The gathered
+   /// rows are sent to the master once all jobs of a batch of the master are done, with the
+   /// lease of that batch. Hence the master serves the sub-masters only, and the number of
+   /// its threads and messages doesn't grow with the number of slaves. The batches handed on
+   /// are leases as well: if a slave misses its deadline, this node gives up on it and the
+   /// jobs of its batches are handed out again.
+   template <typename Integer, typename TagType>
+   class SubMasterJobManager
+   {
+      public:
+         /// Gathers the rows found by the job of the calling thread.
+         void put(const Matrix<Integer>&) const;
+         /// Returns a job received from the master. Blocks the caller until data is available.
+         /// An empty row signals that all jobs are done.
+         Row<Integer> get() const;
+         /// Constructor. The arguments are those of JobManager, the names are ignored.
+         SubMasterJobManager(const Names&, const int, const int, const std::optional<VertexGroup>& vertex_group = std::nullopt, const Matrix<Integer>& vertices = Matrix<Integer>{}, const std::optional<std::chrono::seconds>& = std::nullopt, std::size_t prefetch_depth = 1, int sub_masters = 0);
+         /// Destructor: reports the fraction of the time the threads waited for jobs and the
+         /// number of results dropped.
+         ~SubMasterJobManager();
+      private:
+         using Clock = std::chrono::steady_clock;
+         /// A job and the lease of the batch of the master it belongs to.
+         struct Job
+         {
+            Row<Integer> row;
+            std::size_t lease;
+         };
+         /// A batch of jobs handed on to a slave.
+         struct Batch
+         {
+            Matrix<Integer> jobs{};
+            /// the leases of the master the jobs belong to (one per job).
+            std::vector<std::size_t> leases{};
+            int node{0};
+            Clock::time_point opened{};
+         };
+         /// Loop of the thread that receives the batches of the master.
+         void receive() const;
+         /// Loop of a thread that hands batches of jobs on to the slave.
+         void serve(int) const;
+         /// Registers the batch and returns its ID (std::nullopt if its slave has been given up
+         /// on, the jobs are handed out again then).
+         std::optional<std::size_t> open(Batch&&) const;
+         /// Returns the batch with the given ID and removes it (std::nullopt if its slave has
+         /// been given up on).
+         std::optional<Batch> close(std::size_t) const;
+         /// Returns the deadline of the slave.
+         Communication::Deadline deadline(int) const;
+         /// Gives up on the slave: the jobs of its batches are handed out again.
+         void expire(int) const;
+         /// Returns up to the given number of jobs. If the second argument is set, blocks the
+         /// caller until a job is available and an empty result signals the end. Otherwise,
+         /// an empty result only means that no job is available right now.
+         std::vector<Job> take(std::size_t, bool) const;
+         /// Gathers the rows found by jobs of the given leases (one lease per job) and their
+         /// canonical supports (empty without a vertex group). The gathered rows are sent to
+         /// the master with each lease whose jobs are all done.
+         void gather(const std::vector<std::size_t>&, const Matrix<Integer>&, std::vector<Support>&&) const;
+      private:
+         Communication communication;
+         const int master;
+         const int threads_per_processor;
+         const std::size_t prefetch_depth;
+         const std::optional<VertexGroup> vertex_group;
+         const Matrix<Integer> vertices;
+         const Incidence<Integer> incidence;
+         /// canonical forms of raw supports computed before (only used with a vertex group).
+         mutable SupportCache canonical_forms;
+         /// canonical supports of the classes known to the master (only used with a vertex group).
+         mutable SupportCache known_classes;
+         mutable IdleTime idle_time;
+         mutable std::mutex mutex;
+         mutable std::condition_variable condition;
+         /// jobs received from the master that weren't handed out yet.
+         mutable std::deque<Job> queue;
+         /// number of jobs that aren't done yet, for each lease of the master.
+         mutable std::map<std::size_t, std::size_t> remaining;
+         /// rows gathered since the last message to the master.
+         mutable Matrix<Integer> results;
+         /// canonical supports of the gathered rows (empty if there is no vertex group).
+         mutable std::vector<Support> supports;
+         /// lease of the job each calling thread is working on.
+         mutable std::map<std::thread::id, std::size_t> current;
+         mutable std::size_t next_batch;
+         /// batches handed on to the slaves whose results haven't been received yet.
+         mutable std::map<std::size_t, Batch> batches;
+         /// deadlines of the slaves.
+         mutable LeaseClock lease_clock;
+         /// slaves given up on.
+         mutable std::set<int> failed_slaves;
+         /// set once the master signaled the end.
+         mutable bool finished;
+         /// vital implementation detail: threads may access other members, hence, the threads must be destroyed first.
+         mutable std::list<JoiningThread> threads;
+      private:
+         /// Copy construction is not allowed.
+         SubMasterJobManager(const SubMasterJobManager<Integer, TagType>&) = delete;
+         /// Copy assignment is not allowed.
+         SubMasterJobManager<Integer, TagType>& operator=(const SubMasterJobManager<Integer, TagType>&) = delete;
+   };
+}
+
+#include "sub_master_job_manager.eti"
+
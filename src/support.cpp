@@ -0,0 +1,109 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "support.h"
+
+#include <cassert>
+#include <limits>
+
+#include "popcount.h"
+
+using namespace panda;
+
+namespace
+{
+   constexpr std::size_t bits_per_word = std::numeric_limits<Support::Word>::digits;
+}
+
+std::size_t panda::Support::Hash::operator()(const Support& support) const noexcept
+{
+   return support.hash();
+}
+
+panda::Support::Support(const std::size_t bits)
+:
+   number_of_bits(bits),
+   data((bits + bits_per_word - 1) / bits_per_word)
+{
+}
+
+std::size_t panda::Support::size() const noexcept
+{
+   return number_of_bits;
+}
+
+std::size_t panda::Support::count() const noexcept
+{
+   std::size_t total{0};
+   for ( const auto word : data )
+   {
+      total += static_cast<std::size_t>(popcount(static_cast<uint32_t>(word)));
+      total += static_cast<std::size_t>(popcount(static_cast<uint32_t>(word >> 32)));
+   }
+   return total;
+}
+
+void panda::Support::set(const std::size_t i) noexcept
+{
+   assert( i < number_of_bits );
+   data[i / bits_per_word] |= Word{1} << (i % bits_per_word);
+}
+
+bool panda::Support::test(const std::size_t i) const noexcept
+{
+   assert( i < number_of_bits );
+   return (data[i / bits_per_word] >> (i % bits_per_word)) & 1u;
+}
+
+std::vector<std::size_t> panda::Support::indices() const
+{
+   std::vector<std::size_t> result;
+   result.reserve(count());
+   for ( std::size_t k = 0; k < data.size(); ++k )
+   {
+      auto word = data[k];
+      for ( std::size_t bit = k * bits_per_word; word != 0; ++bit, word >>= 1 )
+      {
+         if ( (word & 1u) != 0 )
+         {
+            result.push_back(bit);
+         }
+      }
+   }
+   return result;
+}
+
+const std::vector<Support::Word>& panda::Support::words() const noexcept
+{
+   return data;
+}
+
+std::vector<Support::Word>& panda::Support::words() noexcept
+{
+   return data;
+}
+
+std::size_t panda::Support::hash() const noexcept
+{
+   // multiply-xorshift per word, the supports of a polytope differ in few bits only.
+   uint64_t value = number_of_bits;
+   for ( const auto word : data )
+   {
+      value = (value ^ word) * 0x9e3779b97f4a7c15ull;
+      value ^= value >> 29;
+   }
+   return static_cast<std::size_t>(value);
+}
+
+bool panda::Support::operator==(const Support& other) const noexcept
+{
+   return number_of_bits == other.number_of_bits && data == other.data;
+}
+
+bool panda::Support::operator!=(const Support& other) const noexcept
+{
+   return !(*this == other);
+}
+
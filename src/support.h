@@ -0,0 +1,55 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace panda
+{
+   /// The set of vertices on a face, stored as a bitset over the vertex indices.
+   /// Bits beyond the size are always zero, hence equal sets have equal words.
+   class Support
+   {
+      public:
+         /// Underlying data type.
+         using Word = uint64_t;
+         /// Hash functor, suitable for unordered containers.
+         struct Hash
+         {
+            std::size_t operator()(const Support&) const noexcept;
+         };
+         /// Constructor: empty set on zero vertices.
+         Support() = default;
+         /// Constructor: empty set, argument denotes the number of vertices.
+         explicit Support(std::size_t);
+         /// Returns the number of vertices (not the number of vertices in the set).
+         std::size_t size() const noexcept;
+         /// Returns the number of vertices in the set.
+         std::size_t count() const noexcept;
+         /// Adds the i^th vertex to the set.
+         void set(std::size_t) noexcept;
+         /// Checks if the i^th vertex is in the set.
+         bool test(std::size_t) const noexcept;
+         /// Returns the (sorted) indices of the vertices in the set.
+         std::vector<std::size_t> indices() const;
+         /// Returns the words holding the bits, the i^th bit is bit i % 64 of word i / 64.
+         const std::vector<Word>& words() const noexcept;
+         /// Grants write access to the words. Bits beyond the size must be left zero.
+         std::vector<Word>& words() noexcept;
+         /// Hash value computed from the words.
+         std::size_t hash() const noexcept;
+         /// Comparison (equality).
+         bool operator==(const Support&) const noexcept;
+         /// Comparison (inequality).
+         bool operator!=(const Support&) const noexcept;
+      private:
+         std::size_t number_of_bits{0};
+         std::vector<Word> data{};
+   };
+}
+
@@ -0,0 +1,116 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "support_cache.h"
+
+#include <cassert>
+#include <limits>
+#include <utility>
+
+using namespace panda;
+
+panda::SupportCache::SupportCache(const std::size_t capacity)
+:
+   shard_capacity((capacity + number_of_shards - 1) / number_of_shards),
+   shards(),
+   lookup_count(0),
+   hit_count(0)
+{
+   assert( capacity > 0 );
+   for ( auto& current : shards )
+   {
+      current.entries.reserve(shard_capacity);
+      current.order.reserve(shard_capacity);
+   }
+}
+
+std::optional<Support> panda::SupportCache::find(const Support& raw)
+{
+   lookup_count.fetch_add(1, std::memory_order_relaxed);
+   auto& current = shard(raw);
+   const std::lock_guard<std::mutex> lock(current.mutex);
+   const auto it = current.entries.find(raw);
+   if ( it == current.entries.end() )
+   {
+      return std::nullopt;
+   }
+   hit_count.fetch_add(1, std::memory_order_relaxed);
+   return it->second;
+}
+
+void panda::SupportCache::insert(const Support& raw, const Support& canonical)
+{
+   auto& current = shard(raw);
+   const std::lock_guard<std::mutex> lock(current.mutex);
+   if ( current.entries.count(raw) > 0 ) // another thread was faster.
+   {
+      return;
+   }
+   if ( current.entries.size() == shard_capacity )
+   {
+      current.entries.erase(current.entries.find(*current.order[current.next]));
+   }
+   // the keys are stored in the nodes of the map, which never move.
+   const auto* key = &current.entries.emplace(raw, canonical).first->first;
+   if ( current.order.size() < shard_capacity )
+   {
+      current.order.push_back(key);
+   }
+   else
+   {
+      current.order[current.next] = key;
+   }
+   current.next = (current.next + 1) % shard_capacity;
+}
+
+void panda::SupportCache::canonicalize(const VertexGroup& vertex_group, std::vector<Support>& supports)
+{
+   // neighbouring faces are found from many jobs, hence most raw supports recur.
+   std::vector<std::size_t> misses;
+   std::vector<Support> raw;
+   for ( std::size_t i = 0; i < supports.size(); ++i )
+   {
+      auto cached = find(supports[i]);
+      if ( cached )
+      {
+         supports[i] = std::move(*cached);
+      }
+      else
+      {
+         misses.push_back(i);
+         raw.push_back(supports[i]);
+      }
+   }
+   if ( misses.empty() )
+   {
+      return;
+   }
+   auto canonical = raw;
+   vertex_group.canonicalize(canonical);
+   for ( std::size_t k = 0; k < misses.size(); ++k )
+   {
+      insert(raw[k], canonical[k]);
+      supports[misses[k]] = std::move(canonical[k]);
+   }
+}
+
+std::size_t panda::SupportCache::lookups() const noexcept
+{
+   return lookup_count.load(std::memory_order_relaxed);
+}
+
+std::size_t panda::SupportCache::hits() const noexcept
+{
+   return hit_count.load(std::memory_order_relaxed);
+}
+
+SupportCache::Shard& panda::SupportCache::shard(const Support& support) noexcept
+{
+   // the low bits select the bucket within the shard, hence the high bits select the shard.
+   constexpr auto shift = std::numeric_limits<std::size_t>::digits - 4;
+   static_assert(number_of_shards == 16, "The shift has to match the number of shards.");
+   return shards[support.hash() >> shift];
+}
+
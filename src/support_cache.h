@@ -0,0 +1,59 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "support.h"
+#include "vertex_group.h"
+
+namespace panda
+{
+   /// Bounded map from raw supports to their canonical forms, shared between threads.
+   /// The entries are distributed over shards with a lock each. A full shard replaces
+   /// its oldest entry.
+   class SupportCache
+   {
+      public:
+         /// Constructor: argument denotes the maximal number of entries.
+         explicit SupportCache(std::size_t);
+         /// Returns the canonical form of the raw support, if it is cached.
+         std::optional<Support> find(const Support&);
+         /// Stores the canonical form of a raw support.
+         void insert(const Support&, const Support&);
+         /// Replaces each raw support by its canonical form under the group, computing
+         /// the forms that aren't cached in one batch and caching them.
+         void canonicalize(const VertexGroup&, std::vector<Support>&);
+         /// Returns the number of calls to find.
+         std::size_t lookups() const noexcept;
+         /// Returns the number of calls to find that found an entry.
+         std::size_t hits() const noexcept;
+      private:
+         struct Shard
+         {
+            std::mutex mutex{};
+            std::unordered_map<Support, Support, Support::Hash> entries{};
+            /// keys of the entries in order of insertion (ring buffer).
+            std::vector<const Support*> order{};
+            std::size_t next{0};
+         };
+         static constexpr std::size_t number_of_shards = 16;
+         const std::size_t shard_capacity;
+         std::array<Shard, number_of_shards> shards;
+         std::atomic<std::size_t> lookup_count;
+         std::atomic<std::size_t> hit_count;
+      private:
+         /// Returns the shard responsible for the support.
+         Shard& shard(const Support&) noexcept;
+   };
+}
+
@@ -0,0 +1,17 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+namespace panda
+{
+   namespace symmetry
+   {
+      /// Returns whether the symmetry group is to be detected from the input rows
+      /// ("--detect-symmetry"), instead of being taken from the maps only.
+      bool detection(int, char**);
+   }
+}
+
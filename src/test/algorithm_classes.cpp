@@ -16,6 +16,7 @@ namespace
 {
    void facet_class();
    void representative();
+   void signed_permutation_classes();
 }
 
 int main()
@@ -23,6 +24,7 @@ try
 {
    facet_class();
    representative();
+   signed_permutation_classes();
 }
 catch ( const TestingGearException& e )
 {
@@ -51,5 +53,26 @@ namespace
       const auto rep = algorithm::classRepresentative(facet, {xy, x}, tag::facet{});
       ASSERT((rep == Facet<int>{1, 0, 0, -1}), "");
    }
-}
 
+   void signed_permutation_classes()
+   {
+      Map xy{{std::make_pair(1u, 1)}, {std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(3u, 1)}};
+      Map minus_z{{std::make_pair(0u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, -1)}, {std::make_pair(3u, 1)}};
+      const Maps maps{xy, minus_z};
+      const Matrix<int> rows{{0, 1, 1, -1}, {1, 0, -1, -1}, {1, 0, 1, -1}, {0, 0, 1, 0}, {-1, 2, 0, 1}, {0, 0, -1, 0}, {2, -1, 0, 1}};
+      // reference: remove complete classes, starting with the smallest remaining row.
+      std::set<Row<int>> remaining(rows.cbegin(), rows.cend());
+      Matrix<int> expected;
+      while ( !remaining.empty() )
+      {
+         const auto row_class = algorithm::getClass(*remaining.begin(), maps, tag::facet{});
+         expected.push_back(*row_class.crbegin());
+         for ( const auto& row : row_class )
+         {
+            remaining.erase(row);
+         }
+      }
+      ASSERT((algorithm::classes(rows, maps, tag::facet{}) == expected), "");
+      ASSERT((expected == Matrix<int>{{2, -1, 0, 1}, {0, 0, 1, 0}, {1, 0, 1, -1}}), "");
+   }
+}
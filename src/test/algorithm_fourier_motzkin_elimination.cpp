@@ -10,7 +10,13 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <numeric>
 #include <random>
+#include <set>
+#include <vector>
+
+#include "vertex_group.h"
 
 using namespace panda;
 
@@ -18,6 +24,7 @@ namespace
 {
    void facetsConvexOnly();
    void vertices();
+   void symmetricFacets();
 }
 
 int main()
@@ -25,6 +32,7 @@ try
 {
    facetsConvexOnly();
    vertices();
+   symmetricFacets();
 }
 catch ( const TestingGearException& e )
 {
@@ -164,5 +172,41 @@ namespace
          ASSERT(vs == correct, "Data mismatch.");
       }
    }
-}
 
+   void symmetricFacets()
+   {
+      // cube with the permutations of the coordinates acting on the vertices.
+      Vertices<int> cube;
+      for ( int v = 0; v < 8; ++v )
+      {
+         cube.push_back({v / 4, (v / 2) % 2, v % 2, 1});
+      }
+      const auto index = [](const int x, const int y, const int z) { return static_cast<std::size_t>(4 * x + 2 * y + z); };
+      std::vector<std::size_t> swap(8);
+      std::vector<std::size_t> cycle(8);
+      for ( const auto& vertex : cube )
+      {
+         swap[index(vertex[0], vertex[1], vertex[2])] = index(vertex[1], vertex[0], vertex[2]);
+         cycle[index(vertex[0], vertex[1], vertex[2])] = index(vertex[1], vertex[2], vertex[0]);
+      }
+      const VertexGroup group({swap, cycle}, cube.size());
+      auto facets = algorithm::fourierMotzkinElimination(cube, group);
+      ASSERT(facets.size() == 2, "One facet per class expected.");
+      const auto all_facets = algorithm::fourierMotzkinElimination(cube);
+      const std::set<Row<int>> all(all_facets.cbegin(), all_facets.cend());
+      ASSERT(all.size() == 6, "Data mismatch.");
+      ASSERT(all.count(facets[0]) == 1 && all.count(facets[1]) == 1, "Rows of the classes expected.");
+      ASSERT(facets[0].back() != facets[1].back(), "Rows of different classes expected.");
+      // the identity group keeps all facets.
+      std::vector<std::size_t> identity(cube.size());
+      std::iota(identity.begin(), identity.end(), std::size_t{0});
+      const VertexGroup trivial({identity}, cube.size());
+      facets = algorithm::fourierMotzkinElimination(cube, trivial);
+      ASSERT(std::set<Row<int>>(facets.cbegin(), facets.cend()) == all, "Data mismatch.");
+      // a simplex has nothing to eliminate, yet one facet per class is expected.
+      const Vertices<int> triangle{{0, 0, 1}, {1, 0, 1}, {0, 1, 1}};
+      const VertexGroup symmetric({{1, 0, 2}, {1, 2, 0}}, triangle.size());
+      facets = algorithm::fourierMotzkinElimination(triangle, symmetric);
+      ASSERT(facets.size() == 1, "One facet per class expected.");
+   }
+}
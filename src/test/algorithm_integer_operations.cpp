@@ -7,7 +7,9 @@
 #include "testing_gear.h"
 
 #include "algorithm_integer_operations.h"
+#include "safe_integer.h"
 
+#include <cstdint>
 #include <limits>
 #include <random>
 
@@ -22,6 +24,8 @@ try
    ASSERT(algorithm::gcd(15, 1) == 1, "");
    ASSERT(algorithm::gcd(-36, 150) == 6, "");
    ASSERT(algorithm::gcd(150, -36) == 6, "");
+   ASSERT(algorithm::gcd(-48, -64) == 16, "");
+   ASSERT(algorithm::gcd(0, 0) == 0, "");
    std::random_device rd{};
    std::mt19937 mt{rd()};
    std::uniform_int_distribution<int> d_int(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
@@ -47,6 +51,14 @@ try
       ASSERT(algorithm::gcd(r0, r1) == 0 || (r0 % algorithm::gcd(r0, r1)) == 0, "gcd != 0 must divide the numbers.");
       ASSERT(algorithm::gcd(r0, r1) == 0 || (r1 % algorithm::gcd(r0, r1)) == 0, "gcd != 0 must divide the numbers.");
    }
+   std::uniform_int_distribution<int64_t> d_int64(-(int64_t(1) << 40), int64_t(1) << 40);
+   for ( int i = 0; i < 100; ++i )
+   {
+      const auto factor = d_int64(mt) % 1000;
+      const auto r0 = factor * (d_int64(mt) % 100000);
+      const auto r1 = factor * (d_int64(mt) % 100000);
+      ASSERT(SafeInteger(algorithm::gcd(r0, r1)) == algorithm::gcd(SafeInteger(r0), SafeInteger(r1)), "binary gcd must agree with euclidean gcd.");
+   }
    #endif
 }
 catch ( const TestingGearException& e )
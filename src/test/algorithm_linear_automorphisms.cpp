@@ -0,0 +1,117 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "algorithm_linear_automorphisms.h"
+
+#include <cstddef>
+#include <numeric>
+#include <set>
+#include <vector>
+
+#include "big_integer.h"
+#include "cast.h"
+#include "matrix.h"
+
+using namespace panda;
+
+namespace
+{
+   using Permutation = std::vector<std::size_t>;
+   /// Returns the number of elements of the group generated by the permutations.
+   std::size_t order(const std::vector<Permutation>&, std::size_t);
+   void cube();
+   void nonFullDimensional();
+   void affineSymmetries();
+}
+
+int main()
+try
+{
+   cube();
+   nonFullDimensional();
+   affineSymmetries();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   std::size_t order(const std::vector<Permutation>& generators, const std::size_t n)
+   {
+      Permutation identity(n);
+      std::iota(identity.begin(), identity.end(), 0);
+      std::set<Permutation> elements{identity};
+      std::vector<Permutation> queue{identity};
+      while ( !queue.empty() )
+      {
+         const auto element = queue.back();
+         queue.pop_back();
+         for ( const auto& generator : generators )
+         {
+            Permutation product(n);
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+               product[i] = generator[element[i]];
+            }
+            if ( elements.insert(product).second )
+            {
+               queue.push_back(product);
+            }
+         }
+      }
+      return elements.size();
+   }
+
+   void cube()
+   {
+      // homogenized vertices: the linear automorphisms are the affine symmetries.
+      Matrix<int> vertices;
+      for ( int i = 0; i < 8; ++i )
+      {
+         vertices.push_back({i & 1, (i >> 1) & 1, (i >> 2) & 1, 1});
+      }
+      ASSERT(order(algorithm::linearAutomorphisms(vertices), 8) == 48, "The cube has 48 symmetries.");
+      #ifndef NO_FLEXIBILITY
+      ASSERT(order(algorithm::linearAutomorphisms(cast<BigInteger>(vertices)), 8) == 48, "The cube has 48 symmetries.");
+      #endif
+      // the inequalities 0 <= x_i <= 1 as rows (b, a) of b - a x >= 0.
+      Matrix<int> inequalities;
+      for ( std::size_t i = 0; i < 3; ++i )
+      {
+         Row<int> lower(4, 0);
+         lower[i] = 1;
+         Row<int> upper(4, 0);
+         upper[i] = -1;
+         upper[3] = 1;
+         inequalities.push_back(lower);
+         inequalities.push_back(upper);
+      }
+      ASSERT(order(algorithm::linearAutomorphisms(inequalities), 6) == 48, "The cube's facets have 48 symmetries.");
+   }
+
+   void nonFullDimensional()
+   {
+      // a square in the plane z = 2 of R^3, plus a zero column.
+      const Matrix<int> vertices{{0, 0, 2, 0, 1}, {1, 0, 2, 0, 1}, {0, 1, 2, 0, 1}, {1, 1, 2, 0, 1}};
+      ASSERT(order(algorithm::linearAutomorphisms(vertices), 4) == 8, "The square has 8 symmetries.");
+   }
+
+   void affineSymmetries()
+   {
+      const Matrix<int> triangle{{0, 0, 1}, {3, 1, 1}, {1, 5, 1}};
+      ASSERT(order(algorithm::linearAutomorphisms(triangle), 3) == 6, "Every permutation of a simplex is affine.");
+      const Matrix<int> rectangle{{0, 0, 1}, {2, 0, 1}, {0, 1, 1}, {2, 1, 1}};
+      ASSERT(order(algorithm::linearAutomorphisms(rectangle), 4) == 8, "Affinely, every rectangle is a square.");
+      const Matrix<int> kite{{0, 0, 1}, {1, 0, 1}, {0, 1, 1}, {3, 3, 1}};
+      ASSERT(order(algorithm::linearAutomorphisms(kite), 4) == 2, "The kite is only symmetric to its diagonal.");
+      ASSERT(algorithm::linearAutomorphisms(Matrix<int>{{1, 2}}).empty(), "A single row has no symmetry.");
+   }
+}
@@ -8,6 +8,7 @@
 
 #include "algorithm_matrix_operations.h"
 
+#include <cstdint>
 #include <sstream>
 
 using namespace panda;
@@ -71,6 +72,12 @@ namespace
       ASSERT(algorithm::dimension(Matrix<int>{{1, 2, 3}, {0, 1, 0}, {0, 0, 1}, {0, 0, 1}}) == 3, "");
       ASSERT(algorithm::dimension(Matrix<int>{{1, 2, 3}, {0, 1, 0}}) == 2, "");
       ASSERT(algorithm::dimension(Matrix<int>{{0, 0, 0}, {0, 1, 0}}) == 1, "");
+      // pivots other than 1 and -1 (exact divisions in the fraction-free elimination).
+      ASSERT(algorithm::dimension(Matrix<int>{{2, 3, 5}, {4, 1, 7}, {6, 4, 12}}) == 2, "");
+      ASSERT(algorithm::dimension(Matrix<int>{{2, 3, 5}, {4, 1, 7}, {3, 9, 1}}) == 3, "");
+      ASSERT(algorithm::dimension(Matrix<int>{{6, 4, 2, 8}, {3, 5, 7, 1}, {9, 9, 9, 9}, {3, -1, -5, 7}}) == 2, "");
+      // the fraction-free elimination overflows int16_t, the gcd steps don't.
+      ASSERT(algorithm::dimension(Matrix<int16_t>{{-22, 13, -16}, {3, 13, -25}, {24, 28, 4}}) == 3, "");
    }
 
    void gaussian_elimination()
@@ -95,6 +102,15 @@ namespace
       r[1][1] = 0;
       r[2][2] = 0;
       ASSERT((r == Matrix<int>{{0, 0, 0}, {0, 0, 0}, {0, 0, 0}}), "Data mismatch");
+      // on overflow of the fraction-free elimination, the gcd steps yield the same result.
+      Matrix<int16_t> small{{3, -14, 2}, {0, 14, -14}, {-3, -13, 9}, {-1, 0, 0}, {0, -1, 0}, {0, 0, -1}};
+      Matrix<int> large{{3, -14, 2}, {0, 14, -14}, {-3, -13, 9}, {-1, 0, 0}, {0, -1, 0}, {0, 0, -1}};
+      const auto small_indices = algorithm::gaussianElimination(small);
+      ASSERT(small_indices == algorithm::gaussianElimination(large), "Index mismatch.");
+      for ( std::size_t i = 0; i < large.size(); ++i )
+      {
+         ASSERT((Row<int>(small[i].cbegin(), small[i].cend()) == large[i]), "Data mismatch.");
+      }
    }
 
    void transposition()
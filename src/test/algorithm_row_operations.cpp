@@ -7,7 +7,10 @@
 #include "testing_gear.h"
 
 #include "algorithm_row_operations.h"
+#include "big_integer.h"
+#include "safe_integer.h"
 
+#include <cstdint>
 #include <sstream>
 #include <stdexcept>
 
@@ -24,6 +27,7 @@ namespace
    void scalarProduct();
    void normalization();
    void gcd();
+   void divisionByGcd();
 }
 
 int main()
@@ -38,6 +42,7 @@ try
    scalarProduct();
    normalization();
    gcd();
+   divisionByGcd();
 }
 catch ( const TestingGearException& e )
 {
@@ -144,6 +149,33 @@ namespace
       Row<int> r{0, 2, 4, 0, -2, -4};
       ASSERT(algorithm::gcd(r) == 2, "range gcd invalid value.");
       ASSERT((r == Row<int>{0, 2, 4, 0, -2, -4}), "gcd modified value.");
+      ASSERT(algorithm::gcd(Row<int>{0, 0, 0}) == 0, "gcd of a zero row must be 0.");
+      ASSERT(algorithm::gcd(Row<int>{6, -9, 15, -1}) == 1, "gcd of a row with a unit must be 1.");
+      ASSERT(algorithm::gcd(Row<int>{-6, 0, 9, 15}) == 3, "range gcd invalid value.");
+      #ifndef NO_FLEXIBILITY
+      ASSERT(algorithm::gcd(Row<int64_t>{0, -12, 18, 30}) == 6, "range gcd invalid value (int64_t).");
+      ASSERT(algorithm::gcd(Row<SafeInteger>{SafeInteger(0), SafeInteger(-12), SafeInteger(18), SafeInteger(30)}) == SafeInteger(6), "range gcd invalid value (SafeInteger).");
+      #endif
+   }
+
+   void divisionByGcd()
+   {
+      Row<int> r{0, 8, -4, 0, 12};
+      algorithm::divideByGcd(r);
+      ASSERT((r == Row<int>{0, 2, -1, 0, 3}), "division by a power of two failed.");
+      r = {0, 6, -9, 0, 15};
+      algorithm::divideByGcd(r);
+      ASSERT((r == Row<int>{0, 2, -3, 0, 5}), "division by gcd failed.");
+      algorithm::divideByGcd(r);
+      ASSERT((r == Row<int>{0, 2, -3, 0, 5}), "division of a normalized row must not modify it.");
+      r = {0, 0, 0};
+      algorithm::divideByGcd(r);
+      ASSERT((r == Row<int>{0, 0, 0}), "division of a zero row must not modify it.");
+      #ifndef NO_FLEXIBILITY
+      Row<BigInteger> b{BigInteger(0), BigInteger(-6), BigInteger(9)};
+      algorithm::divideByGcd(b);
+      ASSERT((b == Row<BigInteger>{BigInteger(0), BigInteger(-2), BigInteger(3)}), "division by gcd failed (BigInteger).");
+      #endif
    }
 }
 
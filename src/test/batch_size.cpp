@@ -0,0 +1,72 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "batch_size.h"
+
+using namespace panda;
+
+namespace
+{
+   using Duration = BatchSize::Duration;
+   void shortJobs();
+   void longJobs();
+   void adapting();
+}
+
+int main()
+try
+{
+   shortJobs();
+   longJobs();
+   adapting();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void shortJobs()
+   {
+      BatchSize batch(Duration(0.1), 64);
+      ASSERT(batch.get() == 1, "The first batch is a single job.");
+      batch.record(1, Duration(0.001));
+      ASSERT(batch.get() == 2, "The size grows by at most a factor of two per round trip.");
+      for ( int i = 0; i < 10; ++i )
+      {
+         batch.record(batch.get(), Duration(0.001) * static_cast<double>(batch.get()));
+      }
+      ASSERT(batch.get() == 64, "The size is bounded by the maximum.");
+      batch.record(0, Duration(1.0));
+      ASSERT(batch.get() == 64, "Empty batches are ignored.");
+   }
+
+   void longJobs()
+   {
+      BatchSize batch(Duration(0.1), 64);
+      batch.record(1, Duration(2.0));
+      ASSERT(batch.get() == 1, "Long jobs are sent one by one.");
+   }
+
+   void adapting()
+   {
+      BatchSize batch(Duration(0.1), 1000);
+      for ( int i = 0; i < 20; ++i )
+      {
+         batch.record(batch.get(), Duration(0.001) * static_cast<double>(batch.get()));
+      }
+      ASSERT(batch.get() == 100, "A round trip takes about the target duration.");
+      for ( int i = 0; i < 20; ++i )
+      {
+         batch.record(batch.get(), Duration(0.01) * static_cast<double>(batch.get()));
+      }
+      ASSERT(batch.get() == 10, "The size shrinks once the jobs take longer.");
+   }
+}
+
@@ -14,6 +14,8 @@ namespace
 {
    void test_operator_unary_minus();
    void test_abs();
+   void test_residue();
+   void test_limbs();
 }
 
 int main()
@@ -21,6 +23,8 @@ try
 {
    test_operator_unary_minus();
    test_abs();
+   test_residue();
+   test_limbs();
 }
 catch ( const TestingGearException& e )
 {
@@ -45,5 +49,29 @@ namespace
       ASSERT(abs(BI(1)) == BI(1), "abs(BigInteger)");
       ASSERT(abs(BI(-1)) == BI(1), "abs(BigInteger)");
    }
-}
 
+   void test_residue()
+   {
+      const BI prime(int64_t{2305843009213693951}); // 2^61 - 1
+      ASSERT(BI(0).residue() == 0, "residue()");
+      ASSERT(BI(5).residue() == 5, "residue()");
+      ASSERT(BI(-5).residue() == 2305843009213693946u, "residue()");
+      ASSERT(prime.residue() == 0, "residue()");
+      ASSERT((prime + BI(3)).residue() == 3, "residue()");
+      ASSERT((prime * prime + BI(7)).residue() == 7, "residue()");
+      ASSERT((-(prime * BI(int64_t{1} << 40)) - BI(1)).residue() == 2305843009213693950u, "residue()");
+      ASSERT((BI(int64_t{1} << 62) * BI(int64_t{1} << 62)).residue() == 4, "residue()"); // 2^124 = 2^2
+   }
+
+   void test_limbs()
+   {
+      ASSERT((BI(0).limbs() == std::vector<uint64_t>{0}), "limbs()");
+      ASSERT((BI(-5).limbs() == std::vector<uint64_t>{5}), "limbs()");
+      const auto big = BI(int64_t{1} << 62) * BI(int64_t{12});
+      ASSERT((big.limbs() == std::vector<uint64_t>{0, 3}), "limbs()");
+      ASSERT(BI(false, big.limbs()) == big, "BigInteger(bool, limbs)");
+      ASSERT(BI(true, big.limbs()) == -big, "BigInteger(bool, limbs)");
+      ASSERT(BI(true, {0, 0}) == BI(0), "BigInteger(bool, limbs)");
+      ASSERT(BI(false, {}) == BI(0), "BigInteger(bool, limbs)");
+   }
+}
@@ -17,6 +17,7 @@ namespace
    void merge();
    void intersect();
    void count();
+   void test();
 }
 
 int main()
@@ -27,6 +28,7 @@ try
    merge();
    intersect();
    count();
+   test();
 }
 catch ( const TestingGearException& e )
 {
@@ -86,5 +88,12 @@ namespace
          ASSERT(a.count(10) == i + 1, "Count mismatch");
       }
    }
+   void test()
+   {
+      BitsetFixedSize<4> a(100);
+      a.set(3);
+      a.set(70);
+      ASSERT(a.test(3) && a.test(70), "Set bits should be set");
+      ASSERT(!a.test(4) && !a.test(69) && !a.test(99), "Other bits should not be set");
+   }
 }
-
@@ -0,0 +1,43 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "buffer_pool.h"
+
+#include <utility>
+
+using namespace panda;
+
+int main()
+try
+{
+   {  // released buffers are reused with their capacity
+      BufferPool pool(1);
+      auto buffer = pool.acquire();
+      ASSERT(buffer.empty(), "A new buffer is empty.");
+      buffer.resize(1000);
+      const auto* data = buffer.data();
+      pool.release(std::move(buffer));
+      auto reused = pool.acquire();
+      ASSERT(reused.empty(), "A reused buffer is empty.");
+      ASSERT(reused.capacity() >= 1000 && reused.data() == data, "A reused buffer keeps its memory.");
+   }
+   {  // the pool is bounded
+      BufferPool pool(1);
+      BufferPool::Buffer first(10);
+      BufferPool::Buffer second(20);
+      pool.release(std::move(first));
+      pool.release(std::move(second));
+      ASSERT(pool.acquire().capacity() >= 10, "The first buffer is kept.");
+      ASSERT(pool.acquire().capacity() == 0, "The second buffer is dropped.");
+   }
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
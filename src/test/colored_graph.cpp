@@ -0,0 +1,154 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "colored_graph.h"
+
+#include <cstddef>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace panda;
+
+namespace
+{
+   /// Returns the number of elements of the group generated by the permutations.
+   std::size_t order(const std::vector<ColoredGraph::Permutation>&, std::size_t);
+   /// Returns the graph whose edges are given by the adjacency function (color 1, other pairs color 0).
+   template <typename Adjacency>
+   ColoredGraph graph(std::size_t, Adjacency);
+   void trivial();
+   void cycles();
+   void petersen();
+   void vertexColors();
+}
+
+int main()
+try
+{
+   trivial();
+   cycles();
+   petersen();
+   vertexColors();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   std::size_t order(const std::vector<ColoredGraph::Permutation>& generators, const std::size_t n)
+   {
+      ColoredGraph::Permutation identity(n);
+      std::iota(identity.begin(), identity.end(), 0);
+      std::set<ColoredGraph::Permutation> elements{identity};
+      std::vector<ColoredGraph::Permutation> queue{identity};
+      while ( !queue.empty() )
+      {
+         const auto element = queue.back();
+         queue.pop_back();
+         for ( const auto& generator : generators )
+         {
+            ColoredGraph::Permutation product(n);
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+               product[i] = generator[element[i]];
+            }
+            if ( elements.insert(product).second )
+            {
+               queue.push_back(product);
+            }
+         }
+      }
+      return elements.size();
+   }
+
+   template <typename Adjacency>
+   ColoredGraph graph(const std::size_t n, Adjacency adjacent)
+   {
+      std::vector<ColoredGraph::Color> colors(n * n, 0);
+      for ( std::size_t i = 0; i < n; ++i )
+      {
+         for ( std::size_t j = 0; j < n; ++j )
+         {
+            colors[i * n + j] = (i != j && adjacent(i, j)) ? 1 : 0;
+         }
+      }
+      return ColoredGraph(n, colors);
+   }
+
+   void trivial()
+   {
+      ASSERT_EXCEPTION(ColoredGraph(3, std::vector<ColoredGraph::Color>(8)), std::invalid_argument, "Every pair needs a color.");
+      ASSERT(ColoredGraph(1, {0}).automorphisms().empty(), "A single vertex has no symmetry.");
+      // the path 0 - 1 - 2 - 3 with an extra leaf 4 at 1 only allows swapping 0 and 4.
+      const std::set<std::pair<std::size_t, std::size_t>> edges{{0, 1}, {1, 2}, {2, 3}, {1, 4}};
+      const auto path = graph(5, [&](std::size_t i, std::size_t j)
+      {
+         return edges.count({i, j}) > 0 || edges.count({j, i}) > 0;
+      });
+      const auto generators = path.automorphisms();
+      ASSERT(order(generators, 5) == 2, "Path with a leaf.");
+      for ( const auto& generator : generators )
+      {
+         ASSERT(path.isAutomorphism(generator), "Generators are automorphisms.");
+      }
+   }
+
+   void cycles()
+   {
+      for ( std::size_t n = 3; n <= 9; ++n )
+      {
+         const auto cycle = graph(n, [n](std::size_t i, std::size_t j) { return (i + 1) % n == j || (j + 1) % n == i; });
+         const auto generators = cycle.automorphisms();
+         ASSERT(order(generators, n) == 2 * n, "The automorphism group of a cycle is dihedral.");
+      }
+      const auto complete = graph(5, [](std::size_t, std::size_t) { return true; });
+      ASSERT(order(complete.automorphisms(), 5) == 120, "The automorphism group of a complete graph is symmetric.");
+   }
+
+   void petersen()
+   {
+      // vertices are the 2-subsets of {0, ..., 4}, adjacent iff disjoint.
+      std::vector<std::pair<std::size_t, std::size_t>> subsets;
+      for ( std::size_t a = 0; a < 5; ++a )
+      {
+         for ( std::size_t b = a + 1; b < 5; ++b )
+         {
+            subsets.emplace_back(a, b);
+         }
+      }
+      const auto graph_petersen = graph(10, [&](std::size_t i, std::size_t j)
+      {
+         const auto& s = subsets[i];
+         const auto& t = subsets[j];
+         return s.first != t.first && s.first != t.second && s.second != t.first && s.second != t.second;
+      });
+      ASSERT(order(graph_petersen.automorphisms(), 10) == 120, "The automorphism group of the Petersen graph has order 120.");
+   }
+
+   void vertexColors()
+   {
+      // a 4-cycle with one vertex colored differently keeps the reflection through it.
+      std::vector<ColoredGraph::Color> colors(16, 0);
+      for ( std::size_t i = 0; i < 4; ++i )
+      {
+         colors[i * 4 + (i + 1) % 4] = 1;
+         colors[((i + 1) % 4) * 4 + i] = 1;
+      }
+      colors[0] = 2;
+      const ColoredGraph cycle(4, colors);
+      const auto generators = cycle.automorphisms();
+      ASSERT(order(generators, 4) == 2, "Reflection through the colored vertex.");
+      ASSERT(generators.front()[0] == 0 && generators.front()[2] == 2, "The colored vertex and its opposite are fixed.");
+   }
+}
@@ -0,0 +1,118 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "compiled_map.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "algorithm_map_operations.h"
+#include "algorithm_row_operations.h"
+#include "big_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   void not_applicable();
+   void dropped_coordinates();
+   template <typename Integer>
+   void random_maps(std::size_t);
+}
+
+int main()
+try
+{
+   not_applicable();
+   dropped_coordinates();
+   for ( std::size_t dimension = 1; dimension <= 6; ++dimension )
+   {
+      random_maps<int>(dimension);
+      #ifndef NO_FLEXIBILITY
+      random_maps<BigInteger>(dimension);
+      #endif
+   }
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void not_applicable()
+   {
+      Map affine{{std::make_pair(0u, -1), std::make_pair(2u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}};
+      Map scaled{{std::make_pair(0u, 2)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}};
+      Map collapsing{{std::make_pair(0u, 1)}, {std::make_pair(0u, -1)}, {std::make_pair(2u, 1)}};
+      for ( const auto& map : {affine, scaled, collapsing} )
+      {
+         ASSERT(CompiledMap::create(map, tag::facet{}) == std::nullopt, "");
+         ASSERT(CompiledMap::create(map, tag::vertex{}) == std::nullopt, "");
+      }
+   }
+
+   void dropped_coordinates()
+   {
+      // the second coordinate is eliminated by an equation.
+      Map swap{{std::make_pair(2u, -1)}, {}, {std::make_pair(0u, 1)}};
+      const auto compiled = CompiledMap::create(swap, tag::facet{});
+      ASSERT(compiled != std::nullopt, "");
+      ASSERT(compiled->size() == 3, "");
+      Row<int> image(3);
+      ASSERT(!compiled->apply(Row<int>{3, 1, -5}, image), "");
+      ASSERT(compiled->apply(Row<int>{3, 0, -5}, image), "");
+      ASSERT((image == algorithm::apply(swap, Row<int>{3, 0, -5}, tag::facet{})), "");
+      ASSERT((image == Row<int>{-5, 0, -3}), "");
+   }
+
+   template <typename Integer>
+   void random_maps(const std::size_t dimension)
+   {
+      std::mt19937 generator(static_cast<unsigned>(dimension));
+      std::uniform_int_distribution<int> entry(-3, 3);
+      std::bernoulli_distribution negative(0.3);
+      for ( int trial = 0; trial < 20; ++trial )
+      {
+         std::vector<std::size_t> targets(dimension);
+         std::iota(targets.begin(), targets.end(), std::size_t{0});
+         std::shuffle(targets.begin(), targets.end(), generator);
+         Map map(dimension);
+         for ( std::size_t i = 0; i < dimension; ++i )
+         {
+            map[i].push_back(std::make_pair(targets[i], negative(generator) ? -1 : 1));
+         }
+         const auto facet_map = CompiledMap::create(map, tag::facet{});
+         const auto vertex_map = CompiledMap::create(map, tag::vertex{});
+         ASSERT(facet_map != std::nullopt && vertex_map != std::nullopt, "");
+         for ( int k = 0; k < 10; ++k )
+         {
+            Row<Integer> row(dimension);
+            for ( auto& value : row )
+            {
+               value = Integer(entry(generator));
+            }
+            auto normalized = row;
+            algorithm::divideByGcd(normalized);
+            if ( normalized != row )
+            {
+               continue;
+            }
+            Row<Integer> image(dimension);
+            ASSERT(facet_map->apply(row, image), "");
+            ASSERT((image == algorithm::apply(map, row, tag::facet{})), "");
+            ASSERT(vertex_map->apply(row, image), "");
+            ASSERT((image == algorithm::apply(map, row, tag::vertex{})), "");
+         }
+      }
+   }
+}
+
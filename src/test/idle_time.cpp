@@ -0,0 +1,38 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "idle_time.h"
+
+#include <cmath>
+#include <thread>
+
+using namespace panda;
+
+int main()
+try
+{
+   using Duration = IdleTime::Duration;
+   {  // without any waits, the process isn't idle
+      IdleTime idle;
+      ASSERT(idle.fraction(Duration(1.0)) < 1e-9, "Nothing recorded.");
+   }
+   {  // the waits are averaged over the threads that recorded
+      IdleTime idle;
+      idle.record(Duration(2.0));
+      idle.record(Duration(1.0));
+      ASSERT(std::abs(idle.fraction(Duration(10.0)) - 0.3) < 1e-9, "One thread waited 3 of 10 seconds.");
+      std::thread other([&]() { idle.record(Duration(5.0)); });
+      other.join();
+      ASSERT(std::abs(idle.fraction(Duration(10.0)) - 0.4) < 1e-9, "Two threads waited 8 of 20 seconds.");
+      ASSERT(std::abs(idle.fraction(Duration(1.0)) - 1.0) < 1e-9, "The fraction is at most one.");
+   }
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
@@ -0,0 +1,102 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "incidence.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "algorithm_inequality_operations.h"
+#include "big_integer.h"
+#include "safe_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   void multiplesOfThePrime();
+   template <typename Integer>
+   void randomRows();
+}
+
+int main()
+try
+{
+   multiplesOfThePrime();
+   randomRows<int>();
+   #ifndef NO_FLEXIBILITY
+   randomRows<BigInteger>();
+   randomRows<SafeInteger>();
+   #endif
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void multiplesOfThePrime()
+   {
+      #ifndef NO_FLEXIBILITY
+      using BI = BigInteger;
+      // distances that are multiples of the prime 2^61 - 1 have a zero residue, but aren't zero.
+      const BI prime(int64_t{2305843009213693951});
+      const Vertices<BI> vertices = {{prime, BI(1)}, {BI(1), BI(0)}, {BI(0), BI(1)}};
+      const Incidence<BI> incidence(vertices);
+      ASSERT(&incidence.vertices() == &vertices, "The vertices have to be referenced.");
+      ASSERT((incidence.support({BI(1), BI(0)}) == std::vector<std::size_t>{2}), "Support with a false residue zero.");
+      ASSERT((incidence.support({BI(1), -prime}) == std::vector<std::size_t>{0}), "Support with a false residue zero.");
+      ASSERT((incidence.verticesOnFace({BI(1), -prime}) == Vertices<BI>{vertices[0]}), "Vertices on a face.");
+      ASSERT(incidence.support({BI(1), BI(1)}).empty(), "Empty support.");
+      #endif
+   }
+
+   template <typename Integer>
+   void randomRows()
+   {
+      std::mt19937 generator{7};
+      std::uniform_int_distribution<int> distribution(-3, 3);
+      const auto random_row = [&]()
+      {
+         Row<Integer> row;
+         for ( int i = 0; i < 6; ++i )
+         {
+            row.push_back(Integer(distribution(generator)));
+         }
+         return row;
+      };
+      Vertices<Integer> vertices;
+      for ( int i = 0; i < 40; ++i )
+      {
+         vertices.push_back(random_row());
+      }
+      const Incidence<Integer> incidence(vertices);
+      for ( int i = 0; i < 200; ++i )
+      {
+         const auto inequality = random_row();
+         std::vector<std::size_t> expected;
+         for ( std::size_t j = 0; j < vertices.size(); ++j )
+         {
+            if ( algorithm::distance(inequality, vertices[j]) == 0 )
+            {
+               expected.push_back(j);
+            }
+         }
+         ASSERT(incidence.support(inequality) == expected, "Support differs from the exact computation.");
+         ASSERT(incidence.supportBitset(inequality).indices() == expected, "Support bitset differs from the exact computation.");
+         ASSERT(incidence.verticesOnFace(inequality).size() == expected.size(), "Vertices on face differ from the support.");
+         ASSERT(incidence.nearestVertex(inequality) == algorithm::nearestVertex(vertices, inequality), "Nearest vertex differs.");
+         ASSERT(incidence.furthestVertex(inequality) == algorithm::furthestVertex(vertices, inequality), "Furthest vertex differs.");
+      }
+   }
+}
+
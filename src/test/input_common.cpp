@@ -6,8 +6,10 @@
 
 #include "testing_gear.h"
 
+#include "big_integer.h"
 #include "input_common.h"
 
+#include <cstdint>
 #include <sstream>
 #include <stdexcept>
 
@@ -25,6 +27,8 @@ namespace
    void errors();
    void normalization();
    void string_to_int();
+   void string_to_integer();
+   void read_integer();
 }
 
 int main()
@@ -40,6 +44,8 @@ try
    errors();
    normalization();
    string_to_int();
+   string_to_integer();
+   read_integer();
 }
 catch ( const TestingGearException& e )
 {
@@ -240,5 +246,35 @@ namespace
       ASSERT(toInt("-10") == -10, "Data mismatch.");
       ASSERT_ANY_EXCEPTION(toInt("a"), "Invalid data must result in an exception.");
    }
-}
 
+   void string_to_integer()
+   {
+      using input::toInteger;
+      ASSERT(toInteger<int16_t>("") == 1, "The empty string represents a factor of 1.");
+      ASSERT(toInteger<int16_t>("-") == -1, "Data mismatch.");
+      ASSERT(toInteger<int16_t>("-32768") == -32768, "Data mismatch.");
+      ASSERT_EXCEPTION(toInteger<int16_t>("32768"), std::invalid_argument, "Overflow must result in an exception.");
+      ASSERT(toInteger<int64_t>("+9223372036854775807") == INT64_MAX, "Data mismatch.");
+      ASSERT_EXCEPTION(toInteger<int64_t>("9223372036854775808"), std::invalid_argument, "Overflow must result in an exception.");
+      const auto big = toInteger<BigInteger>("-123456789012345678901234567890");
+      const auto shift = BigInteger(100000) * BigInteger(100000);
+      const BigInteger block(1234567890);
+      ASSERT(big == BigInteger(0) - ((block * shift + block) * shift + block), "Data mismatch.");
+      ASSERT(toInteger<BigInteger>("+") == BigInteger(1), "Data mismatch.");
+      ASSERT_ANY_EXCEPTION(toInteger<BigInteger>("a"), "Invalid data must result in an exception.");
+   }
+
+   void read_integer()
+   {
+      using input::readInteger;
+      std::istringstream stream(" -17 +4 100000000000000000000 x");
+      BigInteger a(0), b(0), c(0), d(0);
+      ASSERT(readInteger(stream, a) && a == BigInteger(-17), "Data mismatch.");
+      ASSERT(readInteger(stream, b) && b == BigInteger(4), "Data mismatch.");
+      ASSERT(readInteger(stream, c) && c == BigInteger(100000) * BigInteger(1000000000) * BigInteger(1000000), "Data mismatch.");
+      ASSERT(!readInteger(stream, d), "Reading a non-number must fail.");
+      std::istringstream overflow("40000");
+      int16_t small = 0;
+      ASSERT_EXCEPTION(readInteger(overflow, small), std::invalid_argument, "Overflow must result in an exception.");
+   }
+}
@@ -45,13 +45,13 @@ namespace
                                  "-x +y -2z >= -1"} )
       {
          std::istringstream stream(string);
-         ASSERT_NOTHROW(constraint<ConstraintType::Inequality>(stream, names), "Reading valid data may not throw.");
+         ASSERT_NOTHROW((constraint<ConstraintType::Inequality, int>(stream, names)), "Reading valid data may not throw.");
       }
       for ( const auto string : {"-y +x 2z = 1",
                                  "-y +x 2z == 1"} )
       {
          std::istringstream stream(string);
-         ASSERT_NOTHROW(constraint<ConstraintType::Equation>(stream, names), "Reading valid data may not throw.");
+         ASSERT_NOTHROW((constraint<ConstraintType::Equation, int>(stream, names)), "Reading valid data may not throw.");
       }
       for ( const auto string : {"x -y +2z <= 1",
                                  "+x -1y 2z <= 1",
@@ -59,13 +59,13 @@ namespace
                                  "-x +y -2z >= -1"} )
       {
          std::istringstream stream(string);
-         ASSERT((constraint<ConstraintType::Inequality>(stream, names) == Row<int>{1, -1, 2, -1}), "Data mismatch.");
+         ASSERT((constraint<ConstraintType::Inequality, int>(stream, names) == Row<int>{1, -1, 2, -1}), "Data mismatch.");
       }
       for ( const auto string : {"-y +x 2z = 1",
                                  "-y +x 2z == 1"} )
       {
          std::istringstream stream(string);
-         ASSERT((constraint<ConstraintType::Equation>(stream, names) == Row<int>{1, -1, 2, -1}), "Data mismatch.");
+         ASSERT((constraint<ConstraintType::Equation, int>(stream, names) == Row<int>{1, -1, 2, -1}), "Data mismatch.");
       }
    }
 
@@ -84,7 +84,7 @@ namespace
                                std::make_pair("x y z <= >= 1", "Two relation operators.")} )
       {
          std::istringstream stream(pair.first);
-         ASSERT_EXCEPTION(constraint<ConstraintType::Inequality>(stream, names), std::invalid_argument, pair.second);
+         ASSERT_EXCEPTION((constraint<ConstraintType::Inequality, int>(stream, names)), std::invalid_argument, pair.second);
       }
    }
 }
@@ -49,11 +49,11 @@ namespace
       {
          {
             std::istringstream stream(string);
-            ASSERT_NOTHROW(constraint<ConstraintType::Inequality>(stream), "On valid input, constraint read method may not throw.");
+            ASSERT_NOTHROW((constraint<ConstraintType::Inequality, int>(stream)), "On valid input, constraint read method may not throw.");
          }
          {
             std::istringstream stream(string);
-            ASSERT((constraint<ConstraintType::Inequality>(stream) == Row<int>{1, 2, -3, -10, 1}), "Data mismatch.");
+            ASSERT((constraint<ConstraintType::Inequality, int>(stream) == Row<int>{1, 2, -3, -10, 1}), "Data mismatch.");
          }
       }
       for ( const auto string : {"   1 \t2 -3  -10\t 1",
@@ -64,22 +64,22 @@ namespace
       {
          {
             std::istringstream stream(string);
-            ASSERT_NOTHROW(constraint<ConstraintType::Equation>(stream), "On valid input, constraint read method may not throw.");
+            ASSERT_NOTHROW((constraint<ConstraintType::Equation, int>(stream)), "On valid input, constraint read method may not throw.");
          }
          {
             std::istringstream stream(string);
-            ASSERT((constraint<ConstraintType::Equation>(stream) == Row<int>{1, 2, -3, -10, 1}), "Data mismatch.");
+            ASSERT((constraint<ConstraintType::Equation, int>(stream) == Row<int>{1, 2, -3, -10, 1}), "Data mismatch.");
          }
       }
       {
          std::stringstream stream("");
-         constraint<ConstraintType::Inequality>(stream);
-         ASSERT_NOTHROW(constraint<ConstraintType::Inequality>(stream), "Empty line may not throw exception.");
+         constraint<ConstraintType::Inequality, int>(stream);
+         ASSERT_NOTHROW((constraint<ConstraintType::Inequality, int>(stream)), "Empty line may not throw exception.");
       }
       {
          std::stringstream stream("");
-         constraint<ConstraintType::Inequality>(stream);
-         ASSERT(constraint<ConstraintType::Inequality>(stream).empty(), "Empty line must result in empty row.");
+         constraint<ConstraintType::Inequality, int>(stream);
+         ASSERT((constraint<ConstraintType::Inequality, int>(stream).empty()), "Empty line must result in empty row.");
       }
    }
 
@@ -101,7 +101,7 @@ namespace
       {
          std::stringstream stream(string);
          const auto message = "Invalid input must result in std::invalid_argument (missing right hand side).";
-         ASSERT_EXCEPTION(constraint<ConstraintType::Inequality>(stream), std::invalid_argument, message);
+         ASSERT_EXCEPTION((constraint<ConstraintType::Inequality, int>(stream)), std::invalid_argument, message);
       }
       for ( const auto string : {"   1 \t2 -3  -10\t < 0",
                                  "   1 \t2 -3  -10\t < -1",
@@ -115,7 +115,7 @@ namespace
       {
          {
             std::istringstream stream(string);
-            ASSERT_ANY_EXCEPTION(constraint<ConstraintType::Inequality>(stream), "If an invalid relation operator is used, an exception must be thrown.");
+            ASSERT_ANY_EXCEPTION((constraint<ConstraintType::Inequality, int>(stream)), "If an invalid relation operator is used, an exception must be thrown.");
          }
       }
       for ( const auto string : {" 1 \t a 2",
@@ -125,7 +125,7 @@ namespace
          std::stringstream stream(string);
          std::string message = "Invalid input must result in std::invalid_argument";
          message += " (invalid character or identifier).";
-         ASSERT_EXCEPTION(constraint<ConstraintType::Inequality>(stream), std::invalid_argument, message);
+         ASSERT_EXCEPTION((constraint<ConstraintType::Inequality, int>(stream)), std::invalid_argument, message);
       }
    }
 }
@@ -6,10 +6,28 @@
 
 #include "testing_gear.h"
 
+#include "method_expansion.h"
 #include "method_facet_enumeration.h"
 #include "method_vertex_enumeration.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <set>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <filesystem>
+#endif
 
 using namespace panda;
 
@@ -28,6 +46,19 @@ namespace
    void sample3_vertexEnumeration_AD_r1();
    void sample5_facetEnumeration_AD_r1();
    void sample5_facetEnumeration_AD_r1_minv3();
+   void sample2_affine_facetEnumeration_AD();
+   void sample3_vp_vertexEnumeration_AD();
+   void sample2_detectSymmetry_facetEnumeration_AD();
+   void sample2_expansion();
+   void sample3_vp_expansion();
+   void bell3322_processes_AD();
+   void bell3322_distributed_AD();
+   void bell3322_subMasters_AD();
+   void bell3322_leasePrefetch_AD();
+   void bell3322_lease_stoppedSlave_AD();
+   void sample3_processes_vertexEnumeration_AD();
+   void sample1_subMasters_stoppedSlave_AD();
+   void bell3322_subMasters_stoppedSlave_AD();
 }
 
 int main()
@@ -46,6 +77,19 @@ try
    sample3_vertexEnumeration_AD_r1();
    sample5_facetEnumeration_AD_r1();
    sample5_facetEnumeration_AD_r1_minv3();
+   sample2_affine_facetEnumeration_AD();
+   sample3_vp_vertexEnumeration_AD();
+   sample2_detectSymmetry_facetEnumeration_AD();
+   sample2_expansion();
+   sample3_vp_expansion();
+   bell3322_processes_AD();
+   bell3322_distributed_AD();
+   bell3322_subMasters_AD();
+   bell3322_leasePrefetch_AD();
+   bell3322_lease_stoppedSlave_AD();
+   sample3_processes_vertexEnumeration_AD();
+   sample1_subMasters_stoppedSlave_AD();
+   bell3322_subMasters_stoppedSlave_AD();
 }
 catch ( const TestingGearException& e )
 {
@@ -635,4 +679,463 @@ namespace
       }
       ASSERT(facet_count == 4, "Sample 5 (AD, r=1, minv=3): Expected 4 facets");
    }
+
+   /// Sample 2 (affine): Facet enumeration with AD and maps including x -> 1 - x
+   /// Input: samples/panda_format/sample_2_affine (unit cube vertices, full symmetry group)
+   /// Expected: a single facet class
+   void sample2_affine_facetEnumeration_AD()
+   {
+      SILENCE_CERR();
+
+      char* argv[] = {
+         (char*)"panda",
+         (char*)"../samples/panda_format/sample_2_affine",
+         (char*)"-m", (char*)"ad",
+         (char*)"-t", (char*)"1"
+      };
+      int argc = 6;
+
+      std::ostringstream output;
+      std::streambuf* old_cout = std::cout.rdbuf(output.rdbuf());
+      std::ostringstream errors;
+      std::cerr.rdbuf(errors.rdbuf());
+
+      int result = panda::method::facetEnumeration(argc, argv);
+
+      std::cout.rdbuf(old_cout);
+
+      ASSERT(result == 0, "Sample 2 (affine, AD): Facet enumeration failed");
+
+      std::string output_str = output.str();
+      ASSERT(output_str.find("Inequalities:") != std::string::npos,
+             "Sample 2 (affine, AD): Output missing 'Inequalities:' header");
+
+      int facet_count = 0;
+      std::istringstream iss(output_str);
+      std::string line;
+      bool in_inequalities = false;
+      while (std::getline(iss, line))
+      {
+         if (line.find("Inequalities:") != std::string::npos)
+         {
+            in_inequalities = true;
+            continue;
+         }
+         if (in_inequalities && !line.empty() && line.find_first_not_of(" \t") != std::string::npos)
+         {
+            facet_count++;
+         }
+      }
+      ASSERT(facet_count == 1, "Sample 2 (affine, AD): Expected 1 facet class");
+      ASSERT(errors.str().find("orbit size 6") != std::string::npos,
+             "Sample 2 (affine, AD): Expected an orbit of 6 facets");
+      ASSERT(errors.str().find("total number of facets: 6") != std::string::npos,
+             "Sample 2 (affine, AD): Expected 6 facets in total");
+   }
+
+   /// Sample 3 (vertex permutations): Vertex enumeration with AD and permutations of the inequalities
+   /// Input: samples/panda_format/sample_3_vp (unit cube inequalities, full symmetry group)
+   /// Expected: a single vertex class
+   void sample3_vp_vertexEnumeration_AD()
+   {
+      SILENCE_CERR();
+
+      char* argv[] = {
+         (char*)"panda",
+         (char*)"../samples/panda_format/sample_3_vp",
+         (char*)"-m", (char*)"ad",
+         (char*)"-t", (char*)"1"
+      };
+      int argc = 6;
+
+      std::ostringstream output;
+      std::streambuf* old_cout = std::cout.rdbuf(output.rdbuf());
+      std::ostringstream errors;
+      std::cerr.rdbuf(errors.rdbuf());
+
+      int result = panda::method::vertexEnumeration(argc, argv);
+
+      std::cout.rdbuf(old_cout);
+
+      ASSERT(result == 0, "Sample 3 (vertex permutations, AD): Vertex enumeration failed");
+
+      std::string output_str = output.str();
+      ASSERT(output_str.find("Vertices / Rays:") != std::string::npos,
+             "Sample 3 (vertex permutations, AD): Output missing 'Vertices / Rays:' header");
+
+      int vertex_count = 0;
+      std::istringstream iss(output_str);
+      std::string line;
+      bool in_vertices = false;
+      while (std::getline(iss, line))
+      {
+         if (line.find("Vertices / Rays:") != std::string::npos)
+         {
+            in_vertices = true;
+            continue;
+         }
+         if (in_vertices && !line.empty() && line.find_first_not_of(" \t") != std::string::npos)
+         {
+            vertex_count++;
+         }
+      }
+      ASSERT(vertex_count == 1, "Sample 3 (vertex permutations, AD): Expected 1 vertex class");
+      ASSERT(errors.str().find("orbit size 8") != std::string::npos,
+             "Sample 3 (vertex permutations, AD): Expected an orbit of 8 vertices");
+      ASSERT(errors.str().find("total number of vertices: 8") != std::string::npos,
+             "Sample 3 (vertex permutations, AD): Expected 8 vertices in total");
+   }
+
+   /// Sample 2 (detected symmetry): Facet enumeration with AD and the detected symmetry group
+   /// Input: samples/panda_format/sample_2 (unit cube vertices, maps without x -> 1 - x)
+   /// Expected: a single facet class, as the detected group contains x -> 1 - x
+   void sample2_detectSymmetry_facetEnumeration_AD()
+   {
+      SILENCE_CERR();
+
+      char* argv[] = {
+         (char*)"panda",
+         (char*)"../samples/panda_format/sample_2",
+         (char*)"-m", (char*)"ad",
+         (char*)"-t", (char*)"1",
+         (char*)"--detect-symmetry"
+      };
+      int argc = 7;
+
+      std::ostringstream output;
+      std::streambuf* old_cout = std::cout.rdbuf(output.rdbuf());
+      std::ostringstream errors;
+      std::cerr.rdbuf(errors.rdbuf());
+
+      int result = panda::method::facetEnumeration(argc, argv);
+
+      std::cout.rdbuf(old_cout);
+
+      ASSERT(result == 0, "Sample 2 (detected symmetry, AD): Facet enumeration failed");
+
+      std::string output_str = output.str();
+      ASSERT(output_str.find("Inequalities:") != std::string::npos,
+             "Sample 2 (detected symmetry, AD): Output missing 'Inequalities:' header");
+
+      int facet_count = 0;
+      std::istringstream iss(output_str);
+      std::string line;
+      bool in_inequalities = false;
+      while (std::getline(iss, line))
+      {
+         if (line.find("Inequalities:") != std::string::npos)
+         {
+            in_inequalities = true;
+            continue;
+         }
+         if (in_inequalities && !line.empty() && line.find_first_not_of(" \t") != std::string::npos)
+         {
+            facet_count++;
+         }
+      }
+      ASSERT(facet_count == 1, "Sample 2 (detected symmetry, AD): Expected 1 facet class");
+      ASSERT(errors.str().find("orbit size 6") != std::string::npos,
+             "Sample 2 (detected symmetry, AD): Expected an orbit of 6 facets");
+      ASSERT(errors.str().find("total number of facets: 6") != std::string::npos,
+             "Sample 2 (detected symmetry, AD): Expected 6 facets in total");
+   }
+
+   /// Sample 2 (expansion): the facet classes of AD are expanded with the maps
+   /// Input: samples/panda_format/sample_2 (unit cube vertices) and its reduced output
+   /// Expected: all 6 facets, each once
+   void sample2_expansion()
+   {
+      SILENCE_CERR();
+
+      char* argv_ad[] = {
+         (char*)"panda",
+         (char*)"../samples/panda_format/sample_2",
+         (char*)"-t", (char*)"1"
+      };
+      std::ostringstream reduced;
+      std::streambuf* old_cout = std::cout.rdbuf(reduced.rdbuf());
+      int result = panda::method::facetEnumeration(4, argv_ad);
+      std::cout.rdbuf(old_cout);
+      ASSERT(result == 0, "Sample 2 (expansion): Facet enumeration failed");
+      std::ofstream("sample_2_reduced.tmp") << reduced.str();
+
+      char* argv[] = {
+         (char*)"panda",
+         (char*)"../samples/panda_format/sample_2",
+         (char*)"--expand=sample_2_reduced.tmp",
+         (char*)"-t", (char*)"2"
+      };
+      std::ostringstream output;
+      old_cout = std::cout.rdbuf(output.rdbuf());
+      result = panda::method::expansion(5, argv);
+      std::cout.rdbuf(old_cout);
+      std::remove("sample_2_reduced.tmp");
+      ASSERT(result == 0, "Sample 2 (expansion): Expansion failed");
+
+      const auto output_str = output.str();
+      ASSERT(output_str.find("Reduced") == std::string::npos,
+             "Sample 2 (expansion): Output is still reduced");
+      for ( const auto facet : {"-x <= 0\n", "-y <= 0\n", "-z <= 0\n", "\nx <= 1\n", "\ny <= 1\n", "\nz <= 1\n"} )
+      {
+         const auto position = output_str.find(facet);
+         ASSERT(position != std::string::npos, "Sample 2 (expansion): Missing facet");
+         ASSERT(output_str.find(facet, position + 1) == std::string::npos, "Sample 2 (expansion): Repeated facet");
+      }
+   }
+
+   /// Sample 3 (vertex permutations, expansion): the vertex class of AD is expanded with the permutations of the inequalities
+   /// Input: samples/panda_format/sample_3_vp (unit cube inequalities) and its reduced output
+   /// Expected: all 8 vertices
+   void sample3_vp_expansion()
+   {
+      SILENCE_CERR();
+
+      char* argv_ad[] = {
+         (char*)"panda",
+         (char*)"../samples/panda_format/sample_3_vp",
+         (char*)"-t", (char*)"1"
+      };
+      std::ostringstream reduced;
+      std::streambuf* old_cout = std::cout.rdbuf(reduced.rdbuf());
+      int result = panda::method::vertexEnumeration(4, argv_ad);
+      std::cout.rdbuf(old_cout);
+      ASSERT(result == 0, "Sample 3 (vertex permutations, expansion): Vertex enumeration failed");
+      std::ofstream("sample_3_vp_reduced.tmp") << reduced.str();
+
+      char* argv[] = {
+         (char*)"panda",
+         (char*)"../samples/panda_format/sample_3_vp",
+         (char*)"--expand=sample_3_vp_reduced.tmp",
+         (char*)"-t", (char*)"2"
+      };
+      std::ostringstream output;
+      old_cout = std::cout.rdbuf(output.rdbuf());
+      result = panda::method::expansion(5, argv);
+      std::cout.rdbuf(old_cout);
+      std::remove("sample_3_vp_reduced.tmp");
+      ASSERT(result == 0, "Sample 3 (vertex permutations, expansion): Expansion failed");
+
+      std::istringstream iss(output.str());
+      std::string line;
+      std::set<std::string> vertices;
+      int vertex_count = 0;
+      while (std::getline(iss, line))
+      {
+         if (line.find_first_of("0123456789") != std::string::npos)
+         {
+            vertices.insert(line);
+            vertex_count++;
+         }
+      }
+      ASSERT(vertex_count == 8, "Sample 3 (vertex permutations, expansion): Expected 8 vertices");
+      ASSERT(vertices.size() == 8, "Sample 3 (vertex permutations, expansion): Expected 8 distinct vertices");
+      ASSERT(vertices.count("  1  1  1  1") == 1, "Sample 3 (vertex permutations, expansion): Missing vertex (1, 1, 1)");
+   }
+
+   #ifdef __linux__
+   /// Returns the IDs of the processes whose parent is the given one, in ascending order.
+   std::vector<pid_t> childrenOf(const pid_t parent)
+   {
+      std::vector<pid_t> children;
+      for ( const auto& entry : std::filesystem::directory_iterator("/proc") )
+      {
+         const auto name = entry.path().filename().string();
+         if ( name.find_first_not_of("0123456789") != std::string::npos )
+         {
+            continue;
+         }
+         // the name of the program is in parentheses and may contain spaces.
+         std::ifstream stat(entry.path() / "stat");
+         std::string line;
+         std::getline(stat, line);
+         const auto end = line.rfind(')');
+         if ( end == std::string::npos )
+         {
+            continue;
+         }
+         std::istringstream fields(line.substr(end + 1));
+         char state;
+         pid_t ppid;
+         if ( fields >> state >> ppid && ppid == parent )
+         {
+            children.push_back(static_cast<pid_t>(std::stoi(name)));
+         }
+      }
+      std::sort(children.begin(), children.end());
+      return children;
+   }
+   #endif
+
+   /// Runs the binary of the build directory with the arguments and returns the sorted lines of
+   /// its output that hold rows, std::nullopt if it failed or didn't end within a minute. The
+   /// local process with the given ID is stopped as soon as it is started (zero: none).
+   /// Local processes are forked, hence they can't run in the process of the test.
+   std::optional<std::vector<std::string>> runBinary(std::vector<std::string> arguments, const int stopped = 0)
+   {
+      #ifdef __linux__
+      const std::string file = "integration_processes.tmp";
+      arguments.insert(arguments.begin(), "./panda");
+      std::vector<char*> argv;
+      for ( auto& argument : arguments )
+      {
+         argv.push_back(&argument[0]);
+      }
+      argv.push_back(nullptr);
+      // only async-signal-safe calls between fork and exec, as the test has threads.
+      const auto pid = fork();
+      if ( pid == 0 )
+      {
+         const auto out = open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+         const auto null = open("/dev/null", O_WRONLY);
+         dup2(out, 1);
+         dup2(null, 2);
+         execv(argv[0], argv.data());
+         _exit(127);
+      }
+      if ( pid < 0 )
+      {
+         return std::nullopt;
+      }
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+      pid_t stopped_pid = 0;
+      int status = 0;
+      auto waited = waitpid(pid, &status, WNOHANG);
+      while ( waited == 0 && std::chrono::steady_clock::now() < deadline )
+      {
+         if ( stopped > 0 && stopped_pid == 0 )
+         {
+            const auto children = childrenOf(pid);
+            if ( children.size() >= static_cast<std::size_t>(stopped) )
+            {
+               stopped_pid = children[static_cast<std::size_t>(stopped - 1)];
+               kill(stopped_pid, SIGSTOP);
+            }
+         }
+         std::this_thread::sleep_for(std::chrono::milliseconds(stopped_pid == 0 ? 1 : 10));
+         waited = waitpid(pid, &status, WNOHANG);
+      }
+      if ( waited == 0 ) // hangs.
+      {
+         for ( const auto child : childrenOf(pid) )
+         {
+            kill(child, SIGKILL);
+         }
+         kill(pid, SIGKILL);
+         waitpid(pid, &status, 0);
+      }
+      if ( stopped_pid != 0 )
+      {
+         // killed by the run already, unless it hung.
+         kill(stopped_pid, SIGKILL);
+      }
+      std::ifstream output(file);
+      std::vector<std::string> rows;
+      std::string line;
+      while ( std::getline(output, line) )
+      {
+         if ( line.find_first_of("0123456789") != std::string::npos && line.find(':') == std::string::npos )
+         {
+            rows.push_back(line);
+         }
+      }
+      std::remove(file.c_str());
+      if ( waited == 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0 )
+      {
+         return std::nullopt;
+      }
+      std::sort(rows.begin(), rows.end());
+      return rows;
+      #else
+      static_cast<void>(arguments);
+      static_cast<void>(stopped);
+      return std::nullopt;
+      #endif
+   }
+
+   /// Runs the binary on the input with a single process and with the options, the outputs
+   /// have to match. The local process with the given ID is stopped (zero: none).
+   void compareWithSingleProcess(const std::string& input, const std::vector<std::string>& options, const std::string& name, const int stopped = 0)
+   {
+      #ifdef __linux__
+      const auto single = runBinary({input, "-t", "1"});
+      ASSERT(single && !single->empty(), name + ": Single process failed");
+      std::vector<std::string> arguments{input, "-t", "1"};
+      arguments.insert(arguments.end(), options.begin(), options.end());
+      const auto output = runBinary(arguments, stopped);
+      ASSERT(output.has_value(), name + ": Enumeration failed or hung");
+      ASSERT(*output == *single, name + ": Output differs from a single process");
+      #else
+      static_cast<void>(input);
+      static_cast<void>(options);
+      static_cast<void>(name);
+      static_cast<void>(stopped);
+      #endif
+   }
+
+   /// Bell 3322 with local processes, each slave is served by a thread of the master.
+   /// Input: samples/panda_format/bell/3322
+   /// Expected: the output of a single process
+   void bell3322_processes_AD()
+   {
+      compareWithSingleProcess("../samples/panda_format/bell/3322", {"--processes=3"}, "Bell 3322 (processes)");
+   }
+
+   /// Bell 3322 in the distributed mode: the classes are owned by the nodes.
+   /// Input: samples/panda_format/bell/3322
+   /// Expected: the output of a single process
+   void bell3322_distributed_AD()
+   {
+      compareWithSingleProcess("../samples/panda_format/bell/3322", {"--processes=3", "--distributed"}, "Bell 3322 (distributed)");
+   }
+
+   /// Bell 3322 with two sub-masters, each with a slave.
+   /// Input: samples/panda_format/bell/3322
+   /// Expected: the output of a single process
+   void bell3322_subMasters_AD()
+   {
+      compareWithSingleProcess("../samples/panda_format/bell/3322", {"--processes=5", "--sub-masters=2"}, "Bell 3322 (sub-masters)");
+   }
+
+   /// Bell 3322 with leases and batches sent ahead, no slave misses its deadline.
+   /// Input: samples/panda_format/bell/3322
+   /// Expected: the output of a single process
+   void bell3322_leasePrefetch_AD()
+   {
+      compareWithSingleProcess("../samples/panda_format/bell/3322", {"--processes=3", "--lease=10", "--prefetch=3"}, "Bell 3322 (lease, prefetch)");
+   }
+
+   /// Bell 3322 with a lease and a slave that stops as soon as it is started: its jobs are
+   /// handed out again.
+   /// Input: samples/panda_format/bell/3322
+   /// Expected: the output of a single process
+   void bell3322_lease_stoppedSlave_AD()
+   {
+      compareWithSingleProcess("../samples/panda_format/bell/3322", {"--processes=3", "--lease=1"}, "Bell 3322 (lease, stopped slave)", 2);
+   }
+
+   /// Sample 3 (vertex enumeration) with local processes.
+   /// Input: samples/panda_format/sample_3 (unit cube inequalities)
+   /// Expected: the output of a single process
+   void sample3_processes_vertexEnumeration_AD()
+   {
+      compareWithSingleProcess("../samples/panda_format/sample_3", {"--processes=2"}, "Sample 3 (processes)");
+   }
+
+   /// Sample 1 with a sub-master whose slave stops, most likely without a job: the run ends
+   /// once the others are done, the stopped slave is killed instead of waited for.
+   /// Input: samples/panda_format/sample_1 (unit cube vertices)
+   /// Expected: the output of a single process
+   void sample1_subMasters_stoppedSlave_AD()
+   {
+      compareWithSingleProcess("../samples/panda_format/sample_1", {"--processes=4", "--sub-masters=1", "--lease=1"}, "Sample 1 (sub-master, stopped slave)", 3);
+   }
+
+   /// Bell 3322 with a sub-master whose slave stops while it has jobs: the sub-master gives up
+   /// on the slave and hands its jobs out again.
+   /// Input: samples/panda_format/bell/3322
+   /// Expected: the output of a single process
+   void bell3322_subMasters_stoppedSlave_AD()
+   {
+      compareWithSingleProcess("../samples/panda_format/bell/3322", {"--processes=4", "--sub-masters=1", "--lease=1"}, "Bell 3322 (sub-master, stopped slave)", 3);
+   }
 }
@@ -0,0 +1,60 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "lease_clock.h"
+
+#include <chrono>
+
+using namespace panda;
+
+int main()
+try
+{
+   using Clock = LeaseClock::Clock;
+   const auto start = Clock::now();
+   const auto at = [&](const int seconds) { return start + std::chrono::seconds(seconds); };
+   {  // without a lease duration, there is no deadline
+      LeaseClock clock(std::nullopt);
+      clock.sent(1, at(0));
+      ASSERT(!clock.deadline(1, at(100)), "No deadline expected.");
+   }
+   {  // a slow but live node keeps its lease while the batches sent ahead wait
+      LeaseClock clock(std::chrono::seconds(10));
+      ASSERT(clock.deadline(1, at(0)) == at(10), "A node without batches has a full lease.");
+      for ( int i = 0; i < 3; ++i )
+      {
+         clock.sent(1, at(0));
+      }
+      ASSERT(clock.deadline(1, at(5)) == at(10), "The clock starts with the first batch.");
+      // each batch takes eight seconds, the last one is done after 24 seconds.
+      clock.received(1, at(8));
+      ASSERT(clock.deadline(1, at(12)) == at(18), "A result restarts the clock.");
+      clock.sent(1, at(12));
+      ASSERT(clock.deadline(1, at(12)) == at(18), "A batch sent ahead doesn't restart the clock.");
+      clock.received(1, at(16));
+      clock.received(1, at(24));
+      ASSERT(*clock.deadline(1, at(25)) > at(25), "The slow node is still in time.");
+      clock.received(1, at(32));
+      clock.sent(1, at(100));
+      ASSERT(clock.deadline(1, at(100)) == at(110), "The clock restarts with a batch after a break.");
+   }
+   {  // a node that stopped misses its deadline, the others aren't affected
+      LeaseClock clock(std::chrono::seconds(10));
+      clock.sent(1, at(0));
+      clock.sent(1, at(0));
+      clock.sent(2, at(0));
+      clock.received(2, at(5));
+      clock.sent(2, at(5));
+      ASSERT(*clock.deadline(1, at(11)) < at(11), "The stopped node missed its deadline.");
+      ASSERT(clock.deadline(2, at(11)) == at(15), "The live node is in time.");
+   }
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
@@ -78,6 +78,62 @@ try
       getter.join();
       setter.join();
    }
+   { // A batch contains the available rows only, and all of its jobs have to be done before the end
+      List<int, tag::facet> list({});
+      list.put(Facets<int>{{0}, {1}, {2}});
+      const auto first = list.get(2);
+      ASSERT((first == Facets<int>{{0}, {1}}), "Batch of the first rows.");
+      const auto second = list.get(5);
+      ASSERT((second == Facets<int>{{2}}), "Batch is not filled up beyond the available rows.");
+      list.put(Facets<int>{{3}}, first.size());
+      ASSERT((list.get(5) == Facets<int>{{3}}), "Results of a batch are available.");
+      list.put(Facets<int>{}, 1);
+      list.put(Facets<int>{}, second.size());
+      ASSERT(list.get(5).empty(), "An empty batch signals the end.");
+      ASSERT(list.get().empty(), "The end is signaled to every caller.");
+   }
+   { // A held list doesn't signal the end until it is released
+      List<int, tag::facet> list({});
+      list.hold();
+      list.put(Facets<int>{{0}});
+      ASSERT(list.get() == Facet<int>{0}, "Data returned is invalid.");
+      ASSERT(!list.idle(), "A job is being processed.");
+      list.put(Facets<int>{});
+      ASSERT(list.idle(), "All jobs are done.");
+      list.waitUntilIdle();
+      std::thread getter([&]()
+      {
+         ASSERT(list.get() == Facet<int>{1}, "Rows added later are returned.");
+         list.put(Facets<int>{});
+         ASSERT(list.get().empty(), "The end is signaled after the release.");
+      });
+      list.put(Facets<int>{{1}}, 0);
+      list.waitUntilIdle();
+      list.release();
+      getter.join();
+   }
+   { // Jobs that are returned are handed out again, before the queued ones
+      List<int, tag::facet> list({});
+      list.put(Facets<int>{{0}, {1}});
+      const auto jobs = list.get(5);
+      ASSERT((jobs == Facets<int>{{0}, {1}}), "Batch of all rows.");
+      list.put(Facets<int>{{2}}, 0);
+      list.requeue(Facets<int>{{1}});
+      ASSERT(!list.idle(), "A job is queued again.");
+      ASSERT((list.get(5) == Facets<int>{{1}, {2}}), "The returned job comes first.");
+      list.put(Facets<int>{{0}}, 3);
+      ASSERT(list.get().empty(), "Late results of a returned job don't keep the list from ending.");
+   }
+   { // tryGet doesn't block while no rows are available
+      List<int, tag::facet> list({});
+      list.put(Facets<int>{{0}, {1}});
+      ASSERT((list.tryGet(1) == Facets<int>{{0}}), "Batch of the first row.");
+      ASSERT((list.tryGet(5) == Facets<int>{{1}}), "Batch of the remaining row.");
+      ASSERT(list.tryGet(5).empty(), "Nothing is available, but the jobs are not done yet.");
+      ASSERT(!list.idle(), "Jobs are being processed.");
+      list.put(Facets<int>{}, 2);
+      ASSERT(list.tryGet(5).empty(), "The end is signaled with an empty batch.");
+   }
 }
 catch ( const TestingGearException& e )
 {
@@ -0,0 +1,93 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "master_hierarchy.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+using namespace panda;
+
+namespace
+{
+   void flat();
+   void twoLevels();
+   void arguments();
+}
+
+int main()
+try
+{
+   flat();
+   twoLevels();
+   arguments();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void flat()
+   {
+      ASSERT((hierarchy::slaves(0, 4, 0) == std::vector<int>{1, 2, 3}), "Without sub-masters, the master serves all other nodes.");
+      for ( int node = 1; node < 4; ++node )
+      {
+         ASSERT(hierarchy::master(node, 4, 0) == 0, "Without sub-masters, all nodes are served by the master.");
+         ASSERT(hierarchy::slaves(node, 4, 0).empty(), "Without sub-masters, slaves serve nobody.");
+         ASSERT(!hierarchy::isSubMaster(node, 0), "Without sub-masters, there are none.");
+      }
+   }
+
+   void twoLevels()
+   {
+      const int nodes = 10;
+      const int sub_masters = 3;
+      ASSERT((hierarchy::slaves(0, nodes, sub_masters) == std::vector<int>{1, 2, 3}), "The master serves the sub-masters only.");
+      ASSERT((hierarchy::slaves(1, nodes, sub_masters) == std::vector<int>{4, 7}), "Every third slave belongs to the first sub-master.");
+      ASSERT((hierarchy::slaves(3, nodes, sub_masters) == std::vector<int>{6, 9}), "Every third slave belongs to the last sub-master.");
+      ASSERT(!hierarchy::isSubMaster(0, sub_masters), "The master isn't a sub-master.");
+      for ( int node = 1; node < nodes; ++node )
+      {
+         const auto master = hierarchy::master(node, nodes, sub_masters);
+         const auto served = hierarchy::slaves(master, nodes, sub_masters);
+         ASSERT(std::count(served.begin(), served.end(), node) == 1, "A node is served by its master.");
+         ASSERT(hierarchy::isSubMaster(node, sub_masters) == (node <= sub_masters), "The first nodes are the sub-masters.");
+         ASSERT(hierarchy::isSubMaster(node, sub_masters) == (master == 0), "The master serves the sub-masters only.");
+      }
+   }
+
+   void arguments()
+   {
+      char name[] = "panda";
+      char two[] = "--sub-masters=2";
+      char typo[] = "--sub-masters";
+      char negative[] = "--sub-masters=-1";
+      {
+         char* argv[] = {name};
+         ASSERT(hierarchy::subMasters(1, argv, 8) == 0, "No sub-masters by default.");
+      }
+      {
+         char* argv[] = {name, two};
+         ASSERT(hierarchy::subMasters(2, argv, 5) == 2, "Two sub-masters with a slave each.");
+         ASSERT_EXCEPTION(hierarchy::subMasters(2, argv, 4), std::invalid_argument, "A sub-master without a slave is rejected.");
+      }
+      {
+         char* argv[] = {name, typo};
+         ASSERT_EXCEPTION(hierarchy::subMasters(2, argv, 8), std::invalid_argument, "The parameter is missing.");
+      }
+      {
+         char* argv[] = {name, negative};
+         ASSERT_EXCEPTION(hierarchy::subMasters(2, argv, 8), std::invalid_argument, "The parameter is negative.");
+      }
+   }
+}
+
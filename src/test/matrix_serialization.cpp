@@ -0,0 +1,147 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "big_integer.h"
+#include "matrix_serialization.h"
+#include "safe_integer.h"
+#include "support.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace panda;
+
+namespace
+{
+   void roundTrip();
+   void compact();
+   void extremeValues();
+   void nativeTypes();
+   void bigIntegers();
+   void supports();
+   void malformed();
+}
+
+int main()
+try
+{
+   roundTrip();
+   compact();
+   extremeValues();
+   nativeTypes();
+   bigIntegers();
+   supports();
+   malformed();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void roundTrip()
+   {
+      std::vector<char> buffer;
+      const Matrix<int> matrix{{1, -2, 0, 3}, {1, -1, 5, -300}, {0, 0, 0, 1}};
+      serialization::pack(matrix, 7, buffer);
+      const auto result = serialization::unpack<int>(buffer);
+      ASSERT(result.first == matrix, "Matrix is restored.");
+      ASSERT(result.second == 7, "Number of jobs is restored.");
+      serialization::pack(Matrix<int>{}, 2, buffer);
+      const auto empty = serialization::unpack<int>(buffer);
+      ASSERT(empty.first.empty() && empty.second == 2, "Empty matrix is restored.");
+   }
+
+   void compact()
+   {
+      std::vector<char> buffer;
+      const Matrix<int> matrix(100, Row<int>{1, 0, -1, 2, 0, 0, 1, -1, 3, 1});
+      serialization::pack(matrix, 1, buffer);
+      ASSERT(buffer.size() < 100 * 10 + 8, "Small and repeated coefficients take at most one byte.");
+      ASSERT(serialization::unpack<int>(buffer).first == matrix, "Matrix is restored.");
+   }
+
+   void extremeValues()
+   {
+      std::vector<char> buffer;
+      const auto max = std::numeric_limits<int>::max();
+      const auto min = std::numeric_limits<int>::min();
+      const Matrix<int> matrix{{max, min, max}, {min, max, min}};
+      serialization::pack(matrix, 1, buffer);
+      ASSERT(buffer.size() <= 2 * 3 * 4 + 5, "Plain words are used for large coefficients.");
+      ASSERT(serialization::unpack<int>(buffer).first == matrix, "Matrix is restored.");
+   }
+
+   void nativeTypes()
+   {
+      std::vector<char> buffer;
+      const auto max = std::numeric_limits<int64_t>::max();
+      const auto min = std::numeric_limits<int64_t>::min();
+      const Matrix<int64_t> large{{max, min, 0}, {min, max, -1}};
+      serialization::pack(large, 1, buffer);
+      ASSERT(serialization::unpack<int64_t>(buffer).first == large, "64-bit coefficients are not narrowed.");
+      const Matrix<int64_t> small{{1, -(int64_t{1} << 40)}, {2, -(int64_t{1} << 40)}};
+      serialization::pack(small, 1, buffer);
+      ASSERT(serialization::unpack<int64_t>(buffer).first == small, "Matrix is restored.");
+      const Matrix<int16_t> narrow{{std::numeric_limits<int16_t>::min(), 3}, {std::numeric_limits<int16_t>::max(), -3}};
+      serialization::pack(narrow, 1, buffer);
+      ASSERT(serialization::unpack<int16_t>(buffer).first == narrow, "16-bit coefficients are restored.");
+      const Matrix<SafeInteger> safe{{SafeInteger(max), SafeInteger(int64_t{-5})}, {SafeInteger(int64_t{7}), SafeInteger(min + 1)}};
+      serialization::pack(safe, 1, buffer);
+      ASSERT(serialization::unpack<SafeInteger>(buffer).first == safe, "Safe integers are restored.");
+   }
+
+   void bigIntegers()
+   {
+      std::vector<char> buffer;
+      const BigInteger huge(false, {0x0123456789ABCDEFull, 0xFFFFFFFFFFFFFFFFull, 42});
+      const BigInteger limit(true, {uint64_t{1} << 62});
+      const Matrix<BigInteger> matrix{
+         {BigInteger(int64_t{0}), BigInteger(int64_t{-7}), huge, limit},
+         {BigInteger(std::numeric_limits<int64_t>::min()), BigInteger(std::numeric_limits<uint64_t>::max()), huge * huge, BigInteger(true, huge.limbs())}
+      };
+      serialization::pack(matrix, 3, buffer);
+      const auto result = serialization::unpack<BigInteger>(buffer);
+      ASSERT(result.first == matrix, "Big integers are restored without loss.");
+      ASSERT(result.second == 3, "Number of jobs is restored.");
+      serialization::pack(Matrix<BigInteger>(50, Row<BigInteger>(4, BigInteger(int64_t{-1}))), 1, buffer);
+      ASSERT(buffer.size() < 50 * 4 + 8, "Small big integers take one byte.");
+      ASSERT_EXCEPTION(serialization::unpack<int>(buffer), std::invalid_argument, "Encoding has to match the type.");
+   }
+
+   void supports()
+   {
+      std::vector<char> buffer;
+      const Matrix<int> matrix{{1, 2}, {3, 4}};
+      std::vector<Support> supports(2, Support(70));
+      supports[0].set(0);
+      supports[0].set(69);
+      supports[1].set(3);
+      serialization::pack(matrix, supports, 5, buffer);
+      std::vector<Support> received;
+      const auto result = serialization::unpack<int>(buffer, received);
+      ASSERT(result.first == matrix && result.second == 5, "Matrix is restored.");
+      ASSERT(received == supports, "Supports are restored.");
+      serialization::pack(matrix, 5, buffer);
+      serialization::unpack<int>(buffer, received);
+      ASSERT(received.empty(), "No supports are restored if none were sent.");
+   }
+
+   void malformed()
+   {
+      std::vector<char> buffer;
+      serialization::pack(Matrix<int>{{1, 2}, {3, 400000}}, 1, buffer);
+      buffer.pop_back();
+      ASSERT_EXCEPTION(serialization::unpack<int>(buffer), std::invalid_argument, "Truncated buffer is detected.");
+      ASSERT_EXCEPTION(serialization::unpack<int>(std::vector<char>{}), std::invalid_argument, "Empty buffer is detected.");
+   }
+}
+
@@ -0,0 +1,62 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "message_passing_interface_progress_engine.h"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "local_processes.h"
+#include "shared_memory_transport.h"
+
+using namespace panda;
+
+int main()
+try
+{
+   using Clock = std::chrono::steady_clock;
+   // both processes live in this one, each with its own engine.
+   const auto bytes = local::SharedMemoryTransport::bytes(2);
+   std::vector<char> storage(bytes + 64);
+   void* memory = storage.data();
+   auto space = storage.size();
+   std::align(64, bytes, memory, space);
+   local::SharedMemoryTransport::initialize(memory, 2);
+   {
+      mpi::ProgressEngine first(std::unique_ptr<mpi::Transport>(new local::SharedMemoryTransport(local::ProcessGroup{0, 2, memory})));
+      mpi::ProgressEngine second(std::unique_ptr<mpi::Transport>(new local::SharedMemoryTransport(local::ProcessGroup{1, 2, memory})));
+      {  // a message that arrives in time is received
+         second.send(mpi::ProgressEngine::Buffer{'a'}, 0, 1).wait();
+         const auto buffer = first.receive(1, 1, Clock::now() + std::chrono::seconds(10));
+         ASSERT(buffer && *buffer == mpi::ProgressEngine::Buffer{'a'}, "The message arrived before the deadline.");
+      }
+      {  // a reply that arrives after the deadline goes to the next caller
+         const auto expired = first.receive(1, 1, Clock::now() + std::chrono::milliseconds(20));
+         ASSERT(!expired, "Nothing was sent before the deadline.");
+         second.send(mpi::ProgressEngine::Buffer{'b'}, 0, 1).wait();
+         auto future = first.receive(1, 1);
+         ASSERT(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready, "The late reply isn't lost.");
+         ASSERT(future.get() == mpi::ProgressEngine::Buffer{'b'}, "The late reply is received.");
+      }
+      {  // a withdrawn receive doesn't take a message of the same source with another tag
+         const auto expired = first.receive(1, 2, Clock::now() + std::chrono::milliseconds(20));
+         ASSERT(!expired, "Nothing was sent with this tag.");
+         second.send(mpi::ProgressEngine::Buffer{'c'}, 0, 2).wait();
+         const auto buffer = first.receive(1, 2, Clock::now() + std::chrono::seconds(10));
+         ASSERT(buffer && *buffer == mpi::ProgressEngine::Buffer{'c'}, "The next caller gets the message.");
+      }
+   }
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
@@ -0,0 +1,94 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "padded_vertices.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "algorithm_inequality_operations.h"
+#include "big_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   void empty();
+   template <typename Integer>
+   void distances(std::size_t);
+}
+
+int main()
+try
+{
+   empty();
+   // fixed widths (exact and padded) and the variable width for large dimensions.
+   for ( const std::size_t dimension : {1u, 8u, 9u, 37u, 49u, 81u, 128u, 129u, 200u} )
+   {
+      distances<int>(dimension);
+      #ifndef NO_FLEXIBILITY
+      distances<int64_t>(dimension);
+      distances<BigInteger>(dimension);
+      #endif
+   }
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void empty()
+   {
+      const PaddedVertices<int> padded(Vertices<int>{});
+      ASSERT(padded.empty() && padded.size() == 0, "No vertices stored.");
+      std::vector<int> result{1, 2};
+      padded.distances(Inequality<int>{}, result);
+      ASSERT(result.empty(), "No vertices, no distances.");
+   }
+
+   template <typename Integer>
+   void distances(const std::size_t dimension)
+   {
+      std::mt19937 generator{static_cast<unsigned int>(dimension)};
+      std::uniform_int_distribution<int> distribution(-5, 5);
+      const auto random_row = [&]()
+      {
+         Row<Integer> row;
+         for ( std::size_t i = 0; i < dimension; ++i )
+         {
+            row.push_back(Integer(distribution(generator)));
+         }
+         return row;
+      };
+      Vertices<Integer> vertices;
+      for ( int i = 0; i < 30; ++i )
+      {
+         vertices.push_back(random_row());
+      }
+      const PaddedVertices<Integer> padded(vertices);
+      ASSERT(padded.size() == vertices.size(), "Number of vertices.");
+      ASSERT(padded.width() >= dimension, "The width has to hold the dimension.");
+      std::vector<Integer> result;
+      for ( int i = 0; i < 20; ++i )
+      {
+         const auto inequality = random_row();
+         padded.distances(inequality, result);
+         ASSERT(result.size() == vertices.size(), "One distance per vertex.");
+         for ( std::size_t j = 0; j < vertices.size(); ++j )
+         {
+            ASSERT(result[j] == algorithm::distance(inequality, vertices[j]), "Distance differs from the row-wise computation.");
+         }
+      }
+   }
+}
+
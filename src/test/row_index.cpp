@@ -0,0 +1,103 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "row_index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "algorithm_map_operations.h"
+#include "big_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   template <typename Integer>
+   void lookup();
+   void duplicates();
+   void images();
+}
+
+int main()
+try
+{
+   lookup<int>();
+   #ifndef NO_FLEXIBILITY
+   lookup<int64_t>();
+   lookup<BigInteger>();
+   #endif
+   duplicates();
+   images();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   template <typename Integer>
+   void lookup()
+   {
+      std::mt19937 generator(7);
+      std::uniform_int_distribution<int> entry(-3, 3);
+      Matrix<Integer> matrix;
+      for ( int i = 0; i < 1000; ++i )
+      {
+         Row<Integer> row(6);
+         for ( auto& value : row )
+         {
+            value = Integer(entry(generator));
+         }
+         matrix.push_back(row);
+      }
+      const RowIndex<Integer> index(matrix);
+      ASSERT(index.memoryUsage() > 0, "");
+      for ( std::size_t i = 0; i < matrix.size(); ++i )
+      {
+         const auto position = index.find(matrix[i]);
+         ASSERT(position != RowIndex<Integer>::npos, "");
+         ASSERT(matrix[position] == matrix[i], "");
+         ASSERT(position <= i, ""); // the first occurrence is found
+      }
+      ASSERT(index.find(Row<Integer>(6, Integer(4))) == RowIndex<Integer>::npos, "");
+      ASSERT(index.find(Row<Integer>(5, Integer(0))) == RowIndex<Integer>::npos, "");
+   }
+
+   void duplicates()
+   {
+      const Matrix<int> unique{{0, 1}, {1, 0}, {1, 1}};
+      ASSERT(!RowIndex<int>(unique).hasDuplicates(), "");
+      const Matrix<int> twice{{0, 1}, {1, 0}, {0, 1}};
+      const RowIndex<int> index(twice);
+      ASSERT(index.hasDuplicates(), "");
+      ASSERT(index.find(Row<int>{0, 1}) == 0, "");
+      const Matrix<int> empty;
+      ASSERT(RowIndex<int>(empty).find(Row<int>{0}) == RowIndex<int>::npos, "");
+   }
+
+   void images()
+   {
+      // cube vertices (homogenized), maps: swap x and y, x -> 1 - x, x -> 2x (no symmetry).
+      const Matrix<int> vertices{{0, 0, 1}, {0, 1, 1}, {1, 0, 1}, {1, 1, 1}};
+      Map xy{{std::make_pair(1u, 1)}, {std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}};
+      Map flip{{std::make_pair(0u, -1), std::make_pair(2u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}};
+      Map scale{{std::make_pair(0u, 2)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}};
+      const auto result = algorithm::images({xy, flip, scale}, vertices, tag::vertex{}, 2);
+      ASSERT(algorithm::images({xy, flip, scale}, vertices, tag::vertex{}, 1) == result, "The number of threads doesn't change the images.");
+      ASSERT(result.size() == 3, "");
+      ASSERT((result[0] == std::vector<std::size_t>{0, 2, 1, 3}), "");
+      ASSERT((result[1] == std::vector<std::size_t>{2, 3, 0, 1}), "");
+      ASSERT(result[2][0] == 0 && result[2][1] == 1, "");
+      ASSERT(result[2][2] == RowIndex<int>::npos && result[2][3] == RowIndex<int>::npos, "");
+   }
+}
+
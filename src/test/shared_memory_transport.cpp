@@ -0,0 +1,96 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "shared_memory_transport.h"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "local_processes.h"
+
+using namespace panda;
+
+int main()
+try
+{
+   // both processes live in this one, polled alternately.
+   const auto bytes = local::SharedMemoryTransport::bytes(2);
+   std::vector<char> storage(bytes + 64);
+   void* memory = storage.data();
+   auto space = storage.size();
+   std::align(64, bytes, memory, space);
+   local::SharedMemoryTransport::initialize(memory, 2);
+   local::SharedMemoryTransport first(local::ProcessGroup{0, 2, memory});
+   local::SharedMemoryTransport second(local::ProcessGroup{1, 2, memory});
+   BufferPool pool(4);
+   {  // messages arrive in order with their tags, an empty message included
+      const BufferPool::Buffer a{'a', 'b', 'c'};
+      const BufferPool::Buffer b{};
+      ASSERT(first.post(a, 1, 7, 0) && first.post(b, 1, 3, 1), "Posting to the shared memory doesn't fail.");
+      std::vector<std::size_t> completed;
+      std::vector<std::size_t> failed;
+      std::vector<mpi::Transport::Message> received;
+      ASSERT(first.poll(completed, failed, received, pool), "The messages are written.");
+      ASSERT((completed == std::vector<std::size_t>{0, 1}), "Small messages are sent at once.");
+      ASSERT(received.empty(), "Nothing has been sent to the first process.");
+      completed.clear();
+      ASSERT(second.poll(completed, failed, received, pool), "The messages are read.");
+      ASSERT(received.size() == 2, "Both messages are received.");
+      ASSERT(received[0].source == 0 && received[0].tag == 7 && received[0].buffer == a, "First message.");
+      ASSERT(received[1].source == 0 && received[1].tag == 3 && received[1].buffer.empty(), "Second message.");
+      ASSERT(!second.poll(completed, failed, received, pool), "Nothing is left.");
+      ASSERT(failed.empty(), "No message failed.");
+   }
+   {  // a message larger than a ring is streamed
+      BufferPool::Buffer large(std::size_t{1} << 20);
+      for ( std::size_t i = 0; i < large.size(); ++i )
+      {
+         large[i] = static_cast<char>(i * 31 % 251);
+      }
+      const BufferPool::Buffer answer{'x'};
+      second.post(large, 0, 1, 5);
+      second.post(answer, 0, 2, 6);
+      first.post(answer, 1, 2, 7);
+      std::vector<std::size_t> completed;
+      std::vector<std::size_t> failed;
+      std::vector<mpi::Transport::Message> received;
+      std::vector<std::size_t> completed_second;
+      std::vector<mpi::Transport::Message> received_second;
+      int rounds = 0;
+      while ( received.size() < 2 || received_second.empty() )
+      {
+         second.poll(completed_second, failed, received_second, pool);
+         first.poll(completed, failed, received, pool);
+         ++rounds;
+         ASSERT(rounds < 1000, "The transmission makes progress.");
+      }
+      ASSERT(rounds > 1, "The large message needs several rounds.");
+      ASSERT((completed_second == std::vector<std::size_t>{5, 6}), "Both messages of the second process are sent.");
+      ASSERT((completed == std::vector<std::size_t>{7}), "The message of the first process is sent.");
+      ASSERT(received[0].source == 1 && received[0].tag == 1 && received[0].buffer == large, "The large message is intact.");
+      ASSERT(received[1].source == 1 && received[1].tag == 2 && received[1].buffer == answer, "The message after the large one.");
+      ASSERT(received_second.size() == 1 && received_second[0].buffer == answer, "The message in the other direction.");
+   }
+   {  // the number of processes is parsed from the command line
+      char name[] = "panda";
+      char option[] = "--processes=3";
+      char* arguments[] = {name, option};
+      ASSERT(local::numberOfProcesses(2, arguments) == 3, "Option is parsed.");
+      ASSERT(local::numberOfProcesses(1, arguments) == 1, "Default is a single process.");
+      char zero[] = "--processes=0";
+      char* invalid[] = {name, zero};
+      ASSERT_EXCEPTION(local::numberOfProcesses(2, invalid), std::invalid_argument, "At least one process is needed.");
+      ASSERT(local::group() == nullptr, "No processes are launched without a call to launch.");
+   }
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
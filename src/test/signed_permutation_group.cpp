@@ -0,0 +1,171 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "signed_permutation_group.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "algorithm_classes.h"
+#include "algorithm_row_operations.h"
+#include "big_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   void not_applicable();
+   void fixed_coordinates();
+   void minimal_generating_set();
+   template <typename Integer>
+   void random_groups(std::size_t);
+   /// Creates a random signed permutation on the coordinates.
+   Map randomMap(std::size_t, std::mt19937&);
+}
+
+int main()
+try
+{
+   not_applicable();
+   fixed_coordinates();
+   minimal_generating_set();
+   for ( std::size_t dimension = 1; dimension <= 5; ++dimension )
+   {
+      random_groups<int>(dimension);
+      #ifndef NO_FLEXIBILITY
+      random_groups<BigInteger>(dimension);
+      #endif
+   }
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void not_applicable()
+   {
+      Map xy{{std::make_pair(1u, 1)}, {std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}};
+      Map affine{{std::make_pair(0u, -1), std::make_pair(2u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}};
+      Map scaled{{std::make_pair(0u, 2)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}};
+      Map collapsing{{std::make_pair(0u, 1)}, {std::make_pair(0u, -1)}, {std::make_pair(2u, 1)}};
+      ASSERT(SignedPermutationGroup::create({}) == std::nullopt, "");
+      ASSERT(SignedPermutationGroup::create({xy}) != std::nullopt, "");
+      ASSERT(SignedPermutationGroup::create({xy, affine}) == std::nullopt, "");
+      ASSERT(SignedPermutationGroup::create({scaled}) == std::nullopt, "");
+      ASSERT(SignedPermutationGroup::create({collapsing}) == std::nullopt, "");
+   }
+
+   void fixed_coordinates()
+   {
+      // the second coordinate is eliminated (empty images in all maps).
+      Map swap{{std::make_pair(2u, -1)}, {}, {std::make_pair(0u, 1)}};
+      Map other{{std::make_pair(0u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}};
+      ASSERT(SignedPermutationGroup::create({swap, other}) == std::nullopt, "");
+      const auto group = SignedPermutationGroup::create({swap});
+      ASSERT(group != std::nullopt, "");
+      ASSERT(group->dimension() == 3, "");
+      ASSERT((group->canonicalImage(Row<int>{3, 1, -5}) == std::nullopt), "");
+      const auto image = group->canonicalImage(Row<int>{3, 0, -5});
+      ASSERT(image != std::nullopt, "");
+      ASSERT((*image == *algorithm::getClass(Row<int>{3, 0, -5}, {swap}, tag::facet{}).crbegin()), "");
+      ASSERT((*image == Row<int>{5, 0, 3}), "");
+      std::vector<Row<int>> orbit;
+      ASSERT(!group->orbit<int>(Row<int>{3, 1, -5}, [&](const Row<int>& element) { orbit.push_back(element); }), "");
+      ASSERT(orbit.empty(), "");
+      ASSERT(group->orbit<int>(Row<int>{3, 0, -5}, [&](const Row<int>& element) { orbit.push_back(element); }), "");
+      ASSERT(orbit.size() == 4, "");
+   }
+
+   void minimal_generating_set()
+   {
+      Map xy{{std::make_pair(1u, 1)}, {std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}};
+      Map yz{{std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(1u, 1)}};
+      Map xz{{std::make_pair(2u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(0u, 1)}};
+      Map identity{{std::make_pair(0u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}};
+      Map affine{{std::make_pair(0u, -1), std::make_pair(2u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}};
+      ASSERT((SignedPermutationGroup::minimalGeneratingSet({identity, xy, xy, yz, xz}) == Maps{xy, yz}), "");
+      ASSERT((SignedPermutationGroup::minimalGeneratingSet({identity}) == Maps{identity}), "");
+      ASSERT((SignedPermutationGroup::minimalGeneratingSet({xy, affine}) == Maps{xy, affine}), "");
+      // the kept maps fix the same coordinates.
+      Map swap{{std::make_pair(2u, -1)}, {}, {std::make_pair(0u, 1)}};
+      Map twice{{std::make_pair(0u, -1)}, {}, {std::make_pair(2u, -1)}};
+      ASSERT((SignedPermutationGroup::minimalGeneratingSet({swap, twice}) == Maps{swap}), "");
+   }
+
+   template <typename Integer>
+   void random_groups(const std::size_t dimension)
+   {
+      std::mt19937 generator(static_cast<unsigned>(dimension));
+      std::uniform_int_distribution<int> number_of_maps(1, 3);
+      std::uniform_int_distribution<int> entry(-2, 2);
+      for ( int trial = 0; trial < 20; ++trial )
+      {
+         Maps maps(static_cast<std::size_t>(number_of_maps(generator)));
+         for ( auto& map : maps )
+         {
+            map = randomMap(dimension, generator);
+         }
+         const auto group = SignedPermutationGroup::create(maps);
+         ASSERT(group != std::nullopt, "");
+         const auto minimal_maps = SignedPermutationGroup::minimalGeneratingSet(maps);
+         ASSERT(!minimal_maps.empty() && minimal_maps.size() <= maps.size(), "");
+         const auto minimal_group = SignedPermutationGroup::create(minimal_maps);
+         ASSERT(minimal_group != std::nullopt, "");
+         for ( int k = 0; k < 10; ++k )
+         {
+            Row<Integer> row(dimension);
+            for ( auto& value : row )
+            {
+               value = Integer(entry(generator));
+            }
+            auto normalized = row;
+            algorithm::divideByGcd(normalized);
+            if ( normalized != row )
+            {
+               continue;
+            }
+            // the stabilizer chain has to find the same representative as the orbit enumeration.
+            const auto image = group->canonicalImage(row);
+            ASSERT(image != std::nullopt, "");
+            ASSERT((image == minimal_group->canonicalImage(row)), "");
+            ASSERT((*image == *algorithm::getClass(row, maps, tag::facet{}).crbegin()), "");
+            ASSERT((*image == *algorithm::getClass(row, maps, tag::vertex{}).crbegin()), "");
+            ASSERT((*image == algorithm::classRepresentative(row, maps, tag::facet{})), "");
+            // the orbit is enumerated without repetitions.
+            std::vector<Row<Integer>> orbit;
+            ASSERT(group->template orbit<Integer>(row, [&](const Row<Integer>& element) { orbit.push_back(element); }), "");
+            const auto row_class = algorithm::getClass(row, maps, tag::facet{});
+            std::sort(orbit.begin(), orbit.end());
+            ASSERT(std::adjacent_find(orbit.cbegin(), orbit.cend()) == orbit.cend(), "");
+            ASSERT(std::equal(orbit.cbegin(), orbit.cend(), row_class.cbegin(), row_class.cend()), "");
+         }
+      }
+   }
+
+   Map randomMap(const std::size_t dimension, std::mt19937& generator)
+   {
+      std::vector<std::size_t> targets(dimension);
+      std::iota(targets.begin(), targets.end(), std::size_t{0});
+      std::shuffle(targets.begin(), targets.end(), generator);
+      std::bernoulli_distribution negative(0.3);
+      Map map(dimension);
+      for ( std::size_t i = 0; i < dimension; ++i )
+      {
+         map[i].push_back(std::make_pair(targets[i], negative(generator) ? -1 : 1));
+      }
+      return map;
+   }
+}
+
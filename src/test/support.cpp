@@ -0,0 +1,82 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "support.h"
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+using namespace panda;
+
+namespace
+{
+   void construction();
+   void setAndTest();
+   void equalityAndHash();
+}
+
+int main()
+try
+{
+   construction();
+   setAndTest();
+   equalityAndHash();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void construction()
+   {
+      ASSERT(Support().size() == 0, "Default constructed support has no vertices.");
+      ASSERT(Support(64).words().size() == 1, "64 vertices fit into one word.");
+      ASSERT(Support(65).words().size() == 2, "65 vertices need two words.");
+      ASSERT(Support(100).count() == 0, "Just constructed support is empty.");
+   }
+
+   void setAndTest()
+   {
+      Support support(130);
+      const std::vector<std::size_t> indices{0, 5, 63, 64, 127, 129};
+      for ( const auto index : indices )
+      {
+         support.set(index);
+      }
+      ASSERT(support.count() == indices.size(), "Count has to match the number of set bits.");
+      ASSERT(support.indices() == indices, "Indices have to be the set bits in ascending order.");
+      ASSERT(support.test(63) && support.test(64), "Set bits at the word boundary.");
+      ASSERT(!support.test(1) && !support.test(128), "Unset bits.");
+   }
+
+   void equalityAndHash()
+   {
+      Support a(70);
+      Support b(70);
+      a.set(3);
+      ASSERT(a != b, "Different sets.");
+      b.set(3);
+      ASSERT(a == b, "Equal sets.");
+      ASSERT(a.hash() == b.hash(), "Equal sets have equal hashes.");
+      ASSERT(Support(70) != Support(71), "Sets on different numbers of vertices.");
+      std::unordered_set<Support, Support::Hash> set;
+      for ( std::size_t i = 0; i < 70; ++i )
+      {
+         Support single(70);
+         single.set(i);
+         set.insert(single);
+         set.insert(single);
+      }
+      ASSERT(set.size() == 70, "Every single vertex set is stored once.");
+      ASSERT(set.count(a) == 1, "Lookup by an equal set.");
+   }
+}
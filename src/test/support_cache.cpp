@@ -0,0 +1,105 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "support_cache.h"
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+
+#include "joining_thread.h"
+#include "support.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Returns the support {i, i + 1} on 100 vertices.
+   Support pair(std::size_t);
+   void lookup();
+   void bounded();
+   void concurrent();
+}
+
+int main()
+try
+{
+   lookup();
+   bounded();
+   concurrent();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   Support pair(const std::size_t i)
+   {
+      Support support(100);
+      support.set(i);
+      support.set(i + 1);
+      return support;
+   }
+
+   void lookup()
+   {
+      SupportCache cache(100);
+      ASSERT(!cache.find(pair(3)).has_value(), "Empty cache.");
+      cache.insert(pair(3), pair(0));
+      const auto cached = cache.find(pair(3));
+      ASSERT(cached && *cached == pair(0), "Cached canonical form.");
+      ASSERT(!cache.find(pair(0)).has_value(), "Only raw supports are keys.");
+      ASSERT(cache.lookups() == 3 && cache.hits() == 1, "Statistics.");
+   }
+
+   void bounded()
+   {
+      SupportCache cache(16);
+      for ( std::size_t i = 0; i < 98; ++i )
+      {
+         cache.insert(pair(i), pair(0));
+      }
+      std::size_t found{0};
+      for ( std::size_t i = 0; i < 98; ++i )
+      {
+         found += cache.find(pair(i)) ? 1 : 0;
+      }
+      ASSERT(found > 0 && found <= 16, "Cache holds at most its capacity.");
+      ASSERT(cache.find(pair(97)).has_value(), "The last entry is never evicted.");
+   }
+
+   void concurrent()
+   {
+      SupportCache cache(64);
+      std::atomic<std::size_t> wrong{0};
+      {
+         std::list<JoiningThread> threads;
+         for ( int t = 0; t < 4; ++t )
+         {
+            threads.emplace_front([&]()
+            {
+               for ( std::size_t i = 0; i < 2000; ++i )
+               {
+                  const auto raw = pair(i % 98);
+                  const auto cached = cache.find(raw);
+                  if ( cached && *cached != pair(i % 98 % 7) )
+                  {
+                     ++wrong;
+                  }
+                  cache.insert(raw, pair(i % 98 % 7));
+               }
+            });
+         }
+      }
+      ASSERT(wrong == 0, "Cached forms belong to their raw supports.");
+      ASSERT(cache.lookups() == 8000, "Every lookup is counted.");
+   }
+}
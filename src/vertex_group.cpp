@@ -10,6 +10,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <functional>
 #include <optional>
 #include <vector>
 
@@ -23,24 +24,26 @@
 #include "gmpxx.h"
 #include "maps.h"
 #include "matrix.h"
+#include "support.h"
+#include "tags.h"
 
 using namespace panda;
 
-template <typename Integer>
-std::optional<VertexGroup> VertexGroup::create(const Maps& original_maps, const Matrix<Integer>& vertices)
+template <typename Integer, typename TagType>
+std::optional<VertexGroup> VertexGroup::create(const Maps& original_maps, const Matrix<Integer>& rows, TagType tag, const int thread_count)
 {
-   if (original_maps.empty() || vertices.empty())
+   if (original_maps.empty() || rows.empty())
    {
       return std::nullopt;
    }
 
-   auto vertex_perms = algorithm::computeVertexPermutations(original_maps, vertices);
-   if (vertex_perms.empty())
+   auto row_perms = algorithm::computeVertexPermutations(original_maps, rows, tag, thread_count);
+   if (row_perms.empty())
    {
       return std::nullopt;
    }
 
-   return VertexGroup(vertex_perms, vertices.size());
+   return VertexGroup(row_perms, rows.size());
 }
 
 // VertexGroup implementation (must be in this translation unit because
@@ -96,32 +99,92 @@ panda::VertexGroup::VertexGroup(const std::vector<std::vector<std::size_t>>& gen
    impl_ = std::make_shared<const Impl>(std::move(group), n_vertices);
 }
 
-std::vector<std::size_t> panda::VertexGroup::canonicalSupport(const std::vector<std::size_t>& support) const
+namespace
 {
-   // Convert sorted vector of indices to Face (bitset)
-   permutalib::Face face(impl_->n_vertices);
-   for (const auto& idx : support)
+   static_assert(sizeof(permutalib::Face::block_type) == sizeof(Support::Word),
+                 "Face blocks and Support words must have the same width");
+
+   // Copy the words of a support into a Face of the same size (no per-bit work).
+   void toFace(const Support& support, permutalib::Face& face)
    {
-      assert(idx < impl_->n_vertices);
-      face.set(idx);
+      boost::from_block_range(support.words().begin(), support.words().end(), face);
    }
 
-   // Compute canonical form
-   auto canonical = impl_->group.CanonicalImage(face);
-
-   // Convert Face back to sorted vector of indices
-   std::vector<std::size_t> result;
-   result.reserve(canonical.count());
-   auto pos = canonical.find_first();
-   while (pos != boost::dynamic_bitset<>::npos)
+   // Copy the blocks of a Face into a support of the same size.
+   void fromFace(const permutalib::Face& face, Support& support)
    {
-      result.push_back(pos);
-      pos = canonical.find_next(pos);
+      boost::to_block_range(face, support.words().begin());
    }
+}
+
+Support panda::VertexGroup::canonicalSupport(const Support& support) const
+{
+   assert(support.size() == impl_->n_vertices);
+   permutalib::Face face(impl_->n_vertices);
+   toFace(support, face);
+   auto result = support;
+   fromFace(impl_->group.CanonicalImage(face), result);
    return result;
 }
 
+void panda::VertexGroup::canonicalize(std::vector<Support>& supports) const
+{
+   permutalib::Face face(impl_->n_vertices);
+   for (auto& support : supports)
+   {
+      assert(support.size() == impl_->n_vertices);
+      toFace(support, face);
+      fromFace(impl_->group.CanonicalImage(face), support);
+   }
+}
+
 std::size_t panda::VertexGroup::size() const
 {
    return impl_->n_vertices;
 }
+
+std::vector<std::vector<std::size_t>> panda::VertexGroup::generators() const
+{
+   std::vector<std::vector<std::size_t>> result;
+   for (const auto& generator : impl_->group.GeneratorsOfGroup())
+   {
+      std::vector<std::size_t> permutation(impl_->n_vertices);
+      for (std::size_t i = 0; i < impl_->n_vertices; ++i)
+      {
+         permutation[i] = generator.at(static_cast<uint32_t>(i));
+      }
+      result.push_back(std::move(permutation));
+   }
+   return result;
+}
+
+mpz_class panda::VertexGroup::order() const
+{
+   return impl_->group.size();
+}
+
+mpz_class panda::VertexGroup::orbitSize(const Support& support) const
+{
+   assert(support.size() == impl_->n_vertices);
+   permutalib::Face face(impl_->n_vertices);
+   toFace(support, face);
+   return impl_->group.size() / impl_->group.Stabilizer_OnSets(face).size();
+}
+
+void panda::VertexGroup::orbit(const Support& support, const std::function<void(const std::vector<std::size_t>&)>& function) const
+{
+   assert(support.size() == impl_->n_vertices);
+   permutalib::Face face(impl_->n_vertices);
+   toFace(support, face);
+   const auto stabilizer = impl_->group.Stabilizer_OnSets(face);
+   // all elements of a right coset map the support onto the same image.
+   std::vector<std::size_t> permutation(impl_->n_vertices);
+   for (const auto& coset : impl_->group.right_cosets(stabilizer))
+   {
+      for (std::size_t i = 0; i < impl_->n_vertices; ++i)
+      {
+         permutation[i] = coset.at(static_cast<uint32_t>(i));
+      }
+      function(permutation);
+   }
+}
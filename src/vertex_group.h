@@ -7,25 +7,33 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <vector>
 
+#include <gmpxx.h>
+
 #include "maps.h"
 #include "matrix.h"
+#include "support.h"
+#include "tags.h"
 
 namespace panda
 {
    /// Wrapper around a permutalib group acting on vertex indices.
    /// All permutalib types are hidden behind the pimpl firewall.
-   /// Vertex supports are represented as sorted vectors of vertex indices.
+   /// Vertex supports are represented as bitsets over the vertex indices.
    class VertexGroup
    {
    public:
-      /// Build a VertexGroup from original (pre-normalization) maps and vertices.
-      /// Returns std::nullopt if maps are empty or not pure permutations.
-      template <typename Integer>
-      static std::optional<VertexGroup> create(const Maps& original_maps, const Matrix<Integer>& vertices);
+      /// Build a VertexGroup from original (pre-normalization) maps and the input rows.
+      /// The group acts on the row indices: vertices when facets are enumerated (tag::facet),
+      /// inequalities when vertices are enumerated (tag::vertex).
+      /// Returns std::nullopt if maps are empty or do not permute the input rows.
+      /// The maps are applied on up to the given number of threads.
+      template <typename Integer, typename TagType>
+      static std::optional<VertexGroup> create(const Maps& original_maps, const Matrix<Integer>& rows, TagType, int thread_count);
 
       /// Construct from generator permutations on vertex indices.
       VertexGroup(const std::vector<std::vector<std::size_t>>& generators,
@@ -38,13 +46,32 @@ namespace panda
       VertexGroup& operator=(VertexGroup&&) = default;
 
       /// Compute the canonical form of a vertex support under the group.
-      /// Input/output: sorted vector of vertex indices that lie on the face.
       /// Two supports are equivalent iff they have the same canonical form.
-      std::vector<std::size_t> canonicalSupport(const std::vector<std::size_t>& support) const;
+      Support canonicalSupport(const Support& support) const;
+
+      /// Replace each support by its canonical form (see canonicalSupport).
+      /// Shares the conversion buffers between the supports.
+      void canonicalize(std::vector<Support>& supports) const;
 
       /// Number of vertices the group acts on.
       std::size_t size() const;
 
+      /// Generators of the group as permutations on vertex indices.
+      std::vector<std::vector<std::size_t>> generators() const;
+
+      /// Order of the group.
+      mpz_class order() const;
+
+      /// Size of the orbit of a vertex support, i.e. the group order divided by the order
+      /// of the stabilizer of the support.
+      mpz_class orbitSize(const Support& support) const;
+
+      /// Calls the function once for each support in the orbit of a vertex support, with a
+      /// group element mapping the support onto it (the image of each vertex index). The
+      /// elements represent the right cosets of the stabilizer of the support, hence each
+      /// image is reached once and none has to be remembered.
+      void orbit(const Support& support, const std::function<void(const std::vector<std::size_t>&)>& function) const;
+
    private:
       struct Impl;
       std::shared_ptr<const Impl> impl_;